@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+
+// Times the forward and reverse pass of matrix operations on
+// var_value<Eigen::MatrixXd>, whose value and adjoint buffers live on the
+// arena. Compare a default build against one with
+//   CXXFLAGS += -DSTAN_ARENA_ALIGNMENT=8
+// to see the effect of aligning arena arrays.
+//
+// Build and run with
+//   make benchmarks/arena_alignment && ./benchmarks/arena_alignment
+
+namespace {
+// an odd sized allocation in front of every matrix, as happens when scalar
+// varis are interleaved with matrix operations
+void misalign_arena() {
+  stan::math::ChainableStack::instance_->memalloc_.alloc(24);
+}
+}  // namespace
+
+static void multiply_rev(benchmark::State& state) {
+  using stan::math::var_value;
+  const int n = state.range(0);
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(n, n);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(n, n);
+  for (auto _ : state) {
+    misalign_arena();
+    var_value<Eigen::MatrixXd> a_v(a);
+    misalign_arena();
+    var_value<Eigen::MatrixXd> b_v(b);
+    misalign_arena();
+    stan::math::var lp = stan::math::sum(stan::math::multiply(a_v, b_v));
+    lp.grad();
+    benchmark::DoNotOptimize(a_v.adj().data());
+    stan::math::recover_memory();
+  }
+}
+
+static void elementwise_rev(benchmark::State& state) {
+  using stan::math::var_value;
+  const int n = state.range(0);
+  Eigen::VectorXd a = Eigen::VectorXd::Random(n);
+  Eigen::VectorXd b = Eigen::VectorXd::Random(n);
+  for (auto _ : state) {
+    misalign_arena();
+    var_value<Eigen::VectorXd> a_v(a);
+    misalign_arena();
+    var_value<Eigen::VectorXd> b_v(b);
+    misalign_arena();
+    auto c = stan::math::elt_multiply(stan::math::exp(a_v), b_v);
+    misalign_arena();
+    stan::math::var lp = stan::math::sum(stan::math::add(c, a_v));
+    lp.grad();
+    benchmark::DoNotOptimize(a_v.adj().data());
+    stan::math::recover_memory();
+  }
+}
+
+BENCHMARK(multiply_rev)->RangeMultiplier(4)->Range(16, 512);
+BENCHMARK(elementwise_rev)->RangeMultiplier(8)->Range(64, 1 << 20);
+BENCHMARK_MAIN();
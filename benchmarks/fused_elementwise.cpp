@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+
+// Compares the forward and reverse pass of exp(a .* b + c) ./ d on
+// var_value<Eigen::VectorXd> operands computed with one vari and arena
+// matrix per operation against one fused expression.
+//
+// Build and run with
+//   make benchmarks/fused_elementwise && ./benchmarks/fused_elementwise
+
+namespace {
+using vec_v = stan::math::var_value<Eigen::VectorXd>;
+
+Eigen::VectorXd inputs(benchmark::State& state, double offset) {
+  return Eigen::VectorXd::LinSpaced(state.range(0), offset, offset + 1.0);
+}
+
+void unfused(benchmark::State& state) {
+  Eigen::VectorXd a_val = inputs(state, 0.0);
+  Eigen::VectorXd b_val = inputs(state, 0.5);
+  Eigen::VectorXd c_val = inputs(state, -1.0);
+  Eigen::VectorXd d_val = inputs(state, 1.0);
+  for (auto _ : state) {
+    vec_v a = a_val;
+    vec_v b = b_val;
+    vec_v c = c_val;
+    vec_v d = d_val;
+    vec_v res = stan::math::elt_divide(
+        stan::math::exp(stan::math::elt_multiply(a, b) + c), d);
+    stan::math::sum(res).grad();
+    benchmark::DoNotOptimize(a.adj().data());
+    stan::math::recover_memory();
+  }
+}
+
+void fused(benchmark::State& state) {
+  Eigen::VectorXd a_val = inputs(state, 0.0);
+  Eigen::VectorXd b_val = inputs(state, 0.5);
+  Eigen::VectorXd c_val = inputs(state, -1.0);
+  Eigen::VectorXd d_val = inputs(state, 1.0);
+  for (auto _ : state) {
+    vec_v a = a_val;
+    vec_v b = b_val;
+    vec_v c = c_val;
+    vec_v d = d_val;
+    using stan::math::fuse;
+    vec_v res = elt_divide(exp(elt_multiply(fuse(a), fuse(b)) + fuse(c)),
+                           fuse(d))
+                    .eval();
+    stan::math::sum(res).grad();
+    benchmark::DoNotOptimize(a.adj().data());
+    stan::math::recover_memory();
+  }
+}
+}  // namespace
+
+BENCHMARK(unfused)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK(fused)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_MAIN();
@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/mix.hpp>
+
+// Compares the Hessian of a scalar function computed with one fvar<var>
+// evaluation and reverse pass per input against one edge pushing sweep
+// over a static_tape recording, for a function with a dense Hessian and
+// one with a tridiagonal Hessian.
+//
+// Build and run with
+//   make benchmarks/hessian_edge_pushing && ./benchmarks/hessian_edge_pushing
+
+namespace {
+// log density of a multivariate logistic-type model, dense Hessian
+struct dense_fun {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::log_sum_exp;
+    using stan::math::square;
+    T s = 0;
+    T lse = x(0);
+    for (Eigen::Index i = 0; i < x.size(); ++i) {
+      s += square(x(i)) * 0.5;
+      if (i > 0) {
+        lse = log_sum_exp(lse, x(i));
+      }
+    }
+    return s + lse;
+  }
+};
+
+// random walk prior with scale parameters, tridiagonal Hessian
+struct chain_fun {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::square;
+    T lp = 0;
+    for (Eigen::Index i = 1; i < x.size(); ++i) {
+      T mu = 0.5 * x(i - 1) + 0.1;
+      T sigma = exp(0.1 * x(i));
+      lp -= 0.5 * square((x(i) - mu) / sigma) + log(sigma);
+    }
+    return lp;
+  }
+};
+
+Eigen::VectorXd inputs(benchmark::State& state) {
+  return Eigen::VectorXd::LinSpaced(state.range(0), -1.0, 1.0);
+}
+
+template <typename F>
+void fvar_var_hessian(benchmark::State& state) {
+  Eigen::VectorXd x = inputs(state);
+  double fx;
+  Eigen::VectorXd grad;
+  Eigen::MatrixXd H;
+  for (auto _ : state) {
+    stan::math::hessian(F(), x, fx, grad, H);
+    benchmark::DoNotOptimize(H.data());
+  }
+}
+
+template <typename F>
+void edge_pushing_hessian(benchmark::State& state) {
+  Eigen::VectorXd x = inputs(state);
+  stan::math::static_tape tape;
+  double fx;
+  Eigen::VectorXd grad;
+  Eigen::MatrixXd H;
+  for (auto _ : state) {
+    tape.clear();
+    stan::math::hessian(tape, F(), x, fx, grad, H);
+    benchmark::DoNotOptimize(H.data());
+  }
+}
+
+template <typename F>
+void edge_pushing_replay(benchmark::State& state) {
+  Eigen::VectorXd x = inputs(state);
+  stan::math::static_tape tape;
+  double fx;
+  Eigen::VectorXd grad;
+  Eigen::MatrixXd H;
+  stan::math::hessian(tape, F(), x, fx, grad, H);
+  for (auto _ : state) {
+    stan::math::hessian(tape, F(), x, fx, grad, H);
+    benchmark::DoNotOptimize(H.data());
+  }
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(fvar_var_hessian, dense_fun)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+BENCHMARK_TEMPLATE(edge_pushing_hessian, dense_fun)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+BENCHMARK_TEMPLATE(edge_pushing_replay, dense_fun)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+BENCHMARK_TEMPLATE(fvar_var_hessian, chain_fun)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+BENCHMARK_TEMPLATE(edge_pushing_hessian, chain_fun)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+BENCHMARK_TEMPLATE(edge_pushing_replay, chain_fun)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+BENCHMARK_MAIN();
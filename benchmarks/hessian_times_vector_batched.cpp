@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/mix.hpp>
+
+// Compares the products of a Hessian with many directions at one point
+// computed with one fvar<var> evaluation and reverse pass per direction
+// against one batched call sharing a static_tape recording. The counter
+// per_direction reports the amortized time per direction.
+//
+// Build and run with
+//   make benchmarks/hessian_times_vector_batched
+//   ./benchmarks/hessian_times_vector_batched
+
+namespace {
+// log density of a multivariate logistic-type model with a random walk
+struct log_density {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::log_sum_exp;
+    using stan::math::square;
+    T lp = 0;
+    T lse = x(0);
+    for (Eigen::Index i = 1; i < x.size(); ++i) {
+      T sigma = exp(0.1 * x(i));
+      lp -= 0.5 * square((x(i) - 0.5 * x(i - 1)) / sigma) + log(sigma);
+      lse = log_sum_exp(lse, x(i));
+    }
+    return lp - lse;
+  }
+};
+
+constexpr int num_inputs = 100;
+
+Eigen::MatrixXd directions(benchmark::State& state) {
+  Eigen::MatrixXd V(num_inputs, state.range(0));
+  for (Eigen::Index j = 0; j < V.cols(); ++j) {
+    for (Eigen::Index i = 0; i < V.rows(); ++i) {
+      V(i, j) = std::sin(1.0 + i + 3.0 * j);
+    }
+  }
+  return V;
+}
+
+void per_direction(benchmark::State& state) {
+  state.counters["per_direction"] = benchmark::Counter(
+      state.iterations() * state.range(0),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+void fvar_var_hessian_times_vector(benchmark::State& state) {
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(num_inputs, -1.0, 1.0);
+  Eigen::MatrixXd V = directions(state);
+  double fx;
+  Eigen::VectorXd Hv;
+  for (auto _ : state) {
+    for (Eigen::Index j = 0; j < V.cols(); ++j) {
+      stan::math::hessian_times_vector(log_density(), x,
+                                       Eigen::VectorXd(V.col(j)), fx, Hv);
+      benchmark::DoNotOptimize(Hv.data());
+    }
+  }
+  per_direction(state);
+}
+
+template <int Lanes>
+void batched_hessian_times_vector(benchmark::State& state) {
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(num_inputs, -1.0, 1.0);
+  Eigen::MatrixXd V = directions(state);
+  stan::math::static_tape tape;
+  double fx;
+  Eigen::VectorXd grad_fx_dot_V;
+  Eigen::MatrixXd HV;
+  for (auto _ : state) {
+    tape.clear();
+    stan::math::hessian_times_vector<Lanes>(tape, log_density(), x, V, fx,
+                                            grad_fx_dot_V, HV);
+    benchmark::DoNotOptimize(HV.data());
+  }
+  per_direction(state);
+}
+
+template <int Lanes>
+void batched_hessian_times_vector_replay(benchmark::State& state) {
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(num_inputs, -1.0, 1.0);
+  Eigen::MatrixXd V = directions(state);
+  stan::math::static_tape tape;
+  double fx;
+  Eigen::VectorXd grad_fx_dot_V;
+  Eigen::MatrixXd HV;
+  stan::math::hessian_times_vector<Lanes>(tape, log_density(), x, V, fx,
+                                          grad_fx_dot_V, HV);
+  for (auto _ : state) {
+    stan::math::hessian_times_vector<Lanes>(tape, log_density(), x, V, fx,
+                                            grad_fx_dot_V, HV);
+    benchmark::DoNotOptimize(HV.data());
+  }
+  per_direction(state);
+}
+}  // namespace
+
+BENCHMARK(fvar_var_hessian_times_vector)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK_TEMPLATE(batched_hessian_times_vector, 1)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(batched_hessian_times_vector, 4)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(batched_hessian_times_vector_replay, 4)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(batched_hessian_times_vector_replay, 8)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <cstddef>
+#include <limits>
+
+// Compares the reverse pass of a scalar-heavy function when run by calling
+// the virtual chain() of every vari on the stack against the switch
+// dispatched sweep over a static_tape, serial and level-parallel, and times
+// a full replay of the tape.
+//
+// Build and run with
+//   make benchmarks/static_tape_sweep && ./benchmarks/static_tape_sweep
+
+namespace {
+struct scalar_heavy {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::square;
+    T lp = 0;
+    for (Eigen::Index i = 1; i < x.size(); ++i) {
+      T mu = 0.5 * x(i - 1) + 0.1;
+      T sigma = exp(0.1 * x(i));
+      lp -= 0.5 * square((x(i) - mu) / sigma) + log(sigma);
+    }
+    return lp;
+  }
+};
+
+Eigen::VectorXd inputs(benchmark::State& state) {
+  return Eigen::VectorXd::LinSpaced(state.range(0), -1.0, 1.0);
+}
+}  // namespace
+
+static void virtual_chain_sweep(benchmark::State& state) {
+  using stan::math::var;
+  Eigen::VectorXd x = inputs(state);
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  var fx = scalar_heavy()(x_var);
+  for (auto _ : state) {
+    nested.set_zero_all_adjoints();
+    stan::math::grad(fx.vi_);
+    benchmark::DoNotOptimize(x_var.coeffRef(0).adj());
+  }
+  state.counters["ops"]
+      = stan::math::ChainableStack::instance_->var_stack_.size();
+}
+
+static void static_tape_sweep(benchmark::State& state) {
+  using stan::math::var;
+  Eigen::VectorXd x = inputs(state);
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  stan::math::static_tape tape;
+  // the largest tapes exceed the default threshold of the parallel sweep
+  tape.set_parallel_threshold(std::numeric_limits<std::size_t>::max());
+  tape.start_recording(x_var);
+  var fx = scalar_heavy()(x_var);
+  tape.stop_recording(fx);
+  Eigen::VectorXd grad_fx(x.size());
+  for (auto _ : state) {
+    tape.grad(grad_fx);
+    benchmark::DoNotOptimize(grad_fx.data());
+  }
+  state.counters["ops"] = tape.size();
+}
+
+static void static_tape_parallel_sweep(benchmark::State& state) {
+  using stan::math::var;
+  Eigen::VectorXd x = inputs(state);
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  stan::math::static_tape tape;
+  tape.set_parallel_threshold(0);
+  tape.start_recording(x_var);
+  var fx = scalar_heavy()(x_var);
+  tape.stop_recording(fx);
+  Eigen::VectorXd grad_fx(x.size());
+  for (auto _ : state) {
+    tape.grad(grad_fx);
+    benchmark::DoNotOptimize(grad_fx.data());
+  }
+  state.counters["ops"] = tape.size();
+}
+
+static void rebuild_gradient(benchmark::State& state) {
+  Eigen::VectorXd x = inputs(state);
+  double fx;
+  Eigen::VectorXd grad_fx(x.size());
+  for (auto _ : state) {
+    stan::math::gradient(scalar_heavy(), x, fx, grad_fx);
+    benchmark::DoNotOptimize(grad_fx.data());
+  }
+}
+
+static void static_tape_replay(benchmark::State& state) {
+  Eigen::VectorXd x = inputs(state);
+  stan::math::static_tape tape;
+  double fx;
+  Eigen::VectorXd grad_fx(x.size());
+  stan::math::gradient(tape, scalar_heavy(), x, fx, grad_fx);
+  for (auto _ : state) {
+    stan::math::gradient(tape, scalar_heavy(), x, fx, grad_fx);
+    benchmark::DoNotOptimize(grad_fx.data());
+  }
+}
+
+BENCHMARK(virtual_chain_sweep)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(static_tape_sweep)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(static_tape_parallel_sweep)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(rebuild_gradient)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(static_tape_replay)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_MAIN();
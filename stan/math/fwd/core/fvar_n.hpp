@@ -0,0 +1,260 @@
+#ifndef STAN_MATH_FWD_CORE_FVAR_N_HPP
+#define STAN_MATH_FWD_CORE_FVAR_N_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <ostream>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+/**
+ * This template class represents scalars used in forward-mode
+ * automatic differentiation which carry the directional derivatives
+ * of their value in `N` directions at once.  Where `fvar<T>` needs
+ * one evaluation of a function per direction, `fvar_n<T, N>`
+ * propagates `N` tangents through a single evaluation, so the values
+ * are only computed once and the tangent arithmetic operates on
+ * fixed size arrays which Eigen vectorizes.
+ *
+ * The tangents are stored unaligned so that `fvar_n` may be stored in
+ * standard containers and in Eigen matrices without requiring
+ * aligned allocation; Eigen still uses (unaligned) packet
+ * instructions for the tangent arithmetic.
+ *
+ * `fvar_n` supports only
+ *
+ * - the arithmetic, compound assignment and comparison operators,
+ * - `value_of`, and
+ * - the elementary functions `exp`, `expm1`, `log`, `log1p`, `sqrt`,
+ *   `square`, `inv`, `pow`, `sin`, `cos`, `tanh`, `fabs`, `inv_logit`
+ *   and `lgamma`.
+ *
+ * It is deliberately not an autodiff type to the meta programs:
+ * `is_fvar`, `partials_type` and `return_type` do not recognize it, so
+ * the other functions in `stan/math/fwd/fun`, the generic functions in
+ * `stan/math/prim` and `operands_and_partials` do not accept it.
+ * Functions passed to the chunked `jacobian<N>()` and `hessian<N>()`
+ * must be written with the functions listed above.  `fvar_n` may be
+ * nested as the value type of `fvar<T>` to compute second derivatives
+ * in several directions at once.
+ *
+ * @tparam T type of value and tangents
+ * @tparam N number of tangents
+ */
+template <typename T, int N>
+struct fvar_n {
+  static_assert(N > 0, "fvar_n requires a positive number of tangents");
+
+  /**
+   * The type of the value.
+   */
+  using Scalar = std::decay_t<T>;
+
+  /**
+   * The type of the tangents.
+   */
+  using tangent_type = Eigen::Array<Scalar, N, 1, Eigen::DontAlign>;
+
+  /**
+   * The number of tangents.
+   */
+  static constexpr int num_tangents = N;
+
+  /**
+   * The value of this variable.
+   */
+  Scalar val_;
+
+  /**
+   * The tangents (directional derivatives) of this variable.
+   */
+  tangent_type d_;
+
+  /**
+   * Return the value of this variable.
+   *
+   * @return value of this variable
+   */
+  Scalar val() const { return val_; }
+
+  /**
+   * Return the tangents of this variable.
+   *
+   * @return tangents of this variable
+   */
+  const tangent_type& d() const { return d_; }
+
+  /**
+   * Return the specified tangent of this variable.
+   *
+   * @param[in] i index of tangent
+   * @return tangent in the i-th direction
+   */
+  Scalar d(int i) const { return d_.coeff(i); }
+
+  /**
+   * Construct a forward variable with zero value and tangents.
+   */
+  fvar_n() : val_(0.0), d_(tangent_type::Zero()) {}  // NOLINT
+
+  /**
+   * Construct a forward variable with the specified value and
+   * zero tangents.
+   *
+   * @tparam V type of value (must be assignable to T)
+   * @param[in] v value
+   */
+  template <typename V, std::enable_if_t<ad_promotable<V, T>::value>* = nullptr,
+            require_not_same_t<V, fvar_n<T, N>>* = nullptr>
+  fvar_n(const V& v)  // NOLINT(runtime/explicit)
+      : val_(v), d_(tangent_type::Zero()) {}
+
+  /**
+   * Construct a forward variable with the specified value and
+   * tangents.
+   *
+   * @tparam V type of value (must be assignable to T)
+   * @tparam D type of tangents (must be assignable to the tangent type)
+   * @param[in] v value
+   * @param[in] d tangents
+   */
+  template <typename V, typename D>
+  fvar_n(const V& v, const D& d) : val_(v), d_(d) {}
+
+  /**
+   * Return a forward variable with the specified value whose tangent
+   * is one in the specified direction and zero in all others.
+   *
+   * @param[in] v value
+   * @param[in] i direction of the unit tangent
+   * @return forward variable seeded in the i-th direction
+   */
+  static fvar_n<T, N> unit(const Scalar& v, int i) {
+    fvar_n<T, N> x(v);
+    x.d_.coeffRef(i) = 1.0;
+    return x;
+  }
+
+  /**
+   * Add the specified variable to this variable and return a
+   * reference to this variable.
+   *
+   * @param[in] x2 variable to add
+   * @return reference to this variable after addition
+   */
+  inline fvar_n<T, N>& operator+=(const fvar_n<T, N>& x2) {
+    val_ += x2.val_;
+    d_ += x2.d_;
+    return *this;
+  }
+
+  /**
+   * Add the specified value to this variable and return a
+   * reference to this variable.
+   *
+   * @param[in] x2 value to add
+   * @return reference to this variable after addition
+   */
+  inline fvar_n<T, N>& operator+=(double x2) {
+    val_ += x2;
+    return *this;
+  }
+
+  /**
+   * Subtract the specified variable from this variable and return a
+   * reference to this variable.
+   *
+   * @param[in] x2 variable to subtract
+   * @return reference to this variable after subtraction
+   */
+  inline fvar_n<T, N>& operator-=(const fvar_n<T, N>& x2) {
+    val_ -= x2.val_;
+    d_ -= x2.d_;
+    return *this;
+  }
+
+  /**
+   * Subtract the specified value from this variable and return a
+   * reference to this variable.
+   *
+   * @param[in] x2 value to subtract
+   * @return reference to this variable after subtraction
+   */
+  inline fvar_n<T, N>& operator-=(double x2) {
+    val_ -= x2;
+    return *this;
+  }
+
+  /**
+   * Multiply this variable by the the specified variable and
+   * return a reference to this variable.
+   *
+   * @param[in] x2 variable to multiply
+   * @return reference to this variable after multiplication
+   */
+  inline fvar_n<T, N>& operator*=(const fvar_n<T, N>& x2) {
+    d_ = d_ * x2.val_ + val_ * x2.d_;
+    val_ *= x2.val_;
+    return *this;
+  }
+
+  /**
+   * Multiply this variable by the the specified value and
+   * return a reference to this variable.
+   *
+   * @param[in] x2 value to multiply
+   * @return reference to this variable after multiplication
+   */
+  inline fvar_n<T, N>& operator*=(double x2) {
+    val_ *= x2;
+    d_ *= x2;
+    return *this;
+  }
+
+  /**
+   * Divide this variable by the the specified variable and
+   * return a reference to this variable.
+   *
+   * @param[in] x2 variable to divide this variable by
+   * @return reference to this variable after division
+   */
+  inline fvar_n<T, N>& operator/=(const fvar_n<T, N>& x2) {
+    d_ = (d_ * x2.val_ - val_ * x2.d_) / (x2.val_ * x2.val_);
+    val_ /= x2.val_;
+    return *this;
+  }
+
+  /**
+   * Divide this variable by the the specified value and
+   * return a reference to this variable.
+   *
+   * @param[in] x2 value to divide this variable by
+   * @return reference to this variable after division
+   */
+  inline fvar_n<T, N>& operator/=(double x2) {
+    val_ /= x2;
+    d_ /= x2;
+    return *this;
+  }
+
+  /**
+   * Write the value of the specified variable to the specified
+   * output stream, returning a reference to the output stream.
+   *
+   * @param[in,out] os stream for writing value
+   * @param[in] v variable whose value is written
+   * @return reference to the specified output stream
+   */
+  friend std::ostream& operator<<(std::ostream& os, const fvar_n<T, N>& v) {
+    return os << v.val_;
+  }
+};
+
+template <typename T, int N>
+constexpr int fvar_n<T, N>::num_tangents;
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -2,6 +2,7 @@
 #define STAN_MATH_FWD_CORE_OPERATOR_ADDITION_HPP
 
 #include <stan/math/fwd/core/fvar.hpp>
+#include <stan/math/fwd/core/fvar_n.hpp>
 
 namespace stan {
 namespace math {
@@ -45,6 +46,49 @@ inline fvar<T> operator+(const fvar<T>& x1, double x2) {
   return fvar<T>(x1.val_ + x2, x1.d_);
 }
 
+/**
+ * Return the sum of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return sum of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator+(const fvar_n<T, N>& x1,
+                              const fvar_n<T, N>& x2) {
+  return fvar_n<T, N>(x1.val_ + x2.val_, x1.d_ + x2.d_);
+}
+
+/**
+ * Return the sum of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return sum of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator+(double x1, const fvar_n<T, N>& x2) {
+  return fvar_n<T, N>(x1 + x2.val_, x2.d_);
+}
+
+/**
+ * Return the sum of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return sum of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator+(const fvar_n<T, N>& x1, double x2) {
+  return fvar_n<T, N>(x1.val_ + x2, x1.d_);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
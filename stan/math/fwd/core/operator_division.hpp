@@ -2,6 +2,7 @@
 #define STAN_MATH_FWD_CORE_OPERATOR_DIVISION_HPP
 
 #include <stan/math/fwd/core/fvar.hpp>
+#include <stan/math/fwd/core/fvar_n.hpp>
 #include <stan/math/prim/core/operator_division.hpp>
 #include <complex>
 #include <type_traits>
@@ -99,6 +100,51 @@ inline std::complex<fvar<T>> operator/(U x1, const std::complex<fvar<T>>& x2) {
   return internal::complex_divide(x1, x2);
 }
 
+/**
+ * Return the quotient of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return quotient of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator/(const fvar_n<T, N>& x1,
+                              const fvar_n<T, N>& x2) {
+  return fvar_n<T, N>(
+      x1.val_ / x2.val_,
+      (x1.d_ * x2.val_ - x1.val_ * x2.d_) / (x2.val_ * x2.val_));
+}
+
+/**
+ * Return the quotient of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return quotient of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator/(double x1, const fvar_n<T, N>& x2) {
+  return fvar_n<T, N>(x1 / x2.val_, -x1 * x2.d_ / (x2.val_ * x2.val_));
+}
+
+/**
+ * Return the quotient of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return quotient of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator/(const fvar_n<T, N>& x1, double x2) {
+  return fvar_n<T, N>(x1.val_ / x2, x1.d_ / x2);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -2,6 +2,7 @@
 #define STAN_MATH_FWD_CORE_OPERATOR_GREATER_THAN_HPP
 
 #include <stan/math/fwd/core/fvar.hpp>
+#include <stan/math/fwd/core/fvar_n.hpp>
 
 namespace stan {
 namespace math {
@@ -51,6 +52,54 @@ inline bool operator>(double x, const fvar<T>& y) {
   return x > y.val_;
 }
 
+/**
+ * Return true if the value of the first argument is greater than the
+ * value of the second argument.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x first argument
+ * @param[in] y second argument
+ * @return true if the first argument's value is greater than the
+ * second argument's value
+ */
+template <typename T, int N>
+inline bool operator>(const fvar_n<T, N>& x, const fvar_n<T, N>& y) {
+  return x.val_ > y.val_;
+}
+
+/**
+ * Return true if the value of the first argument is greater than the
+ * value of the second argument.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x first argument
+ * @param[in] y second argument
+ * @return true if the first argument's value is greater than the
+ * second argument's value
+ */
+template <typename T, int N>
+inline bool operator>(const fvar_n<T, N>& x, double y) {
+  return x.val_ > y;
+}
+
+/**
+ * Return true if the value of the first argument is greater than the
+ * value of the second argument.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x first argument
+ * @param[in] y second argument
+ * @return true if the first argument's value is greater than the
+ * second argument's value
+ */
+template <typename T, int N>
+inline bool operator>(double x, const fvar_n<T, N>& y) {
+  return x > y.val_;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -2,6 +2,7 @@
 #define STAN_MATH_FWD_CORE_OPERATOR_MULTIPLICATION_HPP
 
 #include <stan/math/fwd/core/fvar.hpp>
+#include <stan/math/fwd/core/fvar_n.hpp>
 #include <stan/math/fwd/core/std_complex.hpp>
 #include <stan/math/prim/core/operator_multiplication.hpp>
 
@@ -92,6 +93,49 @@ inline std::complex<stan::math::fvar<T>> operator*(
   return internal::complex_multiply(x, y);
 }
 
+/**
+ * Return the product of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return product of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator*(const fvar_n<T, N>& x1,
+                              const fvar_n<T, N>& x2) {
+  return fvar_n<T, N>(x1.val_ * x2.val_, x1.d_ * x2.val_ + x1.val_ * x2.d_);
+}
+
+/**
+ * Return the product of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return product of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator*(double x1, const fvar_n<T, N>& x2) {
+  return fvar_n<T, N>(x1 * x2.val_, x1 * x2.d_);
+}
+
+/**
+ * Return the product of the two arguments.
+ *
+ * @tparam T value and tangent type for variables
+ * @tparam N number of tangents
+ * @param[in] x1 first argument
+ * @param[in] x2 second argument
+ * @return product of the arguments
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator*(const fvar_n<T, N>& x1, double x2) {
+  return fvar_n<T, N>(x1.val_ * x2, x1.d_ * x2);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
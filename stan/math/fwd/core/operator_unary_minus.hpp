@@ -2,6 +2,7 @@
 #define STAN_MATH_FWD_CORE_OPERATOR_UNARY_MINUS_HPP
 
 #include <stan/math/fwd/core/fvar.hpp>
+#include <stan/math/fwd/core/fvar_n.hpp>
 
 namespace stan {
 namespace math {
@@ -17,6 +18,20 @@ template <typename T>
 inline fvar<T> operator-(const fvar<T>& x) {
   return fvar<T>(-x.val_, -x.d_);
 }
+
+/**
+ * Return the negation of the specified argument.
+ *
+ * @tparam T value and tangent type of the argument
+ * @tparam N number of tangents
+ * @param[in] x argument
+ * @return negation of argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> operator-(const fvar_n<T, N>& x) {
+  return fvar_n<T, N>(-x.val_, -x.d_);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
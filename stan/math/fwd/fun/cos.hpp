@@ -29,6 +29,22 @@ inline std::complex<fvar<T>> cos(const std::complex<fvar<T>>& z) {
   return internal::complex_cos(z);
 }
 
+/**
+ * Return the cosine of the specified argument, propagating all of its
+ * tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return cosine of the argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> cos(const fvar_n<T, N>& x) {
+  using std::cos;
+  using std::sin;
+  return fvar_n<T, N>(cos(x.val_), x.d_ * -sin(x.val_));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
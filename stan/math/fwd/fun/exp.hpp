@@ -27,6 +27,22 @@ inline std::complex<fvar<T>> exp(const std::complex<fvar<T>>& z) {
   return internal::complex_exp(z);
 }
 
+/**
+ * Return the natural exponentiation (base e) of the specified
+ * argument, propagating all of its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return exponentiation of argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> exp(const fvar_n<T, N>& x) {
+  using std::exp;
+  T exp_x = exp(x.val_);
+  return fvar_n<T, N>(exp_x, x.d_ * exp_x);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -15,6 +15,21 @@ inline fvar<T> expm1(const fvar<T>& x) {
   return fvar<T>(expm1(x.val_), x.d_ * exp(x.val_));
 }
 
+/**
+ * Return the natural exponentiation of the specified argument minus
+ * one, propagating all of its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return exponentiation of argument minus one
+ */
+template <typename T, int N>
+inline fvar_n<T, N> expm1(const fvar_n<T, N>& x) {
+  using std::exp;
+  return fvar_n<T, N>(expm1(x.val_), x.d_ * exp(x.val_));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
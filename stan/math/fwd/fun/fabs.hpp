@@ -26,6 +26,30 @@ inline fvar<T> fabs(const fvar<T>& x) {
   }
 }
 
+/**
+ * Return the absolute value of the specified argument, propagating
+ * all of its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return absolute value of the argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> fabs(const fvar_n<T, N>& x) {
+  using std::fabs;
+  if (unlikely(is_nan(value_of(x.val_)))) {
+    return fvar_n<T, N>(fabs(x.val_),
+                        fvar_n<T, N>::tangent_type::Constant(NOT_A_NUMBER));
+  } else if (x.val_ > 0.0) {
+    return x;
+  } else if (x.val_ < 0.0) {
+    return -x;
+  } else {
+    return fvar_n<T, N>(0);
+  }
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -12,6 +12,21 @@ template <typename T>
 inline fvar<T> inv(const fvar<T>& x) {
   return fvar<T>(1 / x.val_, -x.d_ / square(x.val_));
 }
+
+/**
+ * Return the reciprocal of the specified argument, propagating all of
+ * its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return reciprocal of the argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> inv(const fvar_n<T, N>& x) {
+  return fvar_n<T, N>(1 / x.val_, x.d_ * (-1 / square(x.val_)));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -24,6 +24,21 @@ inline fvar<T> inv_logit(const fvar<T>& x) {
                  x.d_ * inv_logit(x.val_) * (1 - inv_logit(x.val_)));
 }
 
+/**
+ * Returns the inverse logit function applied to the argument,
+ * propagating all of its tangents.
+ *
+ * @tparam T value type of the fvar_n
+ * @tparam N number of tangents
+ * @param x argument
+ * @return inverse logit of argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> inv_logit(const fvar_n<T, N>& x) {
+  T u = inv_logit(x.val_);
+  return fvar_n<T, N>(u, x.d_ * (u * (1 - u)));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
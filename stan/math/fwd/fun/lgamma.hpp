@@ -22,6 +22,20 @@ inline fvar<T> lgamma(const fvar<T>& x) {
   return fvar<T>(lgamma(x.val_), x.d_ * digamma(x.val_));
 }
 
+/**
+ * Return the natural logarithm of the gamma function applied to
+ * the specified argument, propagating all of its tangents.
+ *
+ * @tparam T value type of the fvar_n
+ * @tparam N number of tangents
+ * @param x Argument.
+ * @return natural logarithm of the gamma function of argument.
+ */
+template <typename T, int N>
+inline fvar_n<T, N> lgamma(const fvar_n<T, N>& x) {
+  return fvar_n<T, N>(lgamma(x.val_), x.d_ * digamma(x.val_));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
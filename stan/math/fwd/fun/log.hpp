@@ -33,6 +33,25 @@ inline std::complex<fvar<T>> log(const std::complex<fvar<T>>& z) {
   return internal::complex_log(z);
 }
 
+/**
+ * Return the natural logarithm of the specified argument,
+ * propagating all of its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return natural logarithm of argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> log(const fvar_n<T, N>& x) {
+  using std::log;
+  if (x.val_ < 0.0) {
+    return fvar_n<T, N>(NOT_A_NUMBER,
+                        fvar_n<T, N>::tangent_type::Constant(NOT_A_NUMBER));
+  }
+  return fvar_n<T, N>(log(x.val_), x.d_ / x.val_);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
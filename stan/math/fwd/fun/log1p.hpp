@@ -13,6 +13,20 @@ inline fvar<T> log1p(const fvar<T>& x) {
   return fvar<T>(log1p(x.val_), x.d_ / (1 + x.val_));
 }
 
+/**
+ * Return the natural logarithm of one plus the specified argument,
+ * propagating all of its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return natural logarithm of one plus the argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> log1p(const fvar_n<T, N>& x) {
+  return fvar_n<T, N>(log1p(x.val_), x.d_ / (1 + x.val_));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -7,6 +7,7 @@
 #include <stan/math/fwd/fun/inv.hpp>
 #include <stan/math/fwd/fun/inv_sqrt.hpp>
 #include <stan/math/fwd/fun/inv_square.hpp>
+#include <stan/math/fwd/fun/square.hpp>
 #include <stan/math/prim/fun/pow.hpp>
 #include <cmath>
 #include <complex>
@@ -57,6 +58,64 @@ inline fvar<T> pow(const fvar<T>& x1, U x2) {
   return fvar<T>(pow(x1.val_, x2), x1.d_ * x2 * pow(x1.val_, x2 - 1));
 }
 
+/**
+ * Return the first argument raised to the power of the second
+ * argument, propagating all of their tangents.
+ *
+ * @tparam T value type of autodiff variables
+ * @tparam N number of tangents
+ * @param x1 base variable
+ * @param x2 exponent variable
+ * @return base raised to the power of the exponent
+ */
+template <typename T, int N>
+inline fvar_n<T, N> pow(const fvar_n<T, N>& x1, const fvar_n<T, N>& x2) {
+  using std::log;
+  using std::pow;
+  T u = pow(x1.val_, x2.val_);
+  return fvar_n<T, N>(
+      u, (x2.d_ * log(x1.val_) + x1.d_ * (x2.val_ / x1.val_)) * u);
+}
+
+/**
+ * Return the first argument raised to the power of the second
+ * argument, propagating all of the tangents of the exponent.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @tparam U arithmetic type of base
+ * @param x1 base
+ * @param x2 exponent variable
+ * @return base raised to the power of the exponent
+ */
+template <typename T, int N, typename U, typename = require_arithmetic_t<U>>
+inline fvar_n<T, N> pow(U x1, const fvar_n<T, N>& x2) {
+  using std::log;
+  using std::pow;
+  T u = pow(x1, x2.val_);
+  return fvar_n<T, N>(u, x2.d_ * (log(x1) * u));
+}
+
+/**
+ * Return the first argument raised to the power of the second
+ * argument, propagating all of the tangents of the base.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @tparam U arithmetic type of exponent
+ * @param x1 base variable
+ * @param x2 exponent
+ * @return base raised to the power of the exponent
+ */
+template <typename T, int N, typename U, typename = require_arithmetic_t<U>>
+inline fvar_n<T, N> pow(const fvar_n<T, N>& x1, U x2) {
+  using std::pow;
+  if (x2 == 2.0) {
+    return square(x1);
+  }
+  return fvar_n<T, N>(pow(x1.val_, x2), x1.d_ * (x2 * pow(x1.val_, x2 - 1)));
+}
+
 // must uniquely match all pairs of:
 //    { complex<fvar<V>>, complex<T>, fvar<V>, T }
 // with at least one fvar<V> and at least one complex, where T is arithmetic:
@@ -29,6 +29,22 @@ inline std::complex<fvar<T>> sin(const std::complex<fvar<T>>& z) {
   return internal::complex_sin(z);
 }
 
+/**
+ * Return the sine of the specified argument, propagating all of its
+ * tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return sine of the argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> sin(const fvar_n<T, N>& x) {
+  using std::cos;
+  using std::sin;
+  return fvar_n<T, N>(sin(x.val_), x.d_ * cos(x.val_));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -31,6 +31,22 @@ inline std::complex<fvar<T>> sqrt(const std::complex<fvar<T>>& z) {
   return internal::complex_sqrt(z);
 }
 
+/**
+ * Return the square root of the specified argument, propagating all
+ * of its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return square root of the argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> sqrt(const fvar_n<T, N>& x) {
+  using std::sqrt;
+  T sqrt_x = sqrt(x.val_);
+  return fvar_n<T, N>(sqrt_x, x.d_ * (0.5 / sqrt_x));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
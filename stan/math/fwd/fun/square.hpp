@@ -12,6 +12,21 @@ template <typename T>
 inline fvar<T> square(const fvar<T>& x) {
   return fvar<T>(square(x.val_), x.d_ * 2 * x.val_);
 }
+
+/**
+ * Return the square of the specified argument, propagating all of
+ * its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return square of the argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> square(const fvar_n<T, N>& x) {
+  return fvar_n<T, N>(square(x.val_), x.d_ * (2 * x.val_));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
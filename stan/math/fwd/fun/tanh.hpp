@@ -30,6 +30,22 @@ inline std::complex<fvar<T>> tanh(const std::complex<fvar<T>>& z) {
   return stan::math::internal::complex_tanh(z);
 }
 
+/**
+ * Return the hyperbolic tangent of the specified argument,
+ * propagating all of its tangents.
+ *
+ * @tparam T value type of autodiff variable
+ * @tparam N number of tangents
+ * @param x argument
+ * @return hyperbolic tangent of the argument
+ */
+template <typename T, int N>
+inline fvar_n<T, N> tanh(const fvar_n<T, N>& x) {
+  using std::tanh;
+  T u = tanh(x.val_);
+  return fvar_n<T, N>(u, x.d_ * (1 - u * u));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -10,5 +10,6 @@
 #include <stan/math/fwd/functor/operands_and_partials.hpp>
 #include <stan/math/fwd/functor/partials_propagator.hpp>
 #include <stan/math/fwd/functor/reduce_sum.hpp>
+#include <stan/math/fwd/functor/sparse_jacobian.hpp>
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <stan/math/fwd/core.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
+#include <algorithm>
 
 namespace stan {
 namespace math {
@@ -67,6 +68,74 @@ void hessian(const F& f, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x, T& fx,
   }
 }
 
+/**
+ * Calculate the value, the gradient, and the Hessian,
+ * of the specified function at the specified argument, propagating
+ * the inner tangents of `N` inputs through each evaluation of the
+ * function, so that the function is evaluated about `N` times less
+ * often than by <code>hessian(f, x, fx, grad, H)</code>.
+ *
+ * <p>The functor must implement
+ *
+ * <code>
+ * fvar\<fvar_n\<T, N\> \>
+ * operator()(const
+ * Eigen::Matrix\<fvar\<fvar_n\<T, N\> \>, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for `fvar_n`; see `fvar_n`
+ * for the operations it supports.
+ *
+ * @tparam N number of inner tangents propagated per evaluation
+ * @tparam T type of elements in the vector and matrix
+ * @tparam F type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument
+ */
+template <int N, typename T, typename F>
+void hessian(const F& f, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x, T& fx,
+             Eigen::Matrix<T, Eigen::Dynamic, 1>& grad,
+             Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& H) {
+  H.resize(x.size(), x.size());
+  grad.resize(x.size());
+  // size 0 separate because nothing to loop over in main body
+  if (x.size() == 0) {
+    fx = f(x);
+    return;
+  }
+  const int size = x.size();
+  Eigen::Matrix<fvar<fvar_n<T, N> >, Eigen::Dynamic, 1> x_fvar(size);
+  for (int start = 0; start < size; start += N) {
+    const int lanes = std::min(N, size - start);
+    // only the upper triangle is evaluated, so rows up to the last
+    // column of the chunk are needed
+    for (int i = 0; i < start + lanes; ++i) {
+      for (int k = 0; k < size; ++k) {
+        fvar_n<T, N> val(x(k));
+        if (k >= start && k < start + lanes) {
+          val.d_.coeffRef(k - start) = 1;
+        }
+        x_fvar(k) = fvar<fvar_n<T, N> >(val, fvar_n<T, N>(i == k));
+      }
+      fvar<fvar_n<T, N> > fx_fvar = f(x_fvar);
+      if (i == 0) {
+        if (start == 0) {
+          fx = fx_fvar.val_.val_;
+        }
+        grad.segment(start, lanes)
+            = fx_fvar.val_.d_.head(lanes).matrix();
+      }
+      for (int k = std::max(0, i - start); k < lanes; ++k) {
+        H(i, start + k) = fx_fvar.d_.d_.coeff(k);
+        H(start + k, i) = H(i, start + k);
+      }
+    }
+  }
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -3,6 +3,7 @@
 
 #include <stan/math/fwd/core.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
+#include <algorithm>
 
 namespace stan {
 namespace math {
@@ -32,6 +33,67 @@ void jacobian(const F& f, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x,
   }
 }
 
+/**
+ * Calculate the value and the Jacobian of the specified function at
+ * the specified argument, propagating the tangents of `N` inputs
+ * through each evaluation of the function.
+ *
+ * <p>The function is evaluated once per chunk of `N` inputs instead
+ * of once per input.  The functor must implement
+ *
+ * <code>
+ * Eigen::Matrix\<fvar_n\<T, N\>, Eigen::Dynamic, 1\>
+ * operator()(const
+ * Eigen::Matrix\<fvar_n\<T, N\>, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for `fvar_n`; see `fvar_n`
+ * for the operations it supports.
+ *
+ * @tparam N number of tangents propagated per evaluation
+ * @tparam T type of elements in the vector and matrix
+ * @tparam F type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] J Jacobian of function at argument
+ */
+template <int N, typename T, typename F>
+void jacobian(const F& f, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x,
+              Eigen::Matrix<T, Eigen::Dynamic, 1>& fx,
+              Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& J) {
+  using Eigen::Dynamic;
+  using Eigen::Matrix;
+  const int size = x.size();
+  Matrix<fvar_n<T, N>, Dynamic, 1> x_fvar(size);
+  for (int k = 0; k < size; ++k) {
+    x_fvar(k) = fvar_n<T, N>(x(k));
+  }
+  int start = 0;
+  do {
+    const int lanes = std::min(N, size - start);
+    for (int k = 0; k < lanes; ++k) {
+      x_fvar(start + k).d_.coeffRef(k) = 1;
+    }
+    Matrix<fvar_n<T, N>, Dynamic, 1> fx_fvar = f(x_fvar);
+    if (start == 0) {
+      fx.resize(fx_fvar.size());
+      J.resize(fx_fvar.size(), size);
+      for (int i = 0; i < fx_fvar.size(); ++i) {
+        fx(i) = fx_fvar(i).val_;
+      }
+    }
+    for (int i = 0; i < fx_fvar.size(); ++i) {
+      J.row(i).segment(start, lanes)
+          = fx_fvar(i).d_.head(lanes).matrix().transpose();
+    }
+    for (int k = 0; k < lanes; ++k) {
+      x_fvar(start + k).d_.coeffRef(k) = 0;
+    }
+    start += N;
+  } while (start < size);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
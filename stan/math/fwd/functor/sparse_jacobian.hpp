@@ -0,0 +1,94 @@
+#ifndef STAN_MATH_FWD_FUNCTOR_SPARSE_JACOBIAN_HPP
+#define STAN_MATH_FWD_FUNCTOR_SPARSE_JACOBIAN_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/column_coloring.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Calculate the value and the Jacobian with the specified sparsity
+ * pattern of the specified function at the specified argument.
+ *
+ * <p>The inputs are colored so that no two inputs of the same color
+ * affect the same dependent variable, see `column_coloring()`. Each
+ * evaluation of the function seeds the tangents of all inputs of one
+ * color and yields their columns of the Jacobian, so the function is
+ * evaluated once per color rather than once per input.
+ *
+ * <p>The functor must implement
+ *
+ * <code>
+ * Eigen::Matrix\<fvar\<T\>, Eigen::Dynamic, 1\>
+ * operator()(const
+ * Eigen::Matrix\<fvar\<T\>, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for the argument type.
+ * Entries of the Jacobian outside of the pattern are not computed and
+ * must be zero.
+ *
+ * @tparam T type of elements in the vector and matrix
+ * @tparam F type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[in] pattern sparsity pattern of the Jacobian, whose stored
+ * entries are the structural non-zeros
+ * @param[out] fx Function applied to argument
+ * @param[out] J Jacobian of function at argument, with the sparsity
+ * pattern of `pattern`
+ * @throw std::invalid_argument if the size of the pattern does not
+ * match the sizes of the argument and of the function value
+ */
+template <typename T, typename F>
+void sparse_jacobian(const F& f, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x,
+                     const Eigen::SparseMatrix<double>& pattern,
+                     Eigen::Matrix<T, Eigen::Dynamic, 1>& fx,
+                     Eigen::SparseMatrix<T>& J) {
+  using Eigen::Dynamic;
+  using Eigen::Matrix;
+  check_size_match("sparse_jacobian", "columns of pattern", pattern.cols(),
+                   "size of argument", x.size());
+  const std::vector<int> color = column_coloring(pattern);
+  const int num_colors
+      = color.empty() ? 0 : *std::max_element(color.begin(), color.end()) + 1;
+
+  std::vector<Eigen::Triplet<T>> entries;
+  entries.reserve(pattern.nonZeros());
+  Matrix<fvar<T>, Dynamic, 1> x_fvar(x.size());
+  // the function value is needed even if there is no color
+  for (int c = 0; c < std::max(num_colors, 1); ++c) {
+    for (int k = 0; k < x.size(); ++k) {
+      x_fvar(k) = fvar<T>(x(k), color[k] == c);
+    }
+    Matrix<fvar<T>, Dynamic, 1> fx_fvar = f(x_fvar);
+    if (c == 0) {
+      check_size_match("sparse_jacobian", "rows of pattern", pattern.rows(),
+                       "size of function value", fx_fvar.size());
+      fx.resize(fx_fvar.size());
+      for (int i = 0; i < fx_fvar.size(); ++i) {
+        fx(i) = fx_fvar(i).val_;
+      }
+    }
+    for (int j = 0; j < x.size(); ++j) {
+      if (color[j] != c) {
+        continue;
+      }
+      for (Eigen::SparseMatrix<double>::InnerIterator it(pattern, j); it;
+           ++it) {
+        entries.emplace_back(it.row(), j, fx_fvar(it.row()).d_);
+      }
+    }
+  }
+  J.resize(pattern.rows(), pattern.cols());
+  J.setFromTriplets(entries.begin(), entries.end());
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -7,10 +7,20 @@
 #include <stan/math/prim/meta.hpp>
 #include <cstdlib>
 #include <cstddef>
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 
+// alignment of arena arrays, a power of two no larger than 64
+#ifndef STAN_ARENA_ALIGNMENT
+#define STAN_ARENA_ALIGNMENT 64
+#endif
+
 namespace stan {
 namespace math {
 
@@ -33,20 +43,57 @@ bool is_aligned(T* ptr, unsigned int bytes_aligned) {
 namespace internal {
 const size_t DEFAULT_INITIAL_NBYTES = 1 << 16;  // 64KB
 
-// FIXME: enforce alignment
-// big fun to inline, but only called twice
-inline char* eight_byte_aligned_malloc(size_t size) {
-  char* ptr = static_cast<char*>(malloc(size));
-  if (!ptr) {
-    return ptr;  // malloc failed to alloc
+// alignment of the start of every block, one cache line
+const size_t BLOCK_ALIGNMENT = 64;
+
+static_assert(STAN_ARENA_ALIGNMENT <= BLOCK_ALIGNMENT
+                  && (STAN_ARENA_ALIGNMENT & (STAN_ARENA_ALIGNMENT - 1)) == 0,
+              "STAN_ARENA_ALIGNMENT must be a power of two no larger than 64");
+
+// blocks of at least this size are aligned to and advised for huge pages
+const size_t HUGE_PAGE_NBYTES = 1 << 21;  // 2MB
+
+/**
+ * Allocate a block of memory for the arena. Blocks are aligned to a cache
+ * line. On Linux, blocks of at least `HUGE_PAGE_NBYTES` are aligned to a
+ * huge page and advised to be backed by transparent huge pages, unless
+ * `STAN_NO_HUGE_PAGES` is defined.
+ *
+ * @param size number of bytes to allocate
+ * @return pointer to the block or `nullptr` if the allocation failed
+ */
+inline char* aligned_block_malloc(size_t size) {
+  const size_t alignment
+      = size >= HUGE_PAGE_NBYTES ? HUGE_PAGE_NBYTES : BLOCK_ALIGNMENT;
+  void* ptr = nullptr;
+#ifdef _WIN32
+  ptr = _aligned_malloc(size, alignment);
+#else
+  if (posix_memalign(&ptr, alignment, size) != 0) {
+    return nullptr;
   }
-  if (!is_aligned(ptr, 8U)) {
-    std::stringstream s;
-    s << "invalid alignment to 8 bytes, ptr="
-      << reinterpret_cast<uintptr_t>(ptr) << std::endl;
-    throw std::runtime_error(s.str());
+#endif
+#if defined(__linux__) && defined(MADV_HUGEPAGE) \
+    && !defined(STAN_NO_HUGE_PAGES)
+  if (ptr && size >= HUGE_PAGE_NBYTES) {
+    // only a hint, failure leaves the block on regular pages
+    madvise(ptr, size, MADV_HUGEPAGE);
   }
-  return ptr;
+#endif
+  return static_cast<char*>(ptr);
+}
+
+/**
+ * Free a block allocated with `aligned_block_malloc()`.
+ *
+ * @param ptr pointer to the block
+ */
+inline void aligned_block_free(char* ptr) {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
 }
 }  // namespace internal
 
@@ -64,10 +111,21 @@ inline char* eight_byte_aligned_malloc(size_t size) {
  * recovered, with the blocks being reused, or all blocks may be
  * freed, resetting the stack of blocks to its original state.
  *
- * Alignment up to 8 byte boundaries guaranteed for the first malloc,
- * and after that it's up to the caller.  On 64-bit architectures,
- * all struct values should be padded to 8-byte boundaries if they
- * contain an 8-byte member or a virtual function.
+ * Every block starts on a cache line boundary and allocations are
+ * padded to 8 bytes, so all allocations are 8-byte aligned.  On 64-bit
+ * architectures, all struct values should be padded to 8-byte
+ * boundaries if they contain an 8-byte member or a virtual function.
+ * Arrays which are processed with SIMD instructions can be allocated
+ * with `alloc_aligned()` and `alloc_aligned_array()`, which align them
+ * to up to 64 bytes.
+ *
+ * By default all blocks are kept for reuse until `free_all()` is
+ * called.  `set_retention_policy()` lets `recover_all()` return blocks
+ * to the system, and `bytes_used()`, `bytes_reserved()`,
+ * `num_blocks()`, `high_water_mark()`, `nested_bytes_used()` and
+ * `nested_high_water_marks()` report how much memory is used.  Each
+ * thread has its own allocator in its `ChainableStack`, so the
+ * statistics and the policy are per thread.
  */
 class stack_alloc {
  private:
@@ -82,6 +140,97 @@ class stack_alloc {
   std::vector<size_t> nested_cur_blocks_;
   std::vector<char*> nested_next_locs_;
   std::vector<char*> nested_cur_block_ends_;
+  // high-water mark of bytes used as of the last change of block or
+  // recovery, overall and since the start of each nesting level
+  size_t high_water_mark_{0};
+  std::vector<size_t> nested_high_water_marks_;
+  // retention policy, see set_retention_policy()
+  size_t max_retained_bytes_{0};
+  size_t trim_after_{0};
+  // last block used since the retention policy last trimmed
+  size_t window_last_block_{0};
+  size_t window_recoveries_{0};
+
+  /**
+   * Return the offset of the specified location in the specified block
+   * from the start of the first block, counting all earlier blocks in
+   * full.
+   */
+  inline size_t offset(size_t block, const char* loc) const {
+    size_t sum = 0;
+    for (size_t i = 0; i < block; ++i) {
+      sum += sizes_[i];
+    }
+    return sum + (loc - blocks_[block]);
+  }
+
+  /**
+   * Free all blocks from the specified index on. The first block is
+   * never freed.
+   *
+   * @param first index of the first block to free
+   */
+  inline void free_blocks_from(size_t first) {
+    if (first < 1) {
+      first = 1;
+    }
+    for (size_t i = first; i < blocks_.size(); ++i) {
+      if (blocks_[i]) {
+        internal::aligned_block_free(blocks_[i]);
+      }
+    }
+    if (first < blocks_.size()) {
+      sizes_.resize(first);
+      blocks_.resize(first);
+    }
+  }
+
+  /**
+   * Raise the high-water marks of the allocator and of the innermost
+   * nesting level to the number of bytes currently used.
+   */
+  inline void update_high_water_marks() {
+    const size_t used = bytes_used();
+    if (used > high_water_mark_) {
+      high_water_mark_ = used;
+    }
+    if (!nested_high_water_marks_.empty()
+        && used > nested_high_water_marks_.back()) {
+      nested_high_water_marks_.back() = used;
+    }
+  }
+
+  /**
+   * Update the high-water marks and the last block used before memory is
+   * recovered.
+   */
+  inline void record_usage() {
+    update_high_water_marks();
+    if (cur_block_ > window_last_block_) {
+      window_last_block_ = cur_block_;
+    }
+  }
+
+  /**
+   * Apply the retention policy after all memory has been recovered.
+   */
+  inline void apply_retention_policy() {
+    if (trim_after_ > 0 && ++window_recoveries_ >= trim_after_) {
+      free_blocks_from(window_last_block_ + 1);
+      window_last_block_ = 0;
+      window_recoveries_ = 0;
+    }
+    if (max_retained_bytes_ > 0) {
+      size_t reserved = 0;
+      size_t keep = 0;
+      while (keep < blocks_.size()
+             && reserved + sizes_[keep] <= max_retained_bytes_) {
+        reserved += sizes_[keep];
+        ++keep;
+      }
+      free_blocks_from(keep);
+    }
+  }
 
   /**
    * Moves us to the next block of memory, allocating that block
@@ -105,7 +254,7 @@ class stack_alloc {
       if (newsize < len) {
         newsize = len;
       }
-      blocks_.push_back(internal::eight_byte_aligned_malloc(newsize));
+      blocks_.push_back(internal::aligned_block_malloc(newsize));
       if (!blocks_.back()) {
         throw std::bad_alloc();
       }
@@ -115,6 +264,7 @@ class stack_alloc {
     // Get the object's state back in order.
     next_loc_ = result + len;
     cur_block_end_ = result + sizes_[cur_block_];
+    update_high_water_marks();
     return result;
   }
 
@@ -125,11 +275,10 @@ class stack_alloc {
    *
    * @param initial_nbytes Initial number of bytes for the
    * allocator.  Defaults to <code>(1 << 16) = 64KB</code> initial bytes.
-   * @throws std::runtime_error if the underlying malloc is not 8-byte
-   * aligned.
+   * @throws std::bad_alloc if the initial block cannot be allocated.
    */
   explicit stack_alloc(size_t initial_nbytes = internal::DEFAULT_INITIAL_NBYTES)
-      : blocks_(1, internal::eight_byte_aligned_malloc(initial_nbytes)),
+      : blocks_(1, internal::aligned_block_malloc(initial_nbytes)),
         sizes_(1, initial_nbytes),
         cur_block_(0),
         cur_block_end_(blocks_[0] + initial_nbytes),
@@ -149,7 +298,7 @@ class stack_alloc {
     // free ALL blocks
     for (auto& block : blocks_) {
       if (block) {
-        free(block);
+        internal::aligned_block_free(block);
       }
     }
   }
@@ -181,6 +330,33 @@ class stack_alloc {
     return reinterpret_cast<void*>(result);
   }
 
+  /**
+   * Return a newly allocated block of memory of the appropriate
+   * size managed by the stack allocator, aligned to the specified
+   * number of bytes.
+   *
+   * The reserved space is padded in front to the alignment and
+   * at the end to the next multiple of 8.
+   *
+   * @param len Number of bytes to allocate.
+   * @param alignment Alignment in bytes. Must be a power of two no
+   * larger than 64.
+   * @return A pointer to the allocated memory.
+   */
+  inline void* alloc_aligned(size_t len, size_t alignment) {
+    size_t pad = len % 8 == 0 ? 0 : 8 - len % 8;
+
+    char* result = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(next_loc_) + alignment - 1)
+        & ~static_cast<uintptr_t>(alignment - 1));
+    next_loc_ = result + len + pad;
+    // blocks start on a cache line, so a new block is always aligned
+    if (unlikely(next_loc_ >= cur_block_end_)) {
+      result = move_to_next_block(len);
+    }
+    return reinterpret_cast<void*>(result);
+  }
+
   /**
    * Allocate an array on the arena of the specified size to hold
    * values of the specified template parameter type.
@@ -194,6 +370,29 @@ class stack_alloc {
     return static_cast<T*>(alloc(n * sizeof(T)));
   }
 
+  /**
+   * Allocate an array on the arena of the specified size to hold
+   * values of the specified template parameter type, aligned for SIMD
+   * loads and stores.
+   *
+   * Arrays of at least `STAN_ARENA_ALIGNMENT` bytes (64 by default) are
+   * aligned to `STAN_ARENA_ALIGNMENT` bytes. Smaller arrays are only
+   * 8-byte aligned, so that many small arrays do not waste space on
+   * padding.
+   *
+   * @tparam T type of entries in allocated array.
+   * @param[in] n size of array to allocate.
+   * @return new array allocated on the arena.
+   */
+  template <typename T>
+  inline T* alloc_aligned_array(size_t n) {
+    const size_t len = n * sizeof(T);
+    if (len < STAN_ARENA_ALIGNMENT) {
+      return static_cast<T*>(alloc(len));
+    }
+    return static_cast<T*>(alloc_aligned(len, STAN_ARENA_ALIGNMENT));
+  }
+
   /**
    * Recover all the memory used by the stack allocator.  The stack
    * of memory blocks allocated so far will be available for further
@@ -201,9 +400,13 @@ class stack_alloc {
    * function free_all().
    */
   inline void recover_all() {
+    record_usage();
     cur_block_ = 0;
     next_loc_ = blocks_[0];
     cur_block_end_ = next_loc_ + sizes_[0];
+    if (max_retained_bytes_ > 0 || trim_after_ > 0) {
+      apply_retention_policy();
+    }
   }
 
   /**
@@ -211,9 +414,11 @@ class stack_alloc {
    * recover back to start.
    */
   inline void start_nested() {
+    update_high_water_marks();
     nested_cur_blocks_.push_back(cur_block_);
     nested_next_locs_.push_back(next_loc_);
     nested_cur_block_ends_.push_back(cur_block_end_);
+    nested_high_water_marks_.push_back(bytes_used());
   }
 
   /**
@@ -223,6 +428,7 @@ class stack_alloc {
     if (unlikely(nested_cur_blocks_.empty())) {
       recover_all();
     }
+    record_usage();
 
     cur_block_ = nested_cur_blocks_.back();
     nested_cur_blocks_.pop_back();
@@ -232,6 +438,14 @@ class stack_alloc {
 
     cur_block_end_ = nested_cur_block_ends_.back();
     nested_cur_block_ends_.pop_back();
+
+    // the peak of the inner level counts for the enclosing level
+    const size_t inner_mark = nested_high_water_marks_.back();
+    nested_high_water_marks_.pop_back();
+    if (!nested_high_water_marks_.empty()
+        && inner_mark > nested_high_water_marks_.back()) {
+      nested_high_water_marks_.back() = inner_mark;
+    }
   }
 
   /**
@@ -240,15 +454,140 @@ class stack_alloc {
    * destructor will free all memory.
    */
   inline void free_all() {
-    // frees all BUT the first (index 0) block
-    for (size_t i = 1; i < blocks_.size(); ++i) {
-      if (blocks_[i]) {
-        free(blocks_[i]);
+    // frees all BUT the first (index 0) block, after the usage of the
+    // blocks has been recorded
+    recover_all();
+    free_blocks_from(1);
+  }
+
+  /**
+   * Write to every page of the blocks held, so that the system backs them
+   * with physical memory now. Under a first-touch policy, as used by
+   * Linux, the pages are then placed on the NUMA node of the calling
+   * thread. Pages touched before, for example by the heap, are not moved.
+   */
+  inline void touch_blocks() {
+    const size_t page_nbytes = 4096;
+    for (size_t i = 0; i < blocks_.size(); ++i) {
+      for (size_t j = 0; j < sizes_[i]; j += page_nbytes) {
+        static_cast<volatile char*>(blocks_[i])[j] = 0;
       }
     }
-    sizes_.resize(1);
-    blocks_.resize(1);
-    recover_all();
+  }
+
+  /**
+   * Set the policy for returning blocks to the system when all memory is
+   * recovered with `recover_all()`. By default all blocks are kept for
+   * reuse.
+   *
+   * @param max_retained_bytes If not zero, blocks are freed, last to
+   * first, until at most this many bytes are reserved. The first block is
+   * always kept.
+   * @param trim_after If not zero, every `trim_after` recoveries the blocks
+   * which were not used since the last trim are freed.
+   */
+  inline void set_retention_policy(size_t max_retained_bytes,
+                                   size_t trim_after) {
+    max_retained_bytes_ = max_retained_bytes;
+    trim_after_ = trim_after;
+    window_last_block_ = cur_block_;
+    window_recoveries_ = 0;
+  }
+
+  /**
+   * Return the number of bytes currently used, counting any space left
+   * free at the end of earlier blocks as used.
+   *
+   * @return number of bytes used
+   */
+  inline size_t bytes_used() const { return offset(cur_block_, next_loc_); }
+
+  /**
+   * Return the number of bytes held in blocks, used or not.
+   *
+   * @return number of bytes reserved
+   */
+  inline size_t bytes_reserved() const {
+    size_t sum = 0;
+    for (auto size : sizes_) {
+      sum += size;
+    }
+    return sum;
+  }
+
+  /**
+   * Return the number of blocks held.
+   *
+   * @return number of blocks
+   */
+  inline size_t num_blocks() const { return blocks_.size(); }
+
+  /**
+   * Return the largest number of bytes used since construction or the
+   * last call to `reset_high_water_mark()`. The mark is raised whenever
+   * an allocation moves to another block and before memory is recovered,
+   * so a peak is kept even if it is recovered before the mark is read.
+   *
+   * @return high-water mark in bytes
+   */
+  inline size_t high_water_mark() const {
+    const size_t used = bytes_used();
+    return used > high_water_mark_ ? used : high_water_mark_;
+  }
+
+  /**
+   * Reset the high-water marks of the allocator and of all nesting
+   * levels to the number of bytes currently used.
+   */
+  inline void reset_high_water_mark() {
+    high_water_mark_ = bytes_used();
+    for (auto& mark : nested_high_water_marks_) {
+      mark = high_water_mark_;
+    }
+  }
+
+  /**
+   * Return the number of bytes used by each nesting level, starting
+   * with the outermost level started by `start_nested()`. Bytes used by
+   * a deeper level are not counted for the enclosing levels.
+   *
+   * @return number of bytes used by each nesting level
+   */
+  inline std::vector<size_t> nested_bytes_used() const {
+    std::vector<size_t> used(nested_cur_blocks_.size());
+    const size_t end = bytes_used();
+    for (size_t i = 0; i < used.size(); ++i) {
+      const size_t begin
+          = offset(nested_cur_blocks_[i], nested_next_locs_[i]);
+      const size_t next
+          = i + 1 < used.size()
+                ? offset(nested_cur_blocks_[i + 1], nested_next_locs_[i + 1])
+                : end;
+      used[i] = next - begin;
+    }
+    return used;
+  }
+
+  /**
+   * Return the largest number of bytes used by each nesting level since
+   * it was started by `start_nested()` or since the last call to
+   * `reset_high_water_mark()`, starting with the outermost level. Unlike
+   * `nested_bytes_used()`, the bytes used by deeper levels, including
+   * levels which have been recovered, are counted for the enclosing
+   * levels.
+   *
+   * @return high-water mark in bytes of each nesting level
+   */
+  inline std::vector<size_t> nested_high_water_marks() const {
+    std::vector<size_t> marks(nested_cur_blocks_.size());
+    size_t mark = bytes_used();
+    for (size_t i = marks.size(); i-- > 0;) {
+      if (nested_high_water_marks_[i] > mark) {
+        mark = nested_high_water_marks_[i];
+      }
+      marks[i] = mark - offset(nested_cur_blocks_[i], nested_next_locs_[i]);
+    }
+    return marks;
   }
 
   /**
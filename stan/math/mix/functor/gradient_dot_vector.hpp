@@ -2,8 +2,10 @@
 #define STAN_MATH_MIX_FUNCTOR_GRADIENT_DOT_VECTOR_HPP
 
 #include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/gradient.hpp>
 #include <vector>
 
 namespace stan {
@@ -24,6 +26,41 @@ void gradient_dot_vector(const F& f,
   grad_fx_dot_v = fx_fvar.d_;
 }
 
+/**
+ * Calculate the value of the specified function at the specified
+ * argument, and the products of its gradient with each of the
+ * specified directions, with the operations recorded on the specified
+ * tape.
+ *
+ * <p>Instead of one <code>fvar</code> evaluation per direction, the
+ * gradient is computed once, see `gradient(static_tape&, ...)`, and
+ * multiplied with all directions at once. Later calls replay the
+ * recording for the new argument.
+ *
+ * @tparam F Type of function
+ * @param[in, out] tape Tape holding the recording of the function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[in] V Directions, one per column
+ * @param[out] fx Function applied to argument
+ * @param[out] grad_fx_dot_V Products of the gradient of the function at
+ * the argument with the directions
+ * @throw std::invalid_argument if the number of rows of `V` does not
+ * match the size of `x`
+ */
+template <typename F>
+void gradient_dot_vector(
+    static_tape& tape, const F& f,
+    const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+    const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& V,
+    double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx_dot_V) {
+  check_size_match("gradient_dot_vector", "rows of V", V.rows(), "size of x",
+                   x.size());
+  Eigen::Matrix<double, Eigen::Dynamic, 1> grad_fx;
+  gradient(tape, f, x, fx, grad_fx);
+  grad_fx_dot_V = V.transpose() * grad_fx;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -4,6 +4,7 @@
 #include <stan/math/fwd/core.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/rev/core.hpp>
+#include <algorithm>
 #include <stdexcept>
 
 namespace stan {
@@ -70,6 +71,144 @@ void hessian(const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
   }
 }
 
+/**
+ * Calculate the value, the gradient, and the Hessian,
+ * of the specified function at the specified argument, evaluating
+ * the function once per chunk of `N` inputs.
+ *
+ * <p>Each evaluation propagates `N` tangents as `fvar_n<var, N>`,
+ * so the values and their expression graph are built once per chunk
+ * instead of once per input.  One reverse pass per tangent then
+ * yields the rows of the Hessian.
+ *
+ * <p>The functor must implement
+ *
+ * <code>
+ * fvar_n\<var, N\>
+ * operator()(const
+ * Eigen::Matrix\<fvar_n\<var, N\>, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for
+ * <code>fvar_n</code> and <code>var</code>; see <code>fvar_n</code>
+ * for the operations it supports.
+ *
+ * @tparam N number of tangents propagated per evaluation
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument
+ */
+template <int N, typename F>
+void hessian(const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+             double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+             Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& H) {
+  H.resize(x.size(), x.size());
+  grad.resize(x.size());
+
+  // need to compute fx even with size = 0
+  if (x.size() == 0) {
+    fx = f(x);
+    return;
+  }
+  const int size = x.size();
+  for (int start = 0; start < size; start += N) {
+    const int lanes = std::min(N, size - start);
+    // Run nested autodiff in this scope
+    nested_rev_autodiff nested;
+
+    Eigen::Matrix<fvar_n<var, N>, Eigen::Dynamic, 1> x_fvar(size);
+    for (int j = 0; j < size; ++j) {
+      x_fvar(j) = fvar_n<var, N>(x(j));
+    }
+    for (int k = 0; k < lanes; ++k) {
+      x_fvar(start + k).d_.coeffRef(k) = 1;
+    }
+    fvar_n<var, N> fx_fvar = f(x_fvar);
+    if (start == 0) {
+      fx = fx_fvar.val_.val();
+    }
+    for (int k = 0; k < lanes; ++k) {
+      if (k > 0) {
+        nested.set_zero_all_adjoints();
+      }
+      grad(start + k) = fx_fvar.d_.coeff(k).val();
+      stan::math::grad(fx_fvar.d_.coeff(k).vi_);
+      for (int j = 0; j < size; ++j) {
+        H(start + k, j) = x_fvar(j).val_.adj();
+      }
+    }
+  }
+}
+
+/**
+ * Calculate the value, the gradient, and the Hessian of the specified
+ * function at the specified argument with one second order reverse sweep
+ * over the operations recorded on the specified tape.
+ *
+ * <p>The first call records the scalar operations of the function on the
+ * tape and computes the Hessian by edge pushing, see
+ * `static_tape::hessian()`. Instead of one `fvar<var>` evaluation and
+ * reverse pass per input, this takes one evaluation with `var`s and one
+ * sweep whose cost grows with the number of nonlinearly interacting
+ * pairs. Later calls replay the recording for the new argument. If the
+ * control flow of the function changed, the tape is recorded anew, see
+ * `gradient(static_tape&, ...)`.
+ *
+ * <p>If the function uses operations which cannot be recorded, or whose
+ * second derivatives are unknown, this behaves like
+ * <code>hessian(f, x, fx, grad, H)</code>.
+ *
+ * <p>The functor must be callable with both
+ * <code>Eigen::Matrix\<var, Eigen::Dynamic, 1\></code> and
+ * <code>Eigen::Matrix\<fvar\<var\>, Eigen::Dynamic, 1\></code>
+ * arguments, and the tape must only be used with one function.
+ *
+ * @tparam F Type of function
+ * @param[in, out] tape Tape holding the recording of the function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument
+ */
+template <typename F>
+void hessian(static_tape& tape, const F& f,
+             const Eigen::Matrix<double, Eigen::Dynamic, 1>& x, double& fx,
+             Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+             Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& H) {
+  if (tape.is_replayable() && tape.is_twice_differentiable()
+      && tape.replay_hessian(x, fx, grad, H)) {
+    return;
+  }
+  if (tape.is_recorded() && !tape.is_twice_differentiable()) {
+    hessian(f, x, fx, grad, H);
+    return;
+  }
+  {
+    nested_rev_autodiff nested;
+
+    Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+    tape.start_recording(x_var);
+    var fx_var;
+    try {
+      fx_var = f(x_var);
+    } catch (...) {
+      tape.clear();
+      throw;
+    }
+    tape.stop_recording(fx_var);
+    fx = fx_var.val();
+  }
+  if (tape.is_twice_differentiable()) {
+    tape.hessian(grad, H);
+    return;
+  }
+  hessian(f, x, fx, grad, H);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
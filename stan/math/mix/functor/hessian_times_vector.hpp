@@ -2,6 +2,8 @@
 #define STAN_MATH_MIX_FUNCTOR_HESSIAN_TIMES_VECTOR_HPP
 
 #include <stan/math/fwd/core.hpp>
+#include <stan/math/mix/functor/gradient_dot_vector.hpp>
+#include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/rev/core.hpp>
 #include <stdexcept>
@@ -47,6 +49,106 @@ void hessian_times_vector(const F& f,
   Hv = H * v;
 }
 
+/**
+ * Calculate the value of the specified function at the specified
+ * argument, and the products of its gradient and Hessian with each of
+ * the specified directions, with the operations recorded on the
+ * specified tape.
+ *
+ * <p>The first call records the scalar operations of the function on
+ * the tape. Instead of one <code>fvar\<var\></code> evaluation and
+ * reverse pass per direction, all directions then share the values and
+ * adjoints of one sweep, and `Lanes` directions at a time are carried
+ * through one tangent and one second order sweep over the recording,
+ * see `static_tape::hessian_times_vector()`. Later calls replay the
+ * recording for the new argument. If the control flow of the function
+ * changed, the tape is recorded anew, see `gradient(static_tape&,
+ * ...)`.
+ *
+ * <p>If the function uses operations which cannot be recorded, or whose
+ * second derivatives are unknown, each direction is handled by one
+ * <code>fvar\<var\></code> evaluation and reverse pass, as
+ * <code>hessian_times_vector(f, x, v, fx, Hv)</code> does.
+ *
+ * <p>The functor must be callable with both
+ * <code>Eigen::Matrix\<var, Eigen::Dynamic, 1\></code> and
+ * <code>Eigen::Matrix\<fvar\<var\>, Eigen::Dynamic, 1\></code>
+ * arguments, and the tape must only be used with one function.
+ *
+ * @tparam Lanes number of directions carried through one sweep
+ * @tparam F Type of function
+ * @param[in, out] tape Tape holding the recording of the function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[in] V Directions, one per column
+ * @param[out] fx Function applied to argument
+ * @param[out] grad_fx_dot_V Products of the gradient of the function at
+ * the argument with the directions
+ * @param[out] HV Products of the Hessian of the function at the argument
+ * with the directions, one column per direction
+ * @throw std::invalid_argument if the number of rows of `V` does not
+ * match the size of `x`
+ */
+template <int Lanes = 4, typename F>
+void hessian_times_vector(
+    static_tape& tape, const F& f,
+    const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+    const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& V,
+    double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx_dot_V,
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& HV) {
+  check_size_match("hessian_times_vector", "rows of V", V.rows(),
+                   "size of x", x.size());
+  if (tape.is_replayable() && tape.is_twice_differentiable()
+      && tape.replay_hessian_times_vector<Lanes>(x, V, fx, grad_fx_dot_V,
+                                                 HV)) {
+    return;
+  }
+  if (!tape.is_recorded() || tape.is_twice_differentiable()) {
+    {
+      nested_rev_autodiff nested;
+
+      Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+      tape.start_recording(x_var);
+      var fx_var;
+      try {
+        fx_var = f(x_var);
+      } catch (...) {
+        tape.clear();
+        throw;
+      }
+      tape.stop_recording(fx_var);
+      fx = fx_var.val();
+    }
+    if (tape.is_twice_differentiable()) {
+      tape.hessian_times_vector<Lanes>(V, grad_fx_dot_V, HV);
+      return;
+    }
+  }
+  grad_fx_dot_V.resize(V.cols());
+  HV.resize(x.size(), V.cols());
+  if (V.cols() == 0) {
+    // the loop over the directions below would not evaluate f
+    nested_rev_autodiff nested;
+    Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+    fx = f(x_var).val();
+    return;
+  }
+  for (Eigen::Index j = 0; j < V.cols(); ++j) {
+    nested_rev_autodiff nested;
+
+    Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+    var fx_var;
+    var grad_fx_var_dot_v;
+    gradient_dot_vector(f, x_var,
+                        Eigen::Matrix<double, Eigen::Dynamic, 1>(V.col(j)),
+                        fx_var, grad_fx_var_dot_v);
+    fx = fx_var.val();
+    grad_fx_dot_V.coeffRef(j) = grad_fx_var_dot_v.val();
+    grad(grad_fx_var_dot_v.vi_);
+    HV.col(j) = x_var.adj();
+  }
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -0,0 +1,156 @@
+#ifndef STAN_MATH_MIX_FUNCTOR_SPARSE_HESSIAN_HPP
+#define STAN_MATH_MIX_FUNCTOR_SPARSE_HESSIAN_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/column_coloring.hpp>
+#include <stan/math/rev/core.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Calculate the value, the gradient, and the Hessian with the
+ * specified sparsity pattern of the specified function at the
+ * specified argument.
+ *
+ * <p>The columns of the pattern are colored so that no two columns of
+ * the same color have a non-zero in the same row, see
+ * `column_coloring()`. One forward and reverse pass per color computes
+ * the product of the Hessian with the sum of the unit vectors of the
+ * columns of that color, from which all of their entries are
+ * recovered. The number of passes is thus the number of colors rather
+ * than the dimension.
+ *
+ * <p>The functor must implement
+ *
+ * <code>
+ * fvar\<var\>
+ * operator()(const
+ * Eigen::Matrix\<fvar\<var\>, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for
+ * <code>fvar</code> and <code>var</code>.
+ * Entries of the Hessian outside of the pattern are not computed and
+ * must be zero.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[in] pattern sparsity pattern of the Hessian, whose stored
+ * entries are the structural non-zeros
+ * @param[out] fx Function applied to argument
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument, with the sparsity
+ * pattern of `pattern`
+ * @throw std::invalid_argument if the pattern is not square with the
+ * size of the argument
+ */
+template <typename F>
+void sparse_hessian(const F& f,
+                    const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                    const Eigen::SparseMatrix<double>& pattern, double& fx,
+                    Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+                    Eigen::SparseMatrix<double>& H) {
+  check_size_match("sparse_hessian", "rows of pattern", pattern.rows(),
+                   "size of argument", x.size());
+  check_size_match("sparse_hessian", "columns of pattern", pattern.cols(),
+                   "size of argument", x.size());
+  H.resize(x.size(), x.size());
+  grad.resize(x.size());
+
+  // need to compute fx even with size = 0
+  if (x.size() == 0) {
+    fx = f(x);
+    return;
+  }
+  const std::vector<int> color = column_coloring(pattern);
+  const int num_colors = *std::max_element(color.begin(), color.end()) + 1;
+
+  std::vector<Eigen::Triplet<double>> entries;
+  entries.reserve(pattern.nonZeros());
+  for (int c = 0; c < num_colors; ++c) {
+    // Run nested autodiff in this scope
+    nested_rev_autodiff nested;
+
+    Eigen::Matrix<fvar<var>, Eigen::Dynamic, 1> x_fvar(x.size());
+    for (int j = 0; j < x.size(); ++j) {
+      x_fvar(j) = fvar<var>(x(j), color[j] == c);
+    }
+    fvar<var> fx_fvar = f(x_fvar);
+    if (c == 0) {
+      fx = fx_fvar.val_.val();
+      stan::math::grad(fx_fvar.val_.vi_);
+      for (int j = 0; j < x.size(); ++j) {
+        grad(j) = x_fvar(j).val_.adj();
+      }
+      nested.set_zero_all_adjoints();
+    }
+    stan::math::grad(fx_fvar.d_.vi_);
+    for (int j = 0; j < x.size(); ++j) {
+      if (color[j] != c) {
+        continue;
+      }
+      for (Eigen::SparseMatrix<double>::InnerIterator it(pattern, j); it;
+           ++it) {
+        entries.emplace_back(it.row(), j, x_fvar(it.row()).val_.adj());
+      }
+    }
+  }
+  H.setFromTriplets(entries.begin(), entries.end());
+}
+
+/**
+ * Calculate the value, the gradient, and the sparse Hessian of the
+ * specified function at the specified argument, detecting the sparsity
+ * pattern.
+ *
+ * <p>The function is first evaluated with <code>var</code> arguments
+ * while recording it on a `static_tape`, from which the sparsity
+ * pattern is determined, see `static_tape::hessian_sparsity()`. The
+ * Hessian is then computed as by
+ * `sparse_hessian(f, x, pattern, fx, grad, H)`. If the function uses
+ * operations which cannot be recorded, the pattern is taken to be
+ * dense.
+ *
+ * <p>The functor must be callable with both
+ * <code>Eigen::Matrix\<var, Eigen::Dynamic, 1\></code> and
+ * <code>Eigen::Matrix\<fvar\<var\>, Eigen::Dynamic, 1\></code>
+ * arguments.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument
+ */
+template <typename F>
+void sparse_hessian(const F& f,
+                    const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                    double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+                    Eigen::SparseMatrix<double>& H) {
+  Eigen::SparseMatrix<double> pattern;
+  {
+    nested_rev_autodiff nested;
+    Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+    static_tape tape;
+    tape.start_recording(x_var);
+    var fx_var = f(x_var);
+    tape.stop_recording(fx_var);
+    if (tape.is_complete()) {
+      pattern = tape.hessian_sparsity();
+    } else {
+      pattern = Eigen::MatrixXd::Ones(x.size(), x.size()).sparseView();
+    }
+  }
+  sparse_hessian(f, x, pattern, fx, grad, H);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,437 @@
+#ifndef STAN_MATH_OPENCL_ASYNC_COPY_HPP
+#define STAN_MATH_OPENCL_ASYNC_COPY_HPP
+#ifdef STAN_OPENCL
+
+#include <stan/math/opencl/copy.hpp>
+#include <stan/math/opencl/matrix_cl.hpp>
+#include <stan/math/opencl/matrix_cl_view.hpp>
+#include <stan/math/opencl/opencl_context.hpp>
+#include <stan/math/opencl/err/check_opencl.hpp>
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/size.hpp>
+#include <CL/opencl.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/** \ingroup opencl
+ * Result of an asynchronous copy of a `matrix_cl` to the host. The copy is
+ * enqueued on construction and only waited for on the first call to `get()`,
+ * so the host can enqueue more work for the device, or do its own work, while
+ * the data is transferred.
+ *
+ * The source matrix may be modified or destroyed after construction, as the
+ * copy is registered as a read event on it.
+ *
+ * @tparam T_ret Eigen matrix type of the result
+ */
+template <typename T_ret>
+class matrix_cl_readback {
+ public:
+  using Scalar = value_type_t<T_ret>;
+  using PlainObject = Eigen::Matrix<Scalar, T_ret::RowsAtCompileTime,
+                                    T_ret::ColsAtCompileTime>;
+
+ private:
+  // on the heap, so that its address does not change when this is moved
+  std::unique_ptr<PlainObject> dst_;
+  cl::Event event_;
+  matrix_cl_view view_;
+  bool ready_;
+
+ public:
+  /**
+   * Enqueues copying of the source matrix to the host.
+   * @tparam T type of the source matrix
+   * @param src source matrix on the OpenCL device
+   */
+  template <typename T, require_matrix_cl_t<T>* = nullptr,
+            require_st_same<T, T_ret>* = nullptr>
+  explicit matrix_cl_readback(const T& src)
+      : dst_(std::make_unique<PlainObject>(src.rows(), src.cols())),
+        view_(src.view()),
+        ready_(true) {
+    if (src.size() == 0) {
+      return;
+    }
+    if ((view_ == matrix_cl_view::Lower || view_ == matrix_cl_view::Upper)
+        && src.rows() == src.cols()) {
+      // triangular matrices are packed on the device first
+      *dst_ = from_matrix_cl<PlainObject>(src);
+      return;
+    }
+    try {
+      std::vector<cl::Event> copy_write_events(src.write_events().begin(),
+                                               src.write_events().end());
+      opencl_context.queue().enqueueReadBuffer(
+          src.buffer(), CL_FALSE, 0, sizeof(Scalar) * dst_->size(),
+          dst_->data(), &copy_write_events, &event_);
+      src.add_read_event(event_);
+      ready_ = false;
+    } catch (const cl::Error& e) {
+      check_opencl_error("matrix_cl_readback", e);
+    }
+  }
+
+  matrix_cl_readback(const matrix_cl_readback&) = delete;
+  matrix_cl_readback& operator=(const matrix_cl_readback&) = delete;
+
+  matrix_cl_readback(matrix_cl_readback&& other)
+      : dst_(std::move(other.dst_)),
+        event_(std::move(other.event_)),
+        view_(other.view_),
+        ready_(other.ready_) {
+    other.ready_ = true;
+  }
+
+  /**
+   * Waits for the copy to complete, as the device is writing into memory
+   * owned by \c this.
+   */
+  ~matrix_cl_readback() {
+    if (!ready_) {
+      event_.wait();
+    }
+  }
+
+  /**
+   * Checks whether the copy is complete without blocking.
+   * @return true if `get()` will not block
+   */
+  inline bool ready() const {
+    return ready_
+           || event_.getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>()
+                  == CL_COMPLETE;
+  }
+
+  /**
+   * Returns the copied matrix, waiting for the copy to complete if necessary.
+   * @return matrix on the host
+   */
+  inline const PlainObject& get() {
+    if (!ready_) {
+      try {
+        event_.wait();
+      } catch (const cl::Error& e) {
+        check_opencl_error("matrix_cl_readback.get", e);
+      }
+      ready_ = true;
+      if (!contains_nonzero(view_, matrix_cl_view::Lower)) {
+        dst_->template triangularView<Eigen::StrictlyLower>().setZero();
+      }
+      if (!contains_nonzero(view_, matrix_cl_view::Upper)) {
+        dst_->template triangularView<Eigen::StrictlyUpper>().setZero();
+      }
+    }
+    return *dst_;
+  }
+};
+
+/** \ingroup opencl
+ * Enqueues copying of the source matrix that is stored on the OpenCL device
+ * to the host and returns without waiting for the copy to complete. The
+ * result is available from `get()` of the returned object.
+ *
+ * @tparam T_ret destination Eigen type
+ * @tparam T type of the source matrix
+ * @param src source matrix on the OpenCL device
+ * @return pending copy of the data in the source matrix
+ */
+template <typename T_ret, typename T, require_eigen_t<T_ret>* = nullptr,
+          require_matrix_cl_t<T>* = nullptr>
+inline matrix_cl_readback<T_ret> from_matrix_cl_async(const T& src) {
+  return matrix_cl_readback<T_ret>(src);
+}
+
+/** \ingroup opencl
+ * Enqueues copying of the source matrix that is stored on the OpenCL device
+ * to a dynamically sized Eigen matrix on the host.
+ *
+ * @tparam T type of the source matrix
+ * @param src source matrix on the OpenCL device
+ * @return pending copy of the data in the source matrix
+ */
+template <typename T, require_matrix_cl_t<T>* = nullptr>
+inline auto from_matrix_cl_async(const T& src) {
+  return matrix_cl_readback<
+      Eigen::Matrix<value_type_t<T>, Eigen::Dynamic, Eigen::Dynamic>>(src);
+}
+
+namespace internal {
+/**
+ * Device copies of host matrices made by `to_matrix_cl_cached()`. Entries are
+ * keyed by the address and size of the host data and hold the version and
+ * checksum they were uploaded with. The cache holds at most `max_bytes_` bytes
+ * of device memory; when it holds more, the least recently used entries are
+ * released. The entry used last is always kept. The copies are shared with
+ * the callers, so a copy released by the cache, or replaced by a newer
+ * version, stays alive while a caller holds it.
+ * @tparam T scalar type
+ */
+template <typename T>
+struct matrix_cl_cache {
+  using key_t = std::tuple<const T*, Eigen::Index, Eigen::Index>;
+  struct entry {
+    std::size_t version;
+    std::size_t checksum;
+    std::shared_ptr<const matrix_cl<T>> data;
+    typename std::list<key_t>::iterator lru_pos;
+  };
+  std::mutex mutex_;
+  std::map<key_t, entry> entries_;
+  // keys from the most to the least recently used
+  std::list<key_t> lru_;
+  std::size_t bytes_{0};
+  std::size_t max_bytes_{std::size_t{1} << 30};
+
+  static matrix_cl_cache& instance() {
+    // initialize the context first, so that it outlives the cached matrices
+    static_cast<void>(opencl_context.context());
+    static matrix_cl_cache cache;
+    return cache;
+  }
+
+  static std::size_t bytes(const std::shared_ptr<const matrix_cl<T>>& m) {
+    return sizeof(T) * m->rows() * m->cols();
+  }
+
+  /**
+   * Releases the least recently used entries until at most `max_bytes_`
+   * bytes are cached, keeping the most recently used entry.
+   */
+  void evict() {
+    while (bytes_ > max_bytes_ && lru_.size() > 1) {
+      auto it = entries_.find(lru_.back());
+      bytes_ -= bytes(it->second.data);
+      entries_.erase(it);
+      lru_.pop_back();
+    }
+  }
+
+  void clear() {
+    entries_.clear();
+    lru_.clear();
+    bytes_ = 0;
+  }
+};
+
+/**
+ * Makes the key a host matrix is cached under by `to_matrix_cl_cached()`.
+ * @tparam T type of the Eigen matrix
+ * @param src host matrix
+ * @return key
+ */
+template <typename T, require_eigen_t<T>* = nullptr>
+inline auto matrix_cl_cache_key(const T& src) {
+  return std::make_tuple(src.data(), src.rows(), src.cols());
+}
+
+/**
+ * Makes the key a host `std::vector` is cached under by
+ * `to_matrix_cl_cached()`.
+ * @tparam T type of the vector
+ * @param src host vector
+ * @return key
+ */
+template <typename T, require_std_vector_t<T>* = nullptr>
+inline auto matrix_cl_cache_key(const T& src) {
+  return std::make_tuple(src.data(), static_cast<Eigen::Index>(src.size()),
+                         static_cast<Eigen::Index>(1));
+}
+
+/**
+ * Calculates two independent 64 bit hashes of the contents of a host matrix
+ * or vector. Blocks of the data are hashed in parallel and the hashes of
+ * blocks are combined in a fixed order, so the result does not depend on the
+ * number of threads.
+ * @tparam T type of the host matrix or vector
+ * @param src host matrix or vector
+ * @return pair of hashes
+ */
+template <typename T>
+inline std::pair<std::size_t, std::size_t> matrix_cl_content_hash(
+    const T& src) {
+  using T_val = value_type_t<T>;
+  using hash_t = std::pair<std::uint64_t, std::uint64_t>;
+  const unsigned char* bytes
+      = reinterpret_cast<const unsigned char*>(src.data());
+  const std::size_t n_bytes = sizeof(T_val) * math::size(src);
+  constexpr std::size_t word = sizeof(std::uint64_t);
+  const std::size_t n_words = n_bytes / word;
+  auto mix = [](hash_t h, std::uint64_t x) {
+    h.first ^= x + 0x9e3779b97f4a7c15ULL + (h.first << 6) + (h.first >> 2);
+    h.second ^= x + 0x6a09e667f3bcc909ULL + (h.second << 5) + (h.second >> 3);
+    return hash_t(h.first * 0xff51afd7ed558ccdULL,
+                  h.second * 0xc4ceb9fe1a85ec53ULL);
+  };
+  hash_t hash = tbb::parallel_deterministic_reduce(
+      tbb::blocked_range<std::size_t>(0, n_words, 1 << 14), hash_t(0, 0),
+      [&](const tbb::blocked_range<std::size_t>& r, hash_t h) {
+        for (std::size_t i = r.begin(); i < r.end(); i++) {
+          std::uint64_t x;
+          std::memcpy(&x, bytes + i * word, word);
+          h = mix(h, x);
+        }
+        return h;
+      },
+      [&](hash_t a, hash_t b) {
+        return mix(mix(a, b.first), b.second);
+      });
+  for (std::size_t i = n_words * word; i < n_bytes; i++) {
+    hash = mix(hash, bytes[i]);
+  }
+  hash = mix(hash, n_bytes);
+  return {static_cast<std::size_t>(hash.first),
+          static_cast<std::size_t>(hash.second)};
+}
+
+/**
+ * Returns the device copy of a host matrix cached under its address and
+ * size, uploading the matrix if there is no copy with the given version and
+ * checksum.
+ * @tparam T type of the host matrix or `std::vector`
+ * @param src host matrix
+ * @param version version of the data in `src`
+ * @param checksum second value the cached copy must match
+ * @return shared pointer to the matrix on the OpenCL device
+ */
+template <typename T>
+inline std::shared_ptr<const matrix_cl<value_type_t<T>>> to_matrix_cl_cached(
+    const T& src, std::size_t version, std::size_t checksum) {
+  using T_val = value_type_t<T>;
+  using cache_t = matrix_cl_cache<T_val>;
+  auto& cache = cache_t::instance();
+  std::lock_guard<std::mutex> cache_lock(cache.mutex_);
+  auto key = matrix_cl_cache_key(src);
+  auto it = cache.entries_.find(key);
+  if (it != cache.entries_.end()) {
+    cache.lru_.splice(cache.lru_.begin(), cache.lru_, it->second.lru_pos);
+    if (it->second.version == version && it->second.checksum == checksum) {
+      return it->second.data;
+    }
+  }
+  // the data is copied into a temporary, so that the upload does not block
+  plain_type_t<T> src_copy = src;
+  auto src_cl = std::make_shared<const matrix_cl<T_val>>(std::move(src_copy));
+  if (it != cache.entries_.end()) {
+    cache.bytes_ -= cache_t::bytes(it->second.data);
+    it->second.version = version;
+    it->second.checksum = checksum;
+    it->second.data = std::move(src_cl);
+  } else {
+    cache.lru_.push_front(key);
+    it = cache.entries_
+             .emplace(key, typename cache_t::entry{version, checksum,
+                                                   std::move(src_cl),
+                                                   cache.lru_.begin()})
+             .first;
+  }
+  cache.bytes_ += cache_t::bytes(it->second.data);
+  cache.evict();
+  return it->second.data;
+}
+}  // namespace internal
+
+/** \ingroup opencl
+ * Returns a copy of a host matrix on the OpenCL device, reusing the copy made
+ * by an earlier call with the same data and version. This avoids transfers of
+ * data that does not change between evaluations of a model.
+ *
+ * The caller is responsible for incrementing `version` whenever the data at
+ * `src.data()` is modified. A call with a different version replaces the
+ * cached device copy for later calls.
+ *
+ * The cached copies are bounded by `set_matrix_cl_cache_capacity()`; the
+ * least recently used ones are released by the cache when the bound is
+ * exceeded. The returned pointer shares ownership of the copy, so it stays
+ * valid after the copy is replaced or released by the cache, but the device
+ * memory is only freed once the pointer is gone.
+ *
+ * @tparam T type of the host matrix or `std::vector`, must be a plain matrix
+ * or a map
+ * @param src host matrix
+ * @param version version of the data in `src`
+ * @return shared pointer to the matrix on the OpenCL device
+ */
+template <typename T,
+          require_any_t<is_eigen<T>, is_std_vector<T>>* = nullptr,
+          require_vt_arithmetic<T>* = nullptr>
+inline std::shared_ptr<const matrix_cl<value_type_t<T>>> to_matrix_cl_cached(
+    const T& src, std::size_t version = 0) {
+  return internal::to_matrix_cl_cached(src, version, 0);
+}
+
+/** \ingroup opencl
+ * Returns a copy of host data on the OpenCL device, which is only uploaded
+ * again if the address, size or contents of the data changed since the last
+ * call. Hashing the contents is much cheaper than transferring them, so data
+ * arguments, such as the design matrix of a GLM, can be passed through this
+ * on every evaluation of a model:
+ *
+ * ```
+ * bernoulli_logit_glm_lpmf(*to_matrix_cl_resident(y),
+ *                          *to_matrix_cl_resident(x), alpha_cl, beta_cl);
+ * ```
+ *
+ * The contents are compared by two independent 64 bit hashes. The returned
+ * pointer shares ownership of the copy, see `to_matrix_cl_cached()`.
+ *
+ * @tparam T type of the host matrix or `std::vector`, must be a plain matrix
+ * or a map
+ * @param src host data
+ * @return shared pointer to the matrix on the OpenCL device
+ */
+template <typename T,
+          require_any_t<is_eigen<T>, is_std_vector<T>>* = nullptr,
+          require_vt_arithmetic<T>* = nullptr>
+inline std::shared_ptr<const matrix_cl<value_type_t<T>>> to_matrix_cl_resident(
+    const T& src) {
+  const auto hash = internal::matrix_cl_content_hash(src);
+  return internal::to_matrix_cl_cached(src, hash.first, hash.second);
+}
+
+/** \ingroup opencl
+ * Sets the number of bytes of device memory the copies made by
+ * `to_matrix_cl_cached()` and `to_matrix_cl_resident()` may use. The default
+ * is 1 GiB. The least recently used copies are released immediately if the
+ * cache holds more.
+ * @tparam T scalar type of the matrices
+ * @param max_bytes number of bytes
+ */
+template <typename T>
+inline void set_matrix_cl_cache_capacity(std::size_t max_bytes) {
+  auto& cache = internal::matrix_cl_cache<T>::instance();
+  std::lock_guard<std::mutex> cache_lock(cache.mutex_);
+  cache.max_bytes_ = max_bytes;
+  cache.evict();
+}
+
+/** \ingroup opencl
+ * Releases all device copies made by `to_matrix_cl_cached()` and
+ * `to_matrix_cl_resident()`.
+ * @tparam T scalar type of the matrices to release
+ */
+template <typename T>
+inline void clear_matrix_cl_cache() {
+  auto& cache = internal::matrix_cl_cache<T>::instance();
+  std::lock_guard<std::mutex> cache_lock(cache.mutex_);
+  cache.clear();
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
+#endif
@@ -5,6 +5,7 @@
 #include <stan/math/opencl/buffer_types.hpp>
 #include <stan/math/opencl/matrix_cl_view.hpp>
 #include <stan/math/opencl/opencl_context.hpp>
+#include <stan/math/opencl/program_cache.hpp>
 #include <stan/math/opencl/matrix_cl.hpp>
 #include <stan/math/opencl/stringify.hpp>
 #include <stan/math/opencl/err/check_opencl.hpp>
@@ -127,7 +128,9 @@ inline tbb::concurrent_vector<cl::Event> select_events(K& m) {
 }  // namespace internal
 
 /** \ingroup kernel_executor_opencl
- * Compile an OpenCL kernel.
+ * Compile an OpenCL kernel. If the environment variable
+ * `STAN_OPENCL_CACHE_DIR` is set, compiled programs are cached in that
+ * directory and reused by later processes using the same device and driver.
  *
  * @param name The name for the kernel
  * @param sources A std::vector of strings containing the code for the kernel.
@@ -147,9 +150,29 @@ inline auto compile_kernel(
     kernel_opts += std::string(" -D") + comp_opts.first + "="
                    + std::to_string(comp_opts.second);
   }
+  std::string cache_dir = internal::program_cache_dir();
+  std::string cache_key;
+  std::string cache_path;
+  if (!cache_dir.empty()) {
+    cache_key = internal::program_cache_key(sources, kernel_opts);
+    cache_path = internal::program_cache_path(cache_dir, cache_key);
+    cl::Program cached_program
+        = internal::load_cached_program(cache_path, cache_key);
+    if (cached_program() != nullptr) {
+      try {
+        cached_program.build({opencl_context.device()}, kernel_opts.c_str());
+        return cl::Kernel(cached_program, name);
+      } catch (const cl::Error& e) {
+        // stale or corrupted cache entry - compile from sources instead
+      }
+    }
+  }
   cl::Program program(opencl_context.context(), sources);
   try {
     program.build({opencl_context.device()}, kernel_opts.c_str());
+    if (!cache_path.empty()) {
+      internal::store_cached_program(cache_path, cache_key, program);
+    }
 
     return cl::Kernel(program, name);
   } catch (const cl::Error& e) {
@@ -85,6 +85,7 @@
 
 #include <stan/math/opencl/scalar_type.hpp>
 #include <stan/math/opencl/copy.hpp>
+#include <stan/math/opencl/async_copy.hpp>
 #include <stan/math/opencl/cholesky_decompose.hpp>
 #include <stan/math/opencl/is_constant.hpp>
 #include <stan/math/opencl/tri_inverse.hpp>
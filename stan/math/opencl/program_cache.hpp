@@ -0,0 +1,174 @@
+#ifndef STAN_MATH_OPENCL_PROGRAM_CACHE_HPP
+#define STAN_MATH_OPENCL_PROGRAM_CACHE_HPP
+#ifdef STAN_OPENCL
+
+#include <stan/math/opencl/opencl_context.hpp>
+#include <CL/opencl.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace opencl_kernels {
+namespace internal {
+
+/** \ingroup kernel_executor_opencl
+ * Returns the directory compiled OpenCL programs are cached in. It is set by
+ * the environment variable `STAN_OPENCL_CACHE_DIR`. If the variable is not
+ * set, programs are not cached.
+ * @return cache directory or an empty string if caching is disabled
+ */
+inline std::string program_cache_dir() {
+  const char* env_cache_dir = std::getenv("STAN_OPENCL_CACHE_DIR");
+  if (env_cache_dir == nullptr) {
+    return "";
+  }
+  return env_cache_dir;
+}
+
+/** \ingroup kernel_executor_opencl
+ * Calculates 64 bit FNV-1a hash of a string. Unlike `std::hash` its value
+ * does not depend on the standard library implementation, so it can be used
+ * in the names of cache files.
+ * @param s string to hash
+ * @return hash
+ */
+inline std::uint64_t program_cache_hash(const std::string& s) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : s) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/** \ingroup kernel_executor_opencl
+ * Makes the key a compiled program is cached under. It consists of the
+ * sources, build options and the platform, device and driver the program is
+ * compiled for.
+ * @param sources sources of the program
+ * @param options build options
+ * @return key
+ */
+inline std::string program_cache_key(const std::vector<std::string>& sources,
+                                     const std::string& options) {
+  const cl::Device& device = opencl_context.device()[0];
+  std::string key = opencl_context.platform()[0].getInfo<CL_PLATFORM_NAME>();
+  key += '\n' + device.getInfo<CL_DEVICE_NAME>();
+  key += '\n' + device.getInfo<CL_DEVICE_VERSION>();
+  key += '\n' + device.getInfo<CL_DRIVER_VERSION>();
+  key += '\n' + options;
+  for (const std::string& source : sources) {
+    key += '\n' + source;
+  }
+  return key;
+}
+
+/** \ingroup kernel_executor_opencl
+ * Returns the path of the file a program with given key is cached in.
+ * @param dir cache directory
+ * @param key key of the program
+ * @return path to the cache file
+ */
+inline std::string program_cache_path(const std::string& dir,
+                                      const std::string& key) {
+  char hash_str[17];
+  std::snprintf(hash_str, sizeof(hash_str), "%016llx",
+                static_cast<unsigned long long>(program_cache_hash(key)));
+  return dir + "/stan_opencl_" + hash_str + ".bin";
+}
+
+/** \ingroup kernel_executor_opencl
+ * Loads a compiled program from the cache. The cache file starts with the
+ * full key, so a hash collision or a file written for a different device is
+ * detected and treated as a cache miss. Returned program still needs to be
+ * built.
+ * @param path path to the cache file
+ * @param key key of the program
+ * @return the program or a null program if it is not in the cache
+ */
+inline cl::Program load_cached_program(const std::string& path,
+                                       const std::string& key) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return cl::Program();
+  }
+  std::uint64_t key_size = 0;
+  std::uint64_t binary_size = 0;
+  file.read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
+  if (!file || key_size != key.size()) {
+    return cl::Program();
+  }
+  std::string file_key(key_size, '\0');
+  file.read(&file_key[0], key_size);
+  file.read(reinterpret_cast<char*>(&binary_size), sizeof(binary_size));
+  if (!file || file_key != key || binary_size == 0) {
+    return cl::Program();
+  }
+  cl::Program::Binaries binaries(1, std::vector<unsigned char>(binary_size));
+  file.read(reinterpret_cast<char*>(binaries[0].data()), binary_size);
+  if (!file) {
+    return cl::Program();
+  }
+  try {
+    return cl::Program(opencl_context.context(), opencl_context.device(),
+                       binaries);
+  } catch (const cl::Error& e) {
+    return cl::Program();
+  }
+}
+
+/** \ingroup kernel_executor_opencl
+ * Stores a built program in the cache. The file is written under a temporary
+ * name and renamed, so concurrent processes never read a partially written
+ * file. Failures to write are ignored, as the cache is only an optimization.
+ * @param path path to the cache file
+ * @param key key of the program
+ * @param program built program
+ */
+inline void store_cached_program(const std::string& path,
+                                 const std::string& key,
+                                 const cl::Program& program) {
+  try {
+    std::vector<std::vector<unsigned char>> binaries
+        = program.getInfo<CL_PROGRAM_BINARIES>();
+    if (binaries.size() != 1 || binaries[0].empty()) {
+      return;
+    }
+    std::string tmp_path
+        = path + "." + std::to_string(std::random_device{}()) + ".tmp";
+    {
+      std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+      std::uint64_t key_size = key.size();
+      std::uint64_t binary_size = binaries[0].size();
+      file.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+      file.write(key.data(), key_size);
+      file.write(reinterpret_cast<const char*>(&binary_size),
+                 sizeof(binary_size));
+      file.write(reinterpret_cast<const char*>(binaries[0].data()),
+                 binary_size);
+      if (!file) {
+        file.close();
+        std::remove(tmp_path.c_str());
+        return;
+      }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      std::remove(tmp_path.c_str());
+    }
+  } catch (const cl::Error& e) {
+  }
+}
+
+}  // namespace internal
+}  // namespace opencl_kernels
+}  // namespace math
+}  // namespace stan
+
+#endif
+#endif
@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_PRIM_CORE_INIT_THREADPOOL_TBB_HPP
 #define STAN_MATH_PRIM_CORE_INIT_THREADPOOL_TBB_HPP
 
+#include <stan/math/prim/core/thread_affinity.hpp>
 #include <stan/math/prim/err/invalid_argument.hpp>
 
 #include <boost/lexical_cast.hpp>
@@ -16,12 +17,16 @@
 #ifdef TBB_INTERFACE_NEW
 #include <tbb/global_control.h>
 #include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
 #else
 #include <tbb/task_scheduler_init.h>
 #endif
 
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace stan {
 namespace math {
@@ -90,14 +95,22 @@ inline int get_num_threads() {
  * The function returns a reference to the static
  * tbb::global_control instance.
  *
- * @param n_threads The maximum number of threads available to the tbb. If not
- *  set will search for the environment variable `STAN_NUM_THREADS`. A value of
- *  -1 will assume all detectable threads are available for the process.
+ * The worker threads are placed on the CPUs as given by `affinity`; see
+ * thread_affinity. The affinity is set by the first call only, which also
+ * fills the AD tape pools with one tape per worker thread if reverse mode
+ * is included.
+ *
+ * @param n_threads The maximum number of threads available to the tbb. A
+ *  value of zero will search for the environment variable `STAN_NUM_THREADS`.
+ *  A value of -1 will assume all detectable threads are available for the
+ *  process.
+ * @param affinity placement of the worker threads
  * @return reference to the static tbb::global_control
- * @throws std::runtime_error if n_threads (defaults to zero) is not provided
- * and the value of STAN_NUM_THREADS environment variable is invalid.
+ * @throws std::runtime_error if n_threads is zero and the value of
+ * STAN_NUM_THREADS environment variable is invalid.
  */
-inline tbb::task_arena& init_threadpool_tbb(int n_threads = 0) {
+inline tbb::task_arena& init_threadpool_tbb(int n_threads,
+                                            thread_affinity affinity) {
   int tbb_max_threads = 1;
 #ifdef STAN_THREADS
   if (n_threads == 0) {
@@ -112,6 +125,14 @@ inline tbb::task_arena& init_threadpool_tbb(int n_threads = 0) {
                      "' but it must be positive or -1");
   }
 #endif
+  static std::once_flag is_initialized;
+  std::call_once(is_initialized, [&] {
+    // set before any worker thread starts
+    internal::tbb_thread_affinity() = affinity;
+    if (internal::threadpool_init_callback() != nullptr) {
+      internal::threadpool_init_callback()(tbb_max_threads);
+    }
+  });
   static tbb::global_control tbb_gc(
       tbb::global_control::max_allowed_parallelism, tbb_max_threads);
   static tbb::task_arena tbb_arena(tbb_max_threads, 1);
@@ -119,6 +140,168 @@ inline tbb::task_arena& init_threadpool_tbb(int n_threads = 0) {
 
   return tbb_arena;
 }
+
+/**
+ * Initialize the Intel TBB threadpool and global scheduler through
+ * the tbb::task_arena object. The placement of the worker threads is read
+ * from the environment variable STAN_THREAD_AFFINITY using
+ * internal::get_thread_affinity. See init_threadpool_tbb(int,
+ * thread_affinity) for details.
+ *
+ * @param n_threads The maximum number of threads available to the tbb. If not
+ *  set will search for the environment variable `STAN_NUM_THREADS`. A value of
+ *  -1 will assume all detectable threads are available for the process.
+ * @return reference to the static tbb::global_control
+ * @throws std::runtime_error if n_threads (defaults to zero) is not provided
+ * and the value of STAN_NUM_THREADS environment variable is invalid, or if
+ * the value of STAN_THREAD_AFFINITY is invalid.
+ */
+inline tbb::task_arena& init_threadpool_tbb(int n_threads = 0) {
+  return init_threadpool_tbb(n_threads, internal::get_thread_affinity());
+}
+
+namespace internal {
+
+/**
+ * TBB observer of the arena of one NUMA node, which pins the worker threads
+ * entering the arena to the CPUs of the node. A worker thread which moves
+ * to the node calls `numa_node_change_callback()`, such that its AD tape
+ * can follow it. When the worker leaves the arena, the placement it had
+ * before is restored, such that workers returning to the other arenas keep
+ * the placement given by `tbb_thread_affinity()`.
+ */
+class numa_node_observer final : public tbb::task_scheduler_observer {
+ public:
+  numa_node_observer(tbb::task_arena& arena, int node)
+      : tbb::task_scheduler_observer(arena), node_(node) {
+    observe(true);
+  }
+
+  ~numa_node_observer() { observe(false); }
+
+  void on_scheduler_entry(bool worker) {
+    if (!worker || thread_numa_node() == node_) {
+      return;
+    }
+    const thread_placement placement = current_thread_placement();
+    if (pin_current_thread(numa_node_cpus()[node_])) {
+      saved_placement() = placement;
+      is_moved() = true;
+      thread_numa_node() = node_;
+      if (numa_node_change_callback() != nullptr) {
+        numa_node_change_callback()();
+      }
+    }
+  }
+
+  void on_scheduler_exit(bool worker) {
+    if (!worker || !is_moved()) {
+      return;
+    }
+    is_moved() = false;
+    restore_thread_placement(saved_placement());
+    if (numa_node_change_callback() != nullptr) {
+      numa_node_change_callback()();
+    }
+  }
+
+ private:
+  int node_;
+
+  /**
+   * Return the placement the calling worker thread had before it was moved
+   * to a node arena. A worker is in one arena at a time, so this is shared
+   * by the observers of all nodes.
+   */
+  static thread_placement& saved_placement() {
+    static thread_local thread_placement placement;
+    return placement;
+  }
+
+  /**
+   * Return true if the calling worker thread was moved by a node arena and
+   * its placement is still to be restored.
+   */
+  static bool& is_moved() {
+    static thread_local bool moved = false;
+    return moved;
+  }
+};
+
+/**
+ * Task arena of one NUMA node together with the observer pinning its
+ * worker threads.
+ */
+struct numa_node_arena {
+  tbb::task_arena arena_;
+  std::unique_ptr<numa_node_observer> observer_;
+
+  numa_node_arena(int node, int max_concurrency) : arena_(max_concurrency, 1) {
+    arena_.initialize();
+    observer_ = std::make_unique<numa_node_observer>(arena_, node);
+  }
+};
+
+/**
+ * Return the arenas of all NUMA nodes. The arenas are created on the first
+ * call. Each node gets a share of the threads of the TBB threadpool in
+ * proportion to its number of CPUs, but at least one thread.
+ *
+ * @return arenas of the nodes
+ */
+inline std::vector<std::unique_ptr<numa_node_arena>>& numa_node_arenas() {
+  static std::vector<std::unique_ptr<numa_node_arena>> arenas = [] {
+    const int max_threads = init_threadpool_tbb().max_concurrency();
+    const std::vector<std::vector<int>>& nodes = numa_node_cpus();
+    std::size_t num_cpus = 0;
+    for (const auto& node_cpus : nodes) {
+      num_cpus += node_cpus.size();
+    }
+    std::vector<std::unique_ptr<numa_node_arena>> node_arenas;
+    for (std::size_t node = 0; node < nodes.size(); ++node) {
+      const int node_threads = std::max<int>(
+          1, (max_threads * nodes[node].size() + num_cpus / 2) / num_cpus);
+      node_arenas.push_back(
+          std::make_unique<numa_node_arena>(node, node_threads));
+    }
+    return node_arenas;
+  }();
+  return arenas;
+}
+
+}  // namespace internal
+
+/**
+ * Return the number of NUMA nodes the process may run on. This is one if
+ * the topology of the machine is not available.
+ *
+ * @return number of nodes
+ */
+inline std::size_t num_numa_nodes() {
+  return internal::numa_node_cpus().size();
+}
+
+/**
+ * Return the task arena of a NUMA node. Work submitted with `execute()` to
+ * the arena runs on worker threads pinned to the CPUs of the node, such that
+ * their AD tapes and the memory they touch first are local to the node. The
+ * arenas of all nodes are created on the first call and share the threads
+ * of the TBB threadpool, which is initialized with `init_threadpool_tbb()`
+ * if needed.
+ *
+ * @param node index of the node, less than `num_numa_nodes()`
+ * @return reference to the arena of the node
+ * @throws std::invalid_argument if the node does not exist
+ */
+inline tbb::task_arena& numa_arena(std::size_t node) {
+  std::vector<std::unique_ptr<internal::numa_node_arena>>& arenas
+      = internal::numa_node_arenas();
+  if (node >= arenas.size()) {
+    invalid_argument("numa_arena", "node", node, "The NUMA node is ",
+                     ", but it must be less than the number of nodes");
+  }
+  return arenas[node]->arena_;
+}
 #else
 /**
  * Initialize the Intel TBB threadpool and global scheduler through
@@ -135,14 +318,22 @@ inline tbb::task_arena& init_threadpool_tbb(int n_threads = 0) {
  * The function returns a reference to the static
  * tbb::task_scheduler_init instance.
  *
- * @param n_threads The maximum number of threads available to the tbb. If not
- *  set will search for the environment variable `STAN_NUM_THREADS`. A value of
- *  will assume all detectable threads are available for the process.
+ * The worker threads are placed on the CPUs as given by `affinity`; see
+ * thread_affinity. The affinity is set by the first call only, which also
+ * fills the AD tape pools with one tape per worker thread if reverse mode
+ * is included.
+ *
+ * @param n_threads The maximum number of threads available to the tbb. A
+ *  value of zero will search for the environment variable `STAN_NUM_THREADS`.
+ *  A value of -1 will assume all detectable threads are available for the
+ *  process.
+ * @param affinity placement of the worker threads
  * @return reference to the static tbb::task_scheduler_init
- * @throws std::runtime_error if n_threads (defaults to zero) is not provided
- * and the value of STAN_NUM_THREADS environment variable is invalid.
+ * @throws std::runtime_error if n_threads is zero and the value of
+ * STAN_NUM_THREADS environment variable is invalid.
  */
-inline tbb::task_scheduler_init& init_threadpool_tbb(int n_threads = 0) {
+inline tbb::task_scheduler_init& init_threadpool_tbb(int n_threads,
+                                                     thread_affinity affinity) {
   int tbb_max_threads = 1;
 #ifdef STAN_THREADS
   if (n_threads == 0) {
@@ -157,9 +348,36 @@ inline tbb::task_scheduler_init& init_threadpool_tbb(int n_threads = 0) {
                      "' but it must be positive or -1");
   }
 #endif
+  static std::once_flag is_initialized;
+  std::call_once(is_initialized, [&] {
+    // set before any worker thread starts
+    internal::tbb_thread_affinity() = affinity;
+    if (internal::threadpool_init_callback() != nullptr) {
+      internal::threadpool_init_callback()(tbb_max_threads);
+    }
+  });
   static tbb::task_scheduler_init tbb_scheduler(tbb_max_threads, 0);
   return tbb_scheduler;
 }
+
+/**
+ * Initialize the Intel TBB threadpool and global scheduler through
+ * the tbb::task_scheduler_init object. The placement of the worker threads
+ * is read from the environment variable STAN_THREAD_AFFINITY using
+ * internal::get_thread_affinity. See init_threadpool_tbb(int,
+ * thread_affinity) for details.
+ *
+ * @param n_threads The maximum number of threads available to the tbb. If not
+ *  set will search for the environment variable `STAN_NUM_THREADS`. A value of
+ *  will assume all detectable threads are available for the process.
+ * @return reference to the static tbb::task_scheduler_init
+ * @throws std::runtime_error if n_threads (defaults to zero) is not provided
+ * and the value of STAN_NUM_THREADS environment variable is invalid, or if
+ * the value of STAN_THREAD_AFFINITY is invalid.
+ */
+inline tbb::task_scheduler_init& init_threadpool_tbb(int n_threads = 0) {
+  return init_threadpool_tbb(n_threads, internal::get_thread_affinity());
+}
 #endif
 
 }  // namespace math
@@ -0,0 +1,334 @@
+#ifndef STAN_MATH_PRIM_CORE_THREAD_AFFINITY_HPP
+#define STAN_MATH_PRIM_CORE_THREAD_AFFINITY_HPP
+
+#include <stan/math/prim/err/invalid_argument.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Placement of the TBB worker threads on the CPUs of the machine.
+ *
+ * - `none`: worker threads are not pinned; the operating system places
+ *   them.
+ * - `numa_node`: worker threads are distributed round robin over the NUMA
+ *   nodes and pinned to all CPUs of their node.
+ * - `core`: worker threads are distributed round robin over the NUMA nodes
+ *   and pinned to a single CPU of their node.
+ *
+ * Pinned worker threads allocate their AD tape on their own node.
+ */
+enum class thread_affinity { none, numa_node, core };
+
+namespace internal {
+
+/**
+ * Parse a list of CPUs or NUMA nodes in the format used by Linux, such as
+ * `0-3,8,10-11`.
+ *
+ * @param list list of numbers and ranges separated by commas
+ * @return numbers contained in the list
+ * @throws std::invalid_argument if the list is malformed
+ */
+inline std::vector<int> parse_cpu_list(const std::string& list) {
+  std::vector<int> ids;
+  std::stringstream list_stream(list);
+  std::string range;
+  while (std::getline(list_stream, range, ',')) {
+    if (range.find_first_not_of(" \t\n") == std::string::npos) {
+      continue;
+    }
+    const std::size_t dash = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last = dash == std::string::npos
+                           ? first
+                           : std::stoi(range.substr(dash + 1));
+      if (first < 0 || last < first) {
+        throw std::out_of_range(range);
+      }
+      for (int id = first; id <= last; ++id) {
+        ids.push_back(id);
+      }
+    } catch (const std::logic_error&) {
+      invalid_argument("parse_cpu_list", "list", list, "The CPU list is '",
+                       "' but it must be numbers or ranges separated by ','");
+    }
+  }
+  return ids;
+}
+
+/**
+ * Return the CPUs this process may run on.
+ *
+ * @return CPU ids
+ */
+inline std::vector<int> available_cpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    const int num_cpus = std::max(1U, std::thread::hardware_concurrency());
+    for (int cpu = 0; cpu < num_cpus; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+/**
+ * Return the CPUs of each NUMA node which this process may run on. The
+ * topology is read once from `/sys/devices/system/node` on Linux. Nodes
+ * without available CPUs are left out. If the topology is not available,
+ * all CPUs are returned as a single node.
+ *
+ * @return CPU ids of each node
+ */
+inline const std::vector<std::vector<int>>& numa_node_cpus() {
+  static const std::vector<std::vector<int>> node_cpus = [] {
+    const std::vector<int> cpus = available_cpus();
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    const std::string node_dir = "/sys/devices/system/node/";
+    std::ifstream online_file(node_dir + "online");
+    std::string online;
+    if (std::getline(online_file, online)) {
+      try {
+        for (int node : parse_cpu_list(online)) {
+          std::ifstream cpulist_file(node_dir + "node" + std::to_string(node)
+                                     + "/cpulist");
+          std::string cpulist;
+          std::getline(cpulist_file, cpulist);
+          std::vector<int> cpus_of_node;
+          for (int cpu : parse_cpu_list(cpulist)) {
+            if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) {
+              cpus_of_node.push_back(cpu);
+            }
+          }
+          if (!cpus_of_node.empty()) {
+            nodes.push_back(cpus_of_node);
+          }
+        }
+      } catch (const std::invalid_argument&) {
+        nodes.clear();
+      }
+    }
+#endif
+    if (nodes.empty()) {
+      nodes.push_back(cpus);
+    }
+    return nodes;
+  }();
+  return node_cpus;
+}
+
+/**
+ * Return the affinity of the TBB worker threads, which is set once by
+ * `init_threadpool_tbb()`.
+ *
+ * @return reference to the affinity
+ */
+inline thread_affinity& tbb_thread_affinity() {
+  static thread_affinity affinity = thread_affinity::none;
+  return affinity;
+}
+
+/**
+ * Get the affinity of the TBB worker threads from the environment
+ * variable STAN_THREAD_AFFINITY, which must be one of `none`, `numa` or
+ * `core`. If it is not defined, or threading is not enabled, the worker
+ * threads are not pinned.
+ *
+ * @return affinity of the worker threads
+ * @throws std::invalid_argument if the value of STAN_THREAD_AFFINITY is
+ * invalid
+ */
+inline thread_affinity get_thread_affinity() {
+#ifdef STAN_THREADS
+  const char* env_affinity = std::getenv("STAN_THREAD_AFFINITY");
+  if (env_affinity != nullptr) {
+    const std::string affinity(env_affinity);
+    if (affinity == "numa") {
+      return thread_affinity::numa_node;
+    } else if (affinity == "core") {
+      return thread_affinity::core;
+    } else if (affinity != "none") {
+      invalid_argument("get_thread_affinity()", "STAN_THREAD_AFFINITY",
+                       env_affinity,
+                       "The STAN_THREAD_AFFINITY environment variable is '",
+                       "' but it must be none, numa or core");
+    }
+  }
+#endif
+  return thread_affinity::none;
+}
+
+/**
+ * Return the NUMA node the calling thread is pinned to. The node is an
+ * index into `numa_node_cpus()`.
+ *
+ * @return reference to the node of the thread, -1 if it is not pinned
+ */
+inline int& thread_numa_node() {
+  static thread_local int node = -1;
+  return node;
+}
+
+/**
+ * Return the CPUs a worker thread is pinned to. The workers are assigned
+ * round robin to the nodes and, with `thread_affinity::core`, round robin
+ * to the CPUs within their node.
+ *
+ * @param worker index of the worker thread in the order of pinning
+ * @param affinity affinity of the worker threads, not `none`
+ * @param nodes CPUs of each node
+ * @return CPUs of the worker
+ */
+inline std::vector<int> worker_cpus(
+    std::size_t worker, thread_affinity affinity,
+    const std::vector<std::vector<int>>& nodes) {
+  const std::vector<int>& node_cpus = nodes[worker % nodes.size()];
+  if (affinity == thread_affinity::core) {
+    return {node_cpus[(worker / nodes.size()) % node_cpus.size()]};
+  }
+  return node_cpus;
+}
+
+/**
+ * Pin the calling thread to the given CPUs. This is only supported on
+ * Linux and does nothing on other systems.
+ *
+ * @param cpus CPU ids
+ * @return true if the thread was pinned
+ */
+inline bool pin_current_thread(const std::vector<int>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)
+         == 0;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Placement of a thread on the CPUs of the machine: the CPUs it may run on
+ * and the NUMA node it is pinned to.
+ */
+struct thread_placement {
+#ifdef __linux__
+  cpu_set_t cpus_;
+#endif
+  int node_;
+};
+
+/**
+ * Return the placement of the calling thread.
+ *
+ * @return CPUs and NUMA node of the thread
+ */
+inline thread_placement current_thread_placement() {
+  thread_placement placement;
+#ifdef __linux__
+  CPU_ZERO(&placement.cpus_);
+  pthread_getaffinity_np(pthread_self(), sizeof(placement.cpus_),
+                         &placement.cpus_);
+#endif
+  placement.node_ = thread_numa_node();
+  return placement;
+}
+
+/**
+ * Restore a placement of the calling thread returned by
+ * `current_thread_placement()`.
+ *
+ * @param placement CPUs and NUMA node of the thread
+ */
+inline void restore_thread_placement(const thread_placement& placement) {
+#ifdef __linux__
+  pthread_setaffinity_np(pthread_self(), sizeof(placement.cpus_),
+                         &placement.cpus_);
+#endif
+  thread_numa_node() = placement.node_;
+}
+
+/**
+ * Pin the calling worker thread according to `tbb_thread_affinity()`, if
+ * the thread is not pinned yet. The thread is assigned to the next node in
+ * round robin order.
+ *
+ * @return true if the thread was pinned by this call
+ */
+inline bool pin_worker_thread() {
+  const thread_affinity affinity = tbb_thread_affinity();
+  if (affinity == thread_affinity::none || thread_numa_node() >= 0) {
+    return false;
+  }
+  static std::atomic<std::size_t> num_workers{0};
+  const std::vector<std::vector<int>>& nodes = numa_node_cpus();
+  const std::size_t worker = num_workers++;
+  if (!pin_current_thread(worker_cpus(worker, affinity, nodes))) {
+    return false;
+  }
+  thread_numa_node() = worker % nodes.size();
+  return true;
+}
+
+/**
+ * Return the function called by a worker thread after it moved to another
+ * NUMA node, which is set by the AD tape observer to move the thread's AD
+ * tape to the new node.
+ *
+ * @return reference to the function, `nullptr` if none is set
+ */
+inline void (*&numa_node_change_callback())() {
+  static void (*callback)() = nullptr;
+  return callback;
+}
+
+/**
+ * Return the function called by the first call to `init_threadpool_tbb()`
+ * with the maximum number of threads, which is set by the AD tape observer
+ * to fill the AD tape pools with one tape per worker thread.
+ *
+ * @return reference to the function, `nullptr` if none is set
+ */
+inline void (*&threadpool_init_callback())(int) {
+  static void (*callback)(int) = nullptr;
+  return callback;
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+
+#endif
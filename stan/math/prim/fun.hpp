@@ -46,6 +46,7 @@
 #include <stan/math/prim/fun/choose.hpp>
 #include <stan/math/prim/fun/col.hpp>
 #include <stan/math/prim/fun/cols.hpp>
+#include <stan/math/prim/fun/column_coloring.hpp>
 #include <stan/math/prim/fun/columns_dot_product.hpp>
 #include <stan/math/prim/fun/columns_dot_self.hpp>
 #include <stan/math/prim/fun/complex_schur_decompose.hpp>
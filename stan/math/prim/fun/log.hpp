@@ -47,7 +47,8 @@ template <
     typename Container,
     require_not_container_st<std::is_arithmetic, Container>* = nullptr,
     require_not_var_matrix_t<Container>* = nullptr,
-    require_not_nonscalar_prim_or_rev_kernel_expression_t<Container>* = nullptr>
+    require_not_nonscalar_prim_or_rev_kernel_expression_t<Container>* = nullptr,
+    require_not_fused_expression_t<Container>* = nullptr>
 inline auto log(const Container& x) {
   return apply_scalar_unary<log_fun, Container>::apply(x);
 }
@@ -78,7 +78,8 @@ struct log1p_fun {
  */
 template <typename T,
           require_not_nonscalar_prim_or_rev_kernel_expression_t<T>* = nullptr,
-          require_not_var_matrix_t<T>* = nullptr>
+          require_not_var_matrix_t<T>* = nullptr,
+          require_not_fused_expression_t<T>* = nullptr>
 inline auto log1p(const T& x) {
   return apply_scalar_unary<log1p_fun, T>::apply(x);
 }
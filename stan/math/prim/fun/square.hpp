@@ -50,7 +50,8 @@ template <
     typename Container, require_not_stan_scalar_t<Container>* = nullptr,
     require_not_container_st<std::is_arithmetic, Container>* = nullptr,
     require_not_var_matrix_t<Container>* = nullptr,
-    require_not_nonscalar_prim_or_rev_kernel_expression_t<Container>* = nullptr>
+    require_not_nonscalar_prim_or_rev_kernel_expression_t<Container>* = nullptr,
+    require_not_fused_expression_t<Container>* = nullptr>
 inline auto square(const Container& x) {
   return apply_scalar_unary<square_fun, Container>::apply(x);
 }
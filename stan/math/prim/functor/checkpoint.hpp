@@ -0,0 +1,58 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_CHECKPOINT_HPP
+#define STAN_MATH_PRIM_FUNCTOR_CHECKPOINT_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/err/check_positive.hpp>
+#include <utility>
+
+namespace stan {
+namespace math {
+
+/**
+ * Call the specified function on the specified arguments. Checkpointing only
+ * changes how reverse mode autodiff stores the expression graph, so if none
+ * of the arguments contain `var`s this is the same as `f(args...)`.
+ *
+ * @tparam F type of function
+ * @tparam Args types of arguments
+ * @param f function
+ * @param args arguments
+ * @return `f(args...)`
+ */
+template <typename F, typename... Args,
+          require_all_not_st_var<Args...>* = nullptr>
+inline auto checkpoint(const F& f, const Args&... args) {
+  return f(args...);
+}
+
+/**
+ * Apply the specified step function `n` times, starting from the state `y0`:
+ * `y_{i + 1} = step(i, y_i, args...)` for `i` in `0, ..., n - 1`. If none of
+ * the arguments contain `var`s this is a plain loop.
+ *
+ * @tparam F type of step function
+ * @tparam T type of initial state
+ * @tparam Args types of additional arguments
+ * @param step step function
+ * @param n number of steps
+ * @param y0 initial state
+ * @param args additional arguments passed to every step
+ * @return state after the last step
+ * @throw std::domain_error if `n` is not positive
+ */
+template <typename F, typename T, typename... Args,
+          require_all_not_st_var<T, Args...>* = nullptr>
+inline auto checkpoint_loop(const F& step, int n, const T& y0,
+                            const Args&... args) {
+  check_positive("checkpoint_loop", "number of steps", n);
+  plain_type_t<decltype(step(0, y0, args...))> y = step(0, y0, args...);
+  for (int i = 1; i < n; ++i) {
+    y = step(i, y, args...);
+  }
+  return y;
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
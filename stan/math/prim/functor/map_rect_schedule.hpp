@@ -0,0 +1,197 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_MAP_RECT_SCHEDULE_HPP
+#define STAN_MATH_PRIM_FUNCTOR_MAP_RECT_SCHEDULE_HPP
+
+#include <stan/math/prim/err/check_nonnegative.hpp>
+#include <stan/math/prim/err/check_positive.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Schedule and timing statistics of the jobs of one `map_rect` call site
+ * when it is run with threads.
+ *
+ * Jobs are started in the order of decreasing expected cost and handed out
+ * to the threads in chunks of `chunk_size()` jobs, so that a thread that
+ * finishes early takes the next chunk. Starting the most expensive jobs first
+ * keeps a few straggler jobs from determining the run time. The expected cost
+ * of a job is its cost hint, if hints were set, and otherwise its run time in
+ * the previous call. Without either, the jobs are started in their order.
+ *
+ * The run times of all jobs are recorded for every call. The schedule only
+ * changes the order in which jobs are run, so the results of `map_rect` do
+ * not depend on it.
+ *
+ * All member functions are thread safe.
+ */
+class map_rect_schedule {
+  mutable std::mutex mutex_;
+  std::vector<double> cost_hints_;
+  std::vector<double> last_job_seconds_;
+  std::vector<double> total_job_seconds_;
+  std::vector<double> max_job_seconds_;
+  std::size_t num_calls_{0};
+  int chunk_size_{1};
+
+ public:
+  /**
+   * Sets the relative costs of the jobs. Only the order of the costs
+   * matters. The hints are ignored for calls with a different number of
+   * jobs.
+   * @param cost_hints relative cost of each job
+   * @throw std::domain_error if a cost is negative or NaN
+   */
+  inline void set_cost_hints(const std::vector<double>& cost_hints) {
+    check_nonnegative("map_rect_schedule", "cost hints", cost_hints);
+    std::lock_guard<std::mutex> lock(mutex_);
+    cost_hints_ = cost_hints;
+  }
+
+  /**
+   * Removes the cost hints, so that jobs are ordered by their last run time.
+   */
+  inline void clear_cost_hints() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cost_hints_.clear();
+  }
+
+  /**
+   * Returns the cost hints, which are empty if none were set.
+   */
+  inline std::vector<double> cost_hints() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cost_hints_;
+  }
+
+  /**
+   * Sets the number of jobs handed out to a thread at once.
+   * @param chunk_size number of jobs
+   * @throw std::domain_error if `chunk_size` is not positive
+   */
+  inline void set_chunk_size(int chunk_size) {
+    check_positive("map_rect_schedule", "chunk size", chunk_size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    chunk_size_ = chunk_size;
+  }
+
+  /**
+   * Returns the number of jobs handed out to a thread at once.
+   */
+  inline int chunk_size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunk_size_;
+  }
+
+  /**
+   * Returns the order in which the jobs of a call are started.
+   * @param num_jobs number of jobs of the call
+   * @return job indices sorted by decreasing expected cost
+   */
+  inline std::vector<std::size_t> job_order(std::size_t num_jobs) const {
+    std::vector<std::size_t> order(num_jobs);
+    std::iota(order.begin(), order.end(), 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::vector<double>& costs
+        = cost_hints_.size() == num_jobs ? cost_hints_ : last_job_seconds_;
+    if (costs.size() == num_jobs) {
+      std::stable_sort(order.begin(), order.end(),
+                       [&costs](std::size_t i, std::size_t j) {
+                         return costs[i] > costs[j];
+                       });
+    }
+    return order;
+  }
+
+  /**
+   * Records the run times of the jobs of a call. Calls with a different
+   * number of jobs than the previous ones reset the statistics.
+   * @param job_seconds run time of each job
+   */
+  inline void record(const std::vector<double>& job_seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (job_seconds.size() != total_job_seconds_.size()) {
+      total_job_seconds_.assign(job_seconds.size(), 0.0);
+      max_job_seconds_.assign(job_seconds.size(), 0.0);
+      num_calls_ = 0;
+    }
+    last_job_seconds_ = job_seconds;
+    for (std::size_t i = 0; i < job_seconds.size(); ++i) {
+      total_job_seconds_[i] += job_seconds[i];
+      max_job_seconds_[i] = std::max(max_job_seconds_[i], job_seconds[i]);
+    }
+    ++num_calls_;
+  }
+
+  /**
+   * Returns the number of calls recorded since the statistics were reset.
+   */
+  inline std::size_t num_calls() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_calls_;
+  }
+
+  /**
+   * Returns the run time in seconds of each job in the last call.
+   */
+  inline std::vector<double> last_job_seconds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_job_seconds_;
+  }
+
+  /**
+   * Returns the mean run time in seconds of each job over the recorded calls.
+   */
+  inline std::vector<double> mean_job_seconds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<double> mean(total_job_seconds_);
+    for (double& x : mean) {
+      x /= num_calls_;
+    }
+    return mean;
+  }
+
+  /**
+   * Returns the longest run time in seconds of each job over the recorded
+   * calls.
+   */
+  inline std::vector<double> max_job_seconds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_job_seconds_;
+  }
+
+  /**
+   * Forgets all recorded run times. Cost hints and the chunk size are kept.
+   */
+  inline void reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_job_seconds_.clear();
+    total_job_seconds_.clear();
+    max_job_seconds_.clear();
+    num_calls_ = 0;
+  }
+};
+
+/**
+ * Returns the schedule used by threaded `map_rect` calls with the given
+ * `call_id` and function.
+ *
+ * @tparam call_id label of the `map_rect` call site
+ * @tparam F type of the mapped function
+ * @return schedule
+ */
+template <int call_id, typename F>
+inline map_rect_schedule& get_map_rect_schedule() {
+  static map_rect_schedule schedule;
+  return schedule;
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
@@ -9,8 +9,13 @@
 #include <stan/math/prim/fun/to_array_1d.hpp>
 #include <stan/math/prim/fun/dims.hpp>
 
+#include <boost/mpi/exception.hpp>
+
 #include <mutex>
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
 #include <vector>
 #include <type_traits>
 #include <functional>
@@ -112,19 +117,26 @@ bool mpi_parallel_call_cache<call_id, member, T>::is_valid_ = false;
  * 4. The root then broadcasts and scatters all necessary data to the
  *    cluster. Static data (including meta information on data shapes)
  *    are locally cached such that static data is only transferred on
- *    the first evaluation. Note that the work is equally distributed
+ *    the first evaluation. The parameters are sent with non-blocking
+ *    collectives. Shared parameters are only sent if they changed
+ *    since the last call, and as pairs of index and value if only few
+ *    of them changed. Note that the work is equally distributed
  *    among the workers. That is N jobs are distributed ot a cluster
  *    of size W in N/W chunks (the remainder is allocated to node 1
  *    onwards which ensures that the root node 0 has one job less).
  * 5. Once the parameters and static data is distributed, the reduce
- *    operation is applied per defined job. Each job is allowed to
- *    return a different number of outputs such that the resulting
- *    data structure is a ragged array. The ragged array structure
- *    becomes known to mpi_parallel_call during the first evaluation
- *    and must not change for future calls.
+ *    operation is applied per defined job. The root computes its jobs
+ *    while the parameters are still being sent to the workers, and
+ *    each worker starts as soon as it received its parameters. Each
+ *    job is allowed to return a different number of outputs such that
+ *    the resulting data structure is a ragged array. The ragged array
+ *    structure becomes known to mpi_parallel_call during the first
+ *    evaluation and must not change for future calls.
  * 6. Finally the local results are gathered on the root node over MPI
  *    and given on the root node to the combine functor along
- *    with the ragged array data structure.
+ *    with the ragged array data structure. The results and the status
+ *    of all workers are collected with non-blocking collectives which
+ *    are in flight at the same time.
  *
  * The MPI cluster resource is acquired with construction of
  * mpi_parallel_call and is freed once the mpi_parallel_call goes out
@@ -183,9 +195,22 @@ class mpi_parallel_call {
 
   CombineF combine_;
 
-  vector_d local_shared_params_dbl_;
+  // shared parameters of the last call, which are only sent to the
+  // workers when they change
+  static vector_d shared_params_dbl_;
+
   matrix_d local_job_params_dbl_;
 
+  // buffers of the non-blocking distribution of the parameters, which
+  // must stay alive until all requests completed
+  std::vector<MPI_Request> requests_;
+  int num_changed_shared_params_ = 0;
+  std::vector<int> changed_shared_params_index_;
+  vector_d changed_shared_params_;
+  matrix_d job_params_dbl_;
+  std::vector<int> job_params_counts_;
+  std::vector<int> job_params_displs_;
+
  public:
   /**
    * Initiates a parallel MPI call on the root. The constructor
@@ -233,12 +258,12 @@ class mpi_parallel_call {
     const size_type num_job_params = num_jobs == 0 ? 0 : job_dims[1];
 
     const vector_d shared_params_dbl = value_of(shared_params);
-    matrix_d job_params_dbl(num_job_params, num_jobs);
+    job_params_dbl_.resize(num_job_params, num_jobs);
 
     for (int j = 0; j < num_jobs; ++j)
-      job_params_dbl.col(j) = value_of(job_params[j]);
+      job_params_dbl_.col(j) = value_of(job_params[j]);
 
-    setup_call(shared_params_dbl, job_params_dbl, x_r, x_i);
+    setup_call(shared_params_dbl, job_params_dbl_, x_r, x_i);
   }
 
   // called on remote sites
@@ -250,6 +275,13 @@ class mpi_parallel_call {
                std::vector<std::vector<int>>());
   }
 
+  ~mpi_parallel_call() {
+    // the buffers of pending requests must outlive them
+    if (!requests_.empty()) {
+      MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+    }
+  }
+
   /**
    * Entry point on the workers for the mpi_parallel_call.
    */
@@ -295,8 +327,9 @@ class mpi_parallel_call {
     try {
       for (int i = 0, offset = 0; i < num_local_jobs;
            offset += local_f_out[i], ++i) {
+        test_distribution();
         const matrix_d job_output
-            = ReduceF()(local_shared_params_dbl_, local_job_params_dbl_.col(i),
+            = ReduceF()(shared_params_dbl_, local_job_params_dbl_.col(i),
                         local_x_r[i], local_x_i[i], 0);
         local_f_out[i] = job_output.cols();
 
@@ -321,6 +354,10 @@ class mpi_parallel_call {
       local_ok = 0;
     }
 
+    // the root computed its jobs while its parameters were still being
+    // sent to the workers
+    wait_distribution();
+
     // during first execution we distribute the output sizes from
     // local jobs to the root. This needs to be done for the number of
     // outputs of each result and the number of outputs per job.
@@ -383,13 +420,25 @@ class mpi_parallel_call {
       for (int j = 0; j != job_chunks[i]; ++j, ++k)
         chunks_result[i] += world_f_out[k] * num_outputs_per_job_;
 
-    // collect results on root
-    boost::mpi::gatherv(world_, local_output.data(), chunks_result[rank_],
-                        world_result.data(), chunks_result, 0);
+    std::vector<int> displs_result(world_size_, 0);
+    std::partial_sum(chunks_result.begin(), chunks_result.end() - 1,
+                     displs_result.begin() + 1);
 
-    // let root know if all went fine everywhere
+    // collect results on root and let root know if all went fine
+    // everywhere, with both operations in flight at the same time
     int cluster_status = 0;
-    boost::mpi::reduce(world_, local_ok, cluster_status, std::plus<int>(), 0);
+    std::array<MPI_Request, 2> result_requests;
+    BOOST_MPI_CHECK_RESULT(
+        MPI_Igatherv,
+        (local_output.data(), chunks_result[rank_], MPI_DOUBLE,
+         world_result.data(), chunks_result.data(), displs_result.data(),
+         MPI_DOUBLE, 0, world_, &result_requests[0]));
+    BOOST_MPI_CHECK_RESULT(MPI_Ireduce,
+                           (&local_ok, &cluster_status, 1, MPI_INT, MPI_SUM,
+                            0, world_, &result_requests[1]));
+    BOOST_MPI_CHECK_RESULT(
+        MPI_Waitall,
+        (result_requests.size(), result_requests.data(), MPI_STATUSES_IGNORE));
     bool all_ok = cluster_status == static_cast<int>(world_size_);
 
     // on the workers all is done now.
@@ -498,49 +547,123 @@ class mpi_parallel_call {
   }
 
   /**
-   * Broadcasts an Eigen vector to the cluster. Meta
-   * information as the data shape is treated as static data and only
-   * transferred on the first call and read from cache
-   * subsequently. This static shape data is stored with the
-   * meta_cache_id label.
+   * Starts the non-blocking broadcast of the shared parameters. Only the
+   * shared parameters which changed since the last call are sent, as
+   * pairs of index and value if few of them changed. The number of
+   * changed parameters is broadcasted first and the workers wait for it
+   * to receive the changes. Meta information as the number of shared
+   * parameters is treated as static data and only transferred on the
+   * first call.
    *
-   * @tparam meta_cache_id item label for static shape data
-   * @param data vector to be broadcasted from the root and a dummy
+   * @param shared_params shared parameters on the root and a dummy
    * argument on workers
-   * @return broadcasted vector originating from the root
    */
-  template <int meta_cache_id>
-  vector_d broadcast_vector(const vector_d& data) {
+  void broadcast_shared_params(const vector_d& shared_params) {
     using meta_cache
-        = internal::mpi_parallel_call_cache<call_id, meta_cache_id,
+        = internal::mpi_parallel_call_cache<call_id, -1,
                                             std::vector<size_type>>;
-    const std::vector<size_type>& data_size
-        = broadcast_array_1d_cached<meta_cache>({data.size()});
+    const size_type num_shared_params
+        = broadcast_array_1d_cached<meta_cache>({shared_params.size()})[0];
+
+    if (rank_ == 0) {
+      const bool known = shared_params_dbl_.size() == num_shared_params;
+      changed_shared_params_index_.clear();
+      for (size_type i = 0; i < num_shared_params; ++i) {
+        // compare the bits, so that a change of sign of zero is sent
+        if (!known
+            || std::memcmp(shared_params.data() + i,
+                           shared_params_dbl_.data() + i, sizeof(double))
+                   != 0) {
+          changed_shared_params_index_.push_back(i);
+        }
+      }
+      num_changed_shared_params_ = changed_shared_params_index_.size();
+      shared_params_dbl_ = shared_params;
+    }
 
-    vector_d local_data = data;
-    local_data.resize(data_size[0]);
+    requests_.emplace_back();
+    BOOST_MPI_CHECK_RESULT(MPI_Ibcast, (&num_changed_shared_params_, 1,
+                                        MPI_INT, 0, world_, &requests_.back()));
+    if (rank_ != 0) {
+      wait_distribution();
+    }
+
+    const int num_changed = num_changed_shared_params_;
+    if (num_changed == 0) {
+      return;
+    }
+
+    if (!send_changes_only(num_changed, num_shared_params)) {
+      // the workers receive all shared parameters in place
+      shared_params_dbl_.resize(num_shared_params);
+      requests_.emplace_back();
+      BOOST_MPI_CHECK_RESULT(
+          MPI_Ibcast, (shared_params_dbl_.data(), num_shared_params,
+                       MPI_DOUBLE, 0, world_, &requests_.back()));
+      return;
+    }
+
+    changed_shared_params_index_.resize(num_changed);
+    changed_shared_params_.resize(num_changed);
+    if (rank_ == 0) {
+      for (int i = 0; i < num_changed; ++i) {
+        changed_shared_params_(i)
+            = shared_params(changed_shared_params_index_[i]);
+      }
+    }
+    requests_.emplace_back();
+    BOOST_MPI_CHECK_RESULT(
+        MPI_Ibcast, (changed_shared_params_index_.data(), num_changed,
+                     MPI_INT, 0, world_, &requests_.back()));
+    requests_.emplace_back();
+    BOOST_MPI_CHECK_RESULT(
+        MPI_Ibcast, (changed_shared_params_.data(), num_changed, MPI_DOUBLE,
+                     0, world_, &requests_.back()));
+  }
 
-    boost::mpi::broadcast(world_, local_data.data(), data_size[0], 0);
+  /**
+   * Applies the received changes of the shared parameters on the
+   * workers once the broadcast completed.
+   */
+  void update_shared_params() {
+    const int num_changed = num_changed_shared_params_;
+    if (num_changed == 0
+        || !send_changes_only(num_changed, shared_params_dbl_.size())) {
+      return;
+    }
+    for (int i = 0; i < num_changed; ++i) {
+      shared_params_dbl_(changed_shared_params_index_[i])
+          = changed_shared_params_(i);
+    }
+  }
 
-    return local_data;
+  /**
+   * Returns true if pairs of index and value of the changed shared
+   * parameters are sent rather than all shared parameters, which is the
+   * case whenever this is less data.
+   *
+   * @param num_changed number of changed shared parameters
+   * @param num_shared_params number of shared parameters
+   */
+  static bool send_changes_only(int num_changed, size_type num_shared_params) {
+    const std::size_t changes_size = static_cast<std::size_t>(num_changed)
+                                     * (sizeof(int) + sizeof(double));
+    return changes_size
+           < static_cast<std::size_t>(num_shared_params) * sizeof(double);
   }
 
   /**
-   * Scatters an Eigen matrix column wise over the cluster. Meta
-   * information as the data shape is treated as static data and only
-   * transferred on the first call and read from cache
-   * subsequently. This static shape data is stored with the
-   * meta_cache_id label.
+   * Starts the non-blocking scatter of an Eigen matrix column wise over
+   * the cluster. Meta information as the data shape is treated as
+   * static data and only transferred on the first call and read from
+   * cache subsequently. The root keeps its chunk in place.
    *
-   * @tparam meta_cache_id item label for static shape data
-   * @param data matrix to be scattered column-wise and a dummy
-   * argument on workers.
-   * @return matrix chunk for a given worker.
+   * @param data matrix to be scattered column-wise, which must stay
+   * alive until the scatter completed, and a dummy argument on workers.
    */
-  template <int meta_cache_id>
-  matrix_d scatter_matrix(const matrix_d& data) {
+  void scatter_job_params(const matrix_d& data) {
     using meta_cache
-        = internal::mpi_parallel_call_cache<call_id, meta_cache_id,
+        = internal::mpi_parallel_call_cache<call_id, -2,
                                             std::vector<size_type>>;
     const std::vector<size_type>& dims
         = broadcast_array_1d_cached<meta_cache>({data.rows(), data.cols()});
@@ -548,18 +671,56 @@ class mpi_parallel_call {
     const size_type total_cols = dims[1];
 
     const std::vector<int> job_chunks = mpi_map_chunks(total_cols, 1);
-    const std::vector<int> data_chunks = mpi_map_chunks(total_cols, rows);
-    matrix_d local_data(rows, job_chunks[rank_]);
+    job_params_counts_ = mpi_map_chunks(total_cols, rows);
+    job_params_displs_.assign(world_size_, 0);
+    std::partial_sum(job_params_counts_.begin(), job_params_counts_.end() - 1,
+                     job_params_displs_.begin() + 1);
+
+    if (rank_ == 0) {
+      local_job_params_dbl_ = data.leftCols(job_chunks[0]);
+    } else {
+      local_job_params_dbl_.resize(rows, job_chunks[rank_]);
+    }
+
     if (rows * total_cols > 0) {
-      if (rank_ == 0) {
-        boost::mpi::scatterv(world_, data.data(), data_chunks,
-                             local_data.data(), 0);
-      } else {
-        boost::mpi::scatterv(world_, local_data.data(), data_chunks[rank_], 0);
+      requests_.emplace_back();
+      BOOST_MPI_CHECK_RESULT(
+          MPI_Iscatterv,
+          (data.data(), job_params_counts_.data(), job_params_displs_.data(),
+           MPI_DOUBLE,
+           rank_ == 0 ? MPI_IN_PLACE : local_job_params_dbl_.data(),
+           job_params_counts_[rank_], MPI_DOUBLE, 0, world_,
+           &requests_.back()));
+    }
+  }
+
+  /**
+   * Drives the non-blocking distribution of the parameters without
+   * waiting for it. Without an asynchronous progress thread, MPI only
+   * moves large messages while the root is inside an MPI call, so the
+   * root calls this between its jobs to let the workers start early.
+   */
+  void test_distribution() {
+    if (!requests_.empty()) {
+      int done = 0;
+      BOOST_MPI_CHECK_RESULT(MPI_Testall, (requests_.size(), requests_.data(),
+                                           &done, MPI_STATUSES_IGNORE));
+      if (done) {
+        requests_.clear();
       }
     }
+  }
 
-    return local_data;
+  /**
+   * Waits for the non-blocking distribution of the parameters to
+   * complete.
+   */
+  void wait_distribution() {
+    if (!requests_.empty()) {
+      BOOST_MPI_CHECK_RESULT(MPI_Waitall, (requests_.size(), requests_.data(),
+                                           MPI_STATUSES_IGNORE));
+      requests_.clear();
+    }
   }
 
   void setup_call(const vector_d& shared_params, const matrix_d& job_params,
@@ -568,18 +729,28 @@ class mpi_parallel_call {
     std::vector<int> job_chunks = mpi_map_chunks(job_params.cols(), 1);
     broadcast_array_1d_cached<cache_chunks>(job_chunks);
 
-    local_shared_params_dbl_ = broadcast_vector<-1>(shared_params);
-    local_job_params_dbl_ = scatter_matrix<-2>(job_params);
-
     // distribute const data if not yet cached
     scatter_array_2d_cached<cache_x_r>(x_r);
     scatter_array_2d_cached<cache_x_i>(x_i);
+
+    broadcast_shared_params(shared_params);
+    scatter_job_params(job_params);
+
+    // the workers need their parameters to start, while the root only
+    // waits once it computed its own jobs
+    if (rank_ != 0) {
+      wait_distribution();
+      update_shared_params();
+    }
   }
 };
 
 template <int call_id, typename ReduceF, typename CombineF>
 int mpi_parallel_call<call_id, ReduceF, CombineF>::num_outputs_per_job_ = -1;
 
+template <int call_id, typename ReduceF, typename CombineF>
+vector_d mpi_parallel_call<call_id, ReduceF, CombineF>::shared_params_dbl_;
+
 }  // namespace math
 }  // namespace stan
 
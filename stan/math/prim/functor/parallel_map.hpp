@@ -0,0 +1,143 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_PARALLEL_MAP_HPP
+#define STAN_MATH_PRIM_FUNCTOR_PARALLEL_MAP_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/err.hpp>
+
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+
+template <typename MapFunction, typename Enable, typename ReturnType,
+          typename Vec, typename... Args>
+struct parallel_map_impl;
+
+/**
+ * Type of the result of `MapFunction` for one element of the sliced argument
+ *
+ * @tparam MapFunction Type of map function
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ */
+template <typename MapFunction, typename Vec, typename... Args>
+using parallel_map_result_t = plain_type_t<decltype(MapFunction()(
+    std::declval<const value_type_t<Vec>&>(), std::size_t{0},
+    std::declval<std::ostream*>(), std::declval<const Args&>()...))>;
+
+/**
+ * Specialization of parallel_map_impl for arithmetic types
+ *
+ * @tparam MapFunction Type of map function
+ * @tparam ReturnType An arithmetic type
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ */
+template <typename MapFunction, typename ReturnType, typename Vec,
+          typename... Args>
+struct parallel_map_impl<MapFunction, require_arithmetic_t<ReturnType>,
+                         ReturnType, Vec, Args...> {
+  using result_t = parallel_map_result_t<MapFunction, Vec, Args...>;
+
+  /**
+   * Call an instance of the function `MapFunction` on every element of an
+   *   input sequence and return the results.
+   *
+   * This specialization is parallelized using tbb and works only for
+   *   arithmetic types. The messages written by `MapFunction` are passed on
+   *   in the order of the elements.
+   *
+   * @param vmapped Vector containing one element per result
+   * @param grainsize Grainsize for tbb
+   * @param[in, out] msgs The print stream for warning messages
+   * @param args Shared arguments used in every call
+   * @return Results for all elements of `vmapped`
+   */
+  inline std::vector<result_t> operator()(Vec&& vmapped, int grainsize,
+                                          std::ostream* msgs,
+                                          Args&&... args) const {
+    const std::size_t num_elements = vmapped.size();
+    std::vector<result_t> results(num_elements);
+    std::vector<std::stringstream> local_msgs(num_elements);
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, num_elements, grainsize),
+        [&](const tbb::blocked_range<std::size_t>& r) {
+          for (std::size_t i = r.begin(); i < r.end(); ++i) {
+            results[i] = MapFunction()(vmapped[i], i, &local_msgs[i], args...);
+          }
+        });
+    if (msgs) {
+      for (std::size_t i = 0; i < num_elements; ++i) {
+        *msgs << local_msgs[i].str();
+      }
+    }
+    return results;
+  }
+};
+
+}  // namespace internal
+
+/**
+ * Call an instance of the function `MapFunction` on every element of an input
+ *   sequence and return the results in a `std::vector`.
+ *
+ * This defers to parallel_map_impl for the appropriate implementation
+ *
+ * MapFunction must define an operator() with the same signature as:
+ *   R f(const T& vmapped_element, std::size_t i, std::ostream* msgs,
+ * Args&&... args)
+ *
+ * where `T` is the element type of `Vec` and `i` is the (zero based) index of
+ *   the element. The result `R` can be a scalar, an Eigen type or a
+ *   `std::vector` of those and its size can be different for every element.
+ *
+ * `MapFunction` must be default constructible without any arguments
+ *
+ * grainsize must be greater than or equal to 1
+ *
+ * If STAN_THREADS is not defined, the elements are mapped one after another.
+ *
+ * @tparam MapFunction Type of map function
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ * @param vmapped Vector containing one element per result
+ * @param grainsize Grainsize for tbb
+ * @param[in, out] msgs The print stream for warning messages
+ * @param args Shared arguments used in every call
+ * @return Results for all elements of `vmapped`
+ */
+template <typename MapFunction, typename Vec,
+          typename = require_vector_like_t<Vec>, typename... Args>
+inline auto parallel_map(Vec&& vmapped, int grainsize, std::ostream* msgs,
+                         Args&&... args) {
+  check_positive("parallel_map", "grainsize", grainsize);
+
+#ifdef STAN_THREADS
+  using return_type = return_type_t<Vec, Args...>;
+  return internal::parallel_map_impl<MapFunction, void, return_type, Vec,
+                                     ref_type_t<Args&&>...>()(
+      std::forward<Vec>(vmapped), grainsize, msgs,
+      std::forward<Args>(args)...);
+#else
+  std::vector<internal::parallel_map_result_t<MapFunction, Vec, Args...>>
+      results;
+  results.reserve(vmapped.size());
+  for (std::size_t i = 0; i < vmapped.size(); ++i) {
+    results.emplace_back(MapFunction()(vmapped[i], i, msgs, args...));
+  }
+  return results;
+#endif
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
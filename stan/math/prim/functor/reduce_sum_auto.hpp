@@ -0,0 +1,283 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_REDUCE_SUM_AUTO_HPP
+#define STAN_MATH_PRIM_FUNCTOR_REDUCE_SUM_AUTO_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/functor/reduce_sum.hpp>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+
+namespace stan {
+namespace math {
+
+/**
+ * Chooses the grainsize of `reduce_sum_auto()` for one call site by timing
+ * the calls made with it.
+ *
+ * Starting from a grainsize that gives every thread a few chunks, the tuner
+ * doubles the grainsize as long as that lowers the run time per term, then
+ * tries halving it, and keeps the fastest grainsize found. Each candidate is
+ * measured over `samples_per_candidate` calls and the fastest of those is
+ * used, which filters out calls slowed down by other work on the machine.
+ * Larger grainsizes lower the per task overhead, smaller ones balance the load
+ * better, so the search converges on the grainsize where the two balance.
+ *
+ * Once converged, the tuner keeps returning the tuned grainsize. A frozen
+ * tuner returns a fixed grainsize and `reduce_sum_auto()` then partitions
+ * deterministically, like `reduce_sum_static()`. Freezing a tuned grainsize, or
+ * one saved from an earlier run, gives run to run reproducible results.
+ *
+ * All member functions are thread safe.
+ */
+class reduce_sum_grainsize_tuner {
+  mutable std::mutex mutex_;
+  int samples_per_candidate_;
+  int candidate_{0};
+  int candidate_samples_{0};
+  double candidate_time_{std::numeric_limits<double>::infinity()};
+  int best_{0};
+  double best_time_{std::numeric_limits<double>::infinity()};
+  int direction_{1};
+  bool converged_{false};
+  bool frozen_{false};
+
+  /**
+   * Moves on to the next candidate after the current one was measured.
+   * @param num_terms number of terms of the last call
+   */
+  inline void next_candidate(std::size_t num_terms) {
+    if (candidate_time_ < best_time_) {
+      best_ = candidate_;
+      best_time_ = candidate_time_;
+    } else if (direction_ > 0 && candidate_ != best_) {
+      direction_ = -1;
+      candidate_ = best_;
+    } else {
+      converged_ = true;
+    }
+    if (!converged_) {
+      long next = direction_ > 0 ? 2L * candidate_ : candidate_ / 2;
+      if (next < 1 || next > static_cast<long>(num_terms)) {
+        if (direction_ > 0 && best_ > 1) {
+          direction_ = -1;
+          next = best_ / 2;
+        } else {
+          converged_ = true;
+        }
+      }
+      candidate_ = static_cast<int>(next);
+    }
+    candidate_samples_ = 0;
+    candidate_time_ = std::numeric_limits<double>::infinity();
+  }
+
+ public:
+  /**
+   * Construct a tuner.
+   * @param samples_per_candidate number of calls each grainsize is timed over
+   * @throw std::domain_error if `samples_per_candidate` is not positive
+   */
+  explicit reduce_sum_grainsize_tuner(int samples_per_candidate = 3)
+      : samples_per_candidate_(samples_per_candidate) {
+    check_positive("reduce_sum_grainsize_tuner", "samples per candidate",
+                   samples_per_candidate);
+  }
+
+  /**
+   * Returns the grainsize to use for the next call.
+   * @param num_terms number of terms of the call
+   * @return grainsize, between 1 and `num_terms`
+   */
+  inline int grainsize(std::size_t num_terms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int max_grainsize = static_cast<int>(std::min<std::size_t>(
+        std::max<std::size_t>(num_terms, 1), std::numeric_limits<int>::max()));
+    if (converged_ || frozen_) {
+      return std::min(best_, max_grainsize);
+    }
+    if (candidate_ == 0) {
+      const std::size_t num_threads = tbb::this_task_arena::max_concurrency();
+      candidate_ = static_cast<int>(std::max<std::size_t>(
+          1, std::min<std::size_t>(num_terms / (4 * num_threads),
+                                   max_grainsize)));
+    } else if (candidate_ > max_grainsize) {
+      // the call has fewer terms than the candidate, so measure the largest
+      // grainsize possible instead, which record() then accepts
+      candidate_ = max_grainsize;
+      candidate_samples_ = 0;
+      candidate_time_ = std::numeric_limits<double>::infinity();
+    }
+    return candidate_;
+  }
+
+  /**
+   * Records the run time of a call made with the grainsize returned by
+   * `grainsize()`. Calls made with another grainsize, which happens when
+   * concurrent calls overlap a change of candidate, are ignored.
+   * @param grainsize grainsize of the call
+   * @param num_terms number of terms of the call
+   * @param seconds run time of the call
+   */
+  inline void record(int grainsize, std::size_t num_terms, double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (converged_ || frozen_ || num_terms == 0 || grainsize != candidate_) {
+      return;
+    }
+    candidate_time_ = std::min(candidate_time_, seconds / num_terms);
+    if (++candidate_samples_ >= samples_per_candidate_) {
+      next_candidate(num_terms);
+    }
+  }
+
+  /**
+   * Returns true if the search finished or the tuner is frozen.
+   */
+  inline bool converged() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return converged_ || frozen_;
+  }
+
+  /**
+   * Returns true if the tuner is frozen.
+   */
+  inline bool frozen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frozen_;
+  }
+
+  /**
+   * Returns the fastest grainsize found so far, or 0 if no candidate was
+   * measured yet.
+   */
+  inline int best_grainsize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return best_;
+  }
+
+  /**
+   * Stops tuning and fixes the grainsize at the fastest one found so far. If
+   * none was measured yet, the candidate of the next call is fixed.
+   * @param num_terms number of terms, used to choose a grainsize if none was
+   * tried yet
+   */
+  inline void freeze(std::size_t num_terms) {
+    const int g = grainsize(num_terms);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (best_ == 0) {
+      best_ = g;
+    }
+    frozen_ = true;
+  }
+
+  /**
+   * Stops tuning and fixes the grainsize.
+   * @param grainsize grainsize to use from now on
+   * @throw std::domain_error if `grainsize` is not positive
+   */
+  inline void freeze_at(int grainsize) {
+    check_positive("reduce_sum_grainsize_tuner", "grainsize", grainsize);
+    std::lock_guard<std::mutex> lock(mutex_);
+    best_ = grainsize;
+    frozen_ = true;
+  }
+
+  /**
+   * Forgets all measurements and starts tuning again.
+   */
+  inline void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    candidate_ = 0;
+    candidate_samples_ = 0;
+    candidate_time_ = std::numeric_limits<double>::infinity();
+    best_ = 0;
+    best_time_ = std::numeric_limits<double>::infinity();
+    direction_ = 1;
+    converged_ = false;
+    frozen_ = false;
+  }
+};
+
+/**
+ * Returns the grainsize tuner used by `reduce_sum_auto()` for
+ * `ReduceFunction`. Every call site of `reduce_sum` in a Stan program has its
+ * own partial sum functor, so the tuner is remembered per call site.
+ *
+ * @tparam ReduceFunction Type of reducer function
+ * @return tuner
+ */
+template <typename ReduceFunction>
+inline reduce_sum_grainsize_tuner& reduce_sum_tuner() {
+  static reduce_sum_grainsize_tuner tuner;
+  return tuner;
+}
+
+/**
+ * Call an instance of the function `ReduceFunction` on every element
+ *   of an input sequence and sum these terms, choosing the grainsize
+ *   automatically.
+ *
+ * This works like `reduce_sum()`, but the grainsize is chosen by the
+ * `reduce_sum_tuner<ReduceFunction>()`, which times the first calls with
+ * different grainsizes and then keeps the fastest. If the tuner is frozen,
+ * the work is partitioned deterministically with the frozen grainsize, as in
+ * `reduce_sum_static()`.
+ *
+ * ReduceFunction must define an operator() with the same signature as:
+ *   T f(Vec&& vmapped_subset, int start, int end, std::ostream* msgs, Args&&...
+ * args)
+ *
+ * `ReduceFunction` must be default constructible without any arguments
+ *
+ * If STAN_THREADS is not defined, do all the work with one ReduceFunction call.
+ *
+ * @tparam ReduceFunction Type of reducer function
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ * @param vmapped Vector containing one element per term of sum
+ * @param[in, out] msgs The print stream for warning messages
+ * @param args Shared arguments used in every sum term
+ * @return Sum of terms
+ */
+template <typename ReduceFunction, typename Vec,
+          typename = require_vector_like_t<Vec>, typename... Args>
+inline auto reduce_sum_auto(Vec&& vmapped, std::ostream* msgs,
+                            Args&&... args) {
+  using return_type = return_type_t<Vec, Args...>;
+
+#ifdef STAN_THREADS
+  auto& tuner = reduce_sum_tuner<ReduceFunction>();
+  const std::size_t num_terms = vmapped.size();
+  const bool frozen = tuner.frozen();
+  const int grainsize = tuner.grainsize(num_terms);
+  const auto start = std::chrono::steady_clock::now();
+  return_type sum
+      = internal::reduce_sum_impl<ReduceFunction, void, return_type, Vec,
+                                  ref_type_t<Args&&>...>()(
+          std::forward<Vec>(vmapped), !frozen, grainsize, msgs,
+          std::forward<Args>(args)...);
+  if (!frozen) {
+    tuner.record(grainsize, num_terms,
+                 std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                               - start)
+                     .count());
+  }
+  return sum;
+#else
+  if (vmapped.empty()) {
+    return return_type(0.0);
+  }
+
+  return ReduceFunction()(std::forward<Vec>(vmapped), 0, vmapped.size() - 1,
+                          msgs, std::forward<Args>(args)...);
+#endif
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
@@ -0,0 +1,474 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_REDUCE_SUM_MPI_HPP
+#define STAN_MATH_PRIM_FUNCTOR_REDUCE_SUM_MPI_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/functor/reduce_sum.hpp>
+
+#ifdef STAN_MPI
+#include <stan/math/prim/fun/sum.hpp>
+#include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <stan/math/prim/functor/for_each.hpp>
+#include <stan/math/prim/functor/mpi_cluster.hpp>
+#include <stan/math/prim/functor/mpi_distributed_apply.hpp>
+#include <stan/math/prim/functor/mpi_parallel_call.hpp>
+
+#include <boost/serialization/vector.hpp>
+
+#include <array>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+#endif
+
+#include <vector>
+
+namespace stan {
+namespace math {
+
+#ifdef STAN_MPI
+
+namespace internal {
+
+/**
+ * Type of the values of a shared argument of `reduce_sum_mpi` as they are
+ * sent to the workers
+ *
+ * @tparam T Type of shared argument
+ */
+template <typename T>
+using reduce_sum_mpi_value_t
+    = plain_type_t<decltype(value_of(std::declval<const T&>()))>;
+
+/**
+ * Reducer function which passes the indices of the terms in the whole sliced
+ * argument to `ReduceFunction`, while it is called with the indices of the
+ * terms in the slice of one rank by `reduce_sum`.
+ *
+ * @tparam ReduceFunction Type of reducer function
+ */
+template <typename ReduceFunction>
+struct reduce_sum_mpi_offset {
+  template <typename Vec, typename... Args>
+  inline auto operator()(Vec&& vmapped_subset, int start, int end,
+                         std::ostream* msgs, int offset,
+                         Args&&... args) const {
+    return ReduceFunction()(std::forward<Vec>(vmapped_subset), start + offset,
+                            end + offset, msgs, std::forward<Args>(args)...);
+  }
+};
+
+template <typename ReduceFunction, typename Enable, typename ReturnType,
+          typename Vec, typename... Args>
+struct reduce_sum_mpi_local;
+
+/**
+ * Specialization of reduce_sum_mpi_local for arithmetic types
+ *
+ * @tparam ReduceFunction Type of reducer function
+ * @tparam ReturnType An arithmetic type
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ */
+template <typename ReduceFunction, typename ReturnType, typename Vec,
+          typename... Args>
+struct reduce_sum_mpi_local<ReduceFunction, require_arithmetic_t<ReturnType>,
+                            ReturnType, Vec, Args...> {
+  /**
+   * Returns the number of adjoints of the shared arguments, which is zero.
+   */
+  static std::size_t num_adjoints(const reduce_sum_mpi_value_t<Args>&...) {
+    return 0;
+  }
+
+  /**
+   * Sums the terms of the slice of the sliced argument held by one rank with
+   *   the local `reduce_sum`.
+   *
+   * @param slice Slice of the sliced argument
+   * @param offset Index of the first term of the slice in the sliced argument
+   * @param grainsize Grainsize for tbb
+   * @param[in, out] msgs The print stream for warning messages
+   * @param[out] result Partial sum
+   * @param args Shared arguments used in every sum term
+   */
+  inline void operator()(const Vec& slice, int offset, int grainsize,
+                         std::ostream* msgs, double* result,
+                         const reduce_sum_mpi_value_t<Args>&... args) const {
+    result[0] = reduce_sum<reduce_sum_mpi_offset<ReduceFunction>>(
+        slice, grainsize, msgs, offset, args...);
+  }
+
+  /**
+   * Returns the sum of all partial sums.
+   *
+   * @param result Sum of the partial sums of all ranks
+   * @return Sum of terms
+   */
+  static double combine(const std::vector<double>& result, const Args&...) {
+    return result[0];
+  }
+};
+
+/**
+ * Broadcasts an arithmetic value from the root.
+ *
+ * @param world communicator
+ * @param[in, out] x value on the root, received value on the workers
+ */
+template <typename T, require_arithmetic_t<T>* = nullptr>
+inline void mpi_broadcast_value(const boost::mpi::communicator& world, T& x) {
+  boost::mpi::broadcast(world, x, 0);
+}
+
+/**
+ * Broadcasts an Eigen matrix and its shape from the root.
+ *
+ * @param world communicator
+ * @param[in, out] x matrix on the root, received matrix on the workers
+ */
+template <typename EigMat, require_eigen_t<EigMat>* = nullptr>
+inline void mpi_broadcast_value(const boost::mpi::communicator& world,
+                                EigMat& x) {
+  std::array<Eigen::Index, 2> dims{{x.rows(), x.cols()}};
+  boost::mpi::broadcast(world, dims.data(), 2, 0);
+  x.resize(dims[0], dims[1]);
+  boost::mpi::broadcast(world, x.data(), x.size(), 0);
+}
+
+/**
+ * Broadcasts a `std::vector` of arithmetic values and its size from the root.
+ *
+ * @param world communicator
+ * @param[in, out] x vector on the root, received vector on the workers
+ */
+template <typename T, require_arithmetic_t<T>* = nullptr>
+inline void mpi_broadcast_value(const boost::mpi::communicator& world,
+                                std::vector<T>& x) {
+  std::size_t size = x.size();
+  boost::mpi::broadcast(world, size, 0);
+  x.resize(size);
+  boost::mpi::broadcast(world, x.data(), size, 0);
+}
+
+/**
+ * Broadcasts a `std::vector` of containers and its size from the root.
+ *
+ * @param world communicator
+ * @param[in, out] x vector on the root, received vector on the workers
+ */
+template <typename T, require_not_arithmetic_t<T>* = nullptr>
+inline void mpi_broadcast_value(const boost::mpi::communicator& world,
+                                std::vector<T>& x) {
+  std::size_t size = x.size();
+  boost::mpi::broadcast(world, size, 0);
+  x.resize(size);
+  for (auto& x_i : x) {
+    mpi_broadcast_value(world, x_i);
+  }
+}
+
+}  // namespace internal
+
+/**
+ * The MPI reduce sum class manages the distributed evaluation of a
+ * `reduce_sum` over the MPI cluster.
+ *
+ * The flow of commands are:
+ *
+ * 1. The constructor of this class must be called on the root node where
+ *    the sliced argument and the shared arguments are passed to the class.
+ * 2. The constructor then tries to allocate the MPI cluster resource and
+ *    instructs the workers to run the static distributed_apply method of
+ *    this class, which constructs an instance on the workers.
+ * 3. On the first evaluation the sliced argument is split into one
+ *    contiguous slice per rank, which is scattered and cached on each
+ *    rank. The sliced argument must thus be data. As for `mpi_parallel_call`,
+ *    the root is assigned a little less terms than the workers.
+ * 4. The values of the shared arguments are broadcasted on every call.
+ * 5. Each rank sums the terms of its slice with the local (threaded)
+ *    `reduce_sum`. Parameters among the shared arguments are evaluated
+ *    on a nested autodiff tape and the gradient of the partial sum with
+ *    respect to them is computed right away.
+ * 6. Only the partial sums and the adjoints of the shared parameters are
+ *    summed up on the root with a single reduce operation.
+ *
+ * If the evaluation fails on any rank all ranks still take part in the
+ * reduce operation to keep the cluster synchronized. The root then rethrows
+ * its own exception or throws a `std::domain_error` if only workers failed.
+ *
+ * @tparam call_id label for the cached slices
+ * @tparam ReduceFunction Type of reducer function
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ */
+template <int call_id, typename ReduceFunction, typename Vec, typename... Args>
+class mpi_reduce_sum {
+  static_assert(!is_var<scalar_type_t<Vec>>::value,
+                "The sliced argument of reduce_sum_mpi must be data.");
+
+  boost::mpi::communicator world_;
+  const std::size_t rank_ = world_.rank();
+  const std::size_t world_size_ = world_.size();
+  std::unique_lock<std::mutex> cluster_lock_;
+
+  // local caches which hold the local slice of the sliced argument; the
+  // items are labelled apart from those of mpi_parallel_call such that
+  // map_rect and reduce_sum_mpi may use the same call_id
+  using cache_slice = internal::mpi_parallel_call_cache<call_id, 11, Vec>;
+  using cache_chunks
+      = internal::mpi_parallel_call_cache<call_id, 12, std::vector<int>>;
+
+  int grainsize_{1};
+  std::tuple<internal::reduce_sum_mpi_value_t<Args>...> local_args_;
+
+ public:
+  using local_t
+      = internal::reduce_sum_mpi_local<ReduceFunction, void,
+                                       return_type_t<Vec, Args...>, Vec,
+                                       Args...>;
+
+  /**
+   * Initiates a distributed reduce sum on the root. The constructor
+   * allocates the MPI resource and initiates on all workers the
+   * distributed reduce sum which mirrors the communication.
+   *
+   * @param vmapped Vector containing one element per term of sum
+   * @param grainsize Grainsize for tbb on each rank
+   * @param args Shared arguments used in every sum term
+   */
+  mpi_reduce_sum(const Vec& vmapped, int grainsize, const Args&... args)
+      : grainsize_(grainsize), local_args_(value_of(args)...) {
+    if (rank_ != 0) {
+      throw std::runtime_error(
+          "problem sizes may only be defined on the root.");
+    }
+
+    if (cache_chunks::is_valid()) {
+      const int cached_num_terms = sum(cache_chunks::data());
+      check_size_match("reduce_sum_mpi", "cached number of terms",
+                       cached_num_terms, "number of terms", vmapped.size());
+    }
+
+    // make children aware of upcoming job & obtain cluster lock
+    cluster_lock_ = mpi_broadcast_command<
+        stan::math::mpi_distributed_apply<mpi_reduce_sum>>();
+
+    setup_call(vmapped);
+  }
+
+  // called on remote sites
+  mpi_reduce_sum() {
+    if (rank_ == 0) {
+      throw std::runtime_error("problem sizes must be defined on the root.");
+    }
+
+    setup_call(Vec());
+  }
+
+  /**
+   * Entry point on the workers for the mpi_reduce_sum.
+   */
+  static void distributed_apply() {
+    // call constructor for the remotes
+    mpi_reduce_sum<call_id, ReduceFunction, Vec, Args...> job_chunk;
+
+    job_chunk.reduce(nullptr);
+  }
+
+  /**
+   * Sums the terms of the local slice and reduces the partial sums and the
+   * adjoints of the shared arguments on the root.
+   *
+   * @param[in, out] msgs The print stream for warning messages, only used
+   * for the terms summed on the root
+   * @return on the root the sum of terms followed by the adjoints of the
+   * shared arguments, empty on the workers
+   */
+  std::vector<double> reduce(std::ostream* msgs) {
+    const Vec& local_slice = cache_slice::data();
+    const std::vector<int>& chunks = cache_chunks::data();
+    const int offset
+        = std::accumulate(chunks.begin(), chunks.begin() + rank_, 0);
+
+    const std::size_t num_adjoints = math::apply(
+        [](const auto&... args) { return local_t::num_adjoints(args...); },
+        local_args_);
+
+    // the first element counts the failed ranks, followed by the partial
+    // sum and the adjoints of the shared arguments
+    std::vector<double> local_result(2 + num_adjoints, 0.0);
+    std::exception_ptr local_error;
+    try {
+      math::apply(
+          [&](const auto&... args) {
+            local_t()(local_slice, offset, grainsize_, msgs,
+                      local_result.data() + 1, args...);
+          },
+          local_args_);
+    } catch (const std::exception& e) {
+      // see note 1 of mpi_parallel_call for an explanation why we do
+      // not rethrow here, but merely flag it to keep the cluster
+      // synchronized
+      local_error = std::current_exception();
+      std::fill(local_result.begin(), local_result.end(), 0.0);
+      local_result[0] = 1.0;
+    }
+
+    std::vector<double> world_result(local_result.size());
+    boost::mpi::reduce(world_, local_result.data(), local_result.size(),
+                       world_result.data(), std::plus<double>(), 0);
+
+    // on the workers all is done now.
+    if (rank_ != 0) {
+      return {};
+    }
+
+    // in case something went wrong we throw on the root
+    if (local_error) {
+      std::rethrow_exception(local_error);
+    }
+    if (world_result[0] > 0) {
+      throw std::domain_error("Error during MPI evaluation.");
+    }
+
+    world_result.erase(world_result.begin());
+    return world_result;
+  }
+
+ private:
+  /**
+   * Performs a cached scatter of the sliced argument. On the first call
+   * the sliced argument on the root is split into one contiguous slice
+   * per rank, which is scattered and stored in the cache locally. Any
+   * subsequent calls use the cached slices.
+   *
+   * @param vmapped sliced argument on the root and a dummy argument on
+   * workers
+   */
+  void scatter_slice_cached(const Vec& vmapped) {
+    // distribute data only if not in cache yet
+    if (cache_slice::is_valid()) {
+      return;
+    }
+
+    std::vector<int> chunks = mpi_map_chunks(vmapped.size(), 1);
+    boost::mpi::broadcast(world_, chunks, 0);
+
+    Vec local_slice;
+    if (rank_ == 0) {
+      std::vector<Vec> slices(world_size_);
+      auto slice_begin = vmapped.begin();
+      for (std::size_t i = 0; i != world_size_; ++i) {
+        slices[i].assign(slice_begin, slice_begin + chunks[i]);
+        slice_begin += chunks[i];
+      }
+      boost::mpi::scatter(world_, slices, local_slice, 0);
+    } else {
+      boost::mpi::scatter(world_, local_slice, 0);
+    }
+
+    // finally we cache it locally
+    cache_chunks::store(chunks);
+    cache_slice::store(local_slice);
+  }
+
+  void setup_call(const Vec& vmapped) {
+    boost::mpi::broadcast(world_, grainsize_, 0);
+    scatter_slice_cached(vmapped);
+    math::for_each(
+        [this](auto& arg) { internal::mpi_broadcast_value(world_, arg); },
+        local_args_);
+  }
+};
+
+#endif
+
+/**
+ * Call an instance of the function `ReduceFunction` on every element
+ *   of an input sequence and sum these terms over the MPI cluster.
+ *
+ * This works like `reduce_sum()`, but the terms are split into one slice
+ * per MPI rank. The slices are scattered to the ranks on the first call and
+ * cached there, so the sliced argument must be data and must not change
+ * between calls with the same `call_id`. Each rank sums its terms with the
+ * local `reduce_sum()` using the given grainsize, and only the partial sums
+ * and the adjoints of the shared arguments are sent back to the root.
+ *
+ * The indices passed to `ReduceFunction` are the indices of the terms in the
+ * whole sliced argument, as for `reduce_sum()`.
+ *
+ * ReduceFunction must define an operator() with the same signature as:
+ *   T f(Vec&& vmapped_subset, int start, int end, std::ostream* msgs, Args&&...
+ * args)
+ *
+ * `ReduceFunction` must be default constructible without any arguments
+ *
+ * Every call site must be registered in the root namespace with
+ * `STAN_REGISTER_MPI_REDUCE_SUM(call_id, ReduceFunction, types...)`, where
+ * `types` are the plain types of the sliced argument and of the shared
+ * arguments. The elements of the sliced argument must be serializable with
+ * boost serialization, i.e. scalars or (nested) `std::vector`s of those.
+ * Shared arguments can be scalars, Eigen types or `std::vector`s of those.
+ *
+ * If STAN_MPI is not defined, or the cluster is already in use, this is
+ * `reduce_sum()`.
+ *
+ * @tparam call_id label of the call site
+ * @tparam ReduceFunction Type of reducer function
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ * @param vmapped Vector containing one element per term of sum
+ * @param grainsize Suggested grainsize for tbb on each rank
+ * @param[in, out] msgs The print stream for warning messages
+ * @param args Shared arguments used in every sum term
+ * @return Sum of terms
+ */
+template <int call_id, typename ReduceFunction, typename Vec,
+          typename = require_vector_like_t<Vec>, typename... Args>
+inline return_type_t<Vec, Args...> reduce_sum_mpi(Vec&& vmapped, int grainsize,
+                                                  std::ostream* msgs,
+                                                  Args&&... args) {
+  check_positive("reduce_sum_mpi", "grainsize", grainsize);
+
+#ifdef STAN_MPI
+  using mpi_call_t = mpi_reduce_sum<call_id, ReduceFunction, std::decay_t<Vec>,
+                                    plain_type_t<Args>...>;
+
+  // whenever the cluster is already busy with some command we fall
+  // back to the local reduce_sum
+  try {
+    mpi_call_t job_chunk(vmapped, grainsize, args...);
+
+    return mpi_call_t::local_t::combine(job_chunk.reduce(msgs), args...);
+  } catch (const mpi_is_in_use& e) {
+    return reduce_sum<ReduceFunction>(std::forward<Vec>(vmapped), grainsize,
+                                      msgs, std::forward<Args>(args)...);
+  }
+#else
+  return reduce_sum<ReduceFunction>(std::forward<Vec>(vmapped), grainsize,
+                                    msgs, std::forward<Args>(args)...);
+#endif
+}
+
+}  // namespace math
+}  // namespace stan
+
+#ifdef STAN_MPI
+#define STAN_REGISTER_MPI_REDUCE_SUM(CALLID, FUNCTOR, ...)                   \
+  namespace stan {                                                           \
+  namespace math {                                                           \
+  namespace internal {                                                       \
+  typedef mpi_reduce_sum<CALLID, FUNCTOR, __VA_ARGS__> mpi_rs_##CALLID##_;   \
+  }                                                                          \
+  }                                                                          \
+  }                                                                          \
+  STAN_REGISTER_MPI_DISTRIBUTED_APPLY(stan::math::internal::mpi_rs_##CALLID##_)
+#else
+#define STAN_REGISTER_MPI_REDUCE_SUM(CALLID, FUNCTOR, ...)
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef STAN_MATH_PRIM_META_IS_FUSED_EXPRESSION_HPP
+#define STAN_MATH_PRIM_META_IS_FUSED_EXPRESSION_HPP
+
+#include <stan/math/prim/meta/bool_constant.hpp>
+#include <stan/math/prim/meta/require_helpers.hpp>
+#include <type_traits>
+
+namespace stan {
+
+/**
+ * Non-templated base of `fused_base` is needed for easy checking if
+ * something is a fused expression.
+ */
+class fused_expression_base {};
+
+/**
+ * Checks whether the type is a fused expression of elementwise operations
+ * over reverse mode matrices, see `fused_base`.
+ * @tparam T type to check
+ * @ingroup type_trait
+ */
+template <typename T>
+struct is_fused_expression
+    : bool_constant<std::is_base_of<fused_expression_base,
+                                    std::decay_t<T>>::value> {};
+
+/**
+ * Checks whether the type can be an operand of a fused expression, which
+ * is a fused expression or an arithmetic scalar.
+ * @tparam T type to check
+ * @ingroup type_trait
+ */
+template <typename T>
+struct is_fused_operand
+    : bool_constant<is_fused_expression<T>::value
+                    || std::is_arithmetic<std::decay_t<T>>::value> {};
+
+STAN_ADD_REQUIRE_UNARY(fused_expression, is_fused_expression, general_types);
+STAN_ADD_REQUIRE_UNARY(fused_operand, is_fused_operand, general_types);
+
+}  // namespace stan
+
+#endif
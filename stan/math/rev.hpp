@@ -11,6 +11,7 @@
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/fun.hpp>
 #include <stan/math/rev/functor.hpp>
+#include <stan/math/rev/fused.hpp>
 #include <stan/math/rev/prob.hpp>
 
 #include <stan/math/prim.hpp>
@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_HPP
 
 #include <stan/math/rev/core/accumulate_adjoints.hpp>
+#include <stan/math/rev/core/ad_tape_pool.hpp>
 #include <stan/math/rev/core/arena_allocator.hpp>
 #include <stan/math/rev/core/arena_matrix.hpp>
 #include <stan/math/rev/core/autodiffstackstorage.hpp>
@@ -58,6 +59,8 @@
 #include <stan/math/rev/core/set_zero_all_adjoints.hpp>
 #include <stan/math/rev/core/set_zero_all_adjoints_nested.hpp>
 #include <stan/math/rev/core/start_nested.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
+#include <stan/math/rev/core/static_tape_sweep.hpp>
 #include <stan/math/rev/core/std_complex.hpp>
 #include <stan/math/rev/core/std_isinf.hpp>
 #include <stan/math/rev/core/std_isnan.hpp>
@@ -0,0 +1,169 @@
+#ifndef STAN_MATH_REV_CORE_AD_TAPE_POOL_HPP
+#define STAN_MATH_REV_CORE_AD_TAPE_POOL_HPP
+
+#include <stan/math/rev/core/chainable_alloc.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
+#include <stan/math/prim/core/thread_affinity.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Lock-free pool of AD tapes for the TBB worker threads. A worker thread
+ * checks out a tape when it enters the TBB scheduler and returns it when
+ * it leaves, such that tapes are not freed and reallocated when the
+ * scheduler adds and removes threads. A returned tape is emptied, but it
+ * keeps the blocks of its arena and the capacity of its stacks, so the
+ * next worker starts with a tape sized for the work done so far.
+ *
+ * The pool holds up to `max_tapes` tapes in slots which are taken and
+ * filled with atomic exchanges only. Tapes returned to a full pool are
+ * deleted. New tapes are touched by the thread checking them out, such
+ * that a pinned thread gets a tape on its own NUMA node.
+ */
+class ad_tape_pool {
+ public:
+  using tape_t = ChainableStack::AutodiffStackStorage;
+  static constexpr std::size_t max_tapes = 256;
+
+  ad_tape_pool() {
+    for (auto& slot : slots_) {
+      slot.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  ~ad_tape_pool() {
+    for (auto& slot : slots_) {
+      delete slot.exchange(nullptr, std::memory_order_acquire);
+    }
+  }
+
+  ad_tape_pool(const ad_tape_pool&) = delete;
+  ad_tape_pool& operator=(const ad_tape_pool&) = delete;
+
+  /**
+   * Check out a tape. A new tape is created if the pool is empty.
+   *
+   * @return tape owned by the caller
+   */
+  inline tape_t* acquire() {
+    for (auto& slot : slots_) {
+      if (slot.load(std::memory_order_relaxed) != nullptr) {
+        tape_t* tape = slot.exchange(nullptr, std::memory_order_acquire);
+        if (tape != nullptr) {
+          return tape;
+        }
+      }
+    }
+    tape_t* tape = new tape_t();
+    tape->memalloc_.touch_blocks();
+    return tape;
+  }
+
+  /**
+   * Empty a tape and return it to the pool. The tape is deleted if the
+   * pool is full.
+   *
+   * @param tape tape checked out with `acquire()`
+   */
+  inline void release(tape_t* tape) {
+    clear(tape);
+    for (auto& slot : slots_) {
+      tape_t* empty = nullptr;
+      if (slot.load(std::memory_order_relaxed) == nullptr
+          && slot.compare_exchange_strong(empty, tape,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+        return;
+      }
+    }
+    delete tape;
+  }
+
+  /**
+   * Create tapes until the pool holds at least the given number of tapes,
+   * for example one per thread of the TBB threadpool.
+   *
+   * @param num_tapes number of tapes, at most `max_tapes`
+   */
+  inline void reserve(std::size_t num_tapes) {
+    const std::size_t capacity = max_tapes;
+    for (std::size_t n = size(); n < std::min(num_tapes, capacity); ++n) {
+      tape_t* tape = new tape_t();
+      tape->memalloc_.touch_blocks();
+      release(tape);
+    }
+  }
+
+  /**
+   * Return the number of tapes held by the pool.
+   *
+   * @return number of tapes
+   */
+  inline std::size_t size() const {
+    return std::count_if(slots_.begin(), slots_.end(), [](const auto& slot) {
+      return slot.load(std::memory_order_relaxed) != nullptr;
+    });
+  }
+
+ private:
+  /**
+   * Empty a tape like `recover_memory()` does for the current tape. A
+   * `static_tape` still recording on the tape is detached and marked as
+   * not replayable, as the operations it recorded point into the arena.
+   */
+  static void clear(tape_t* tape) {
+    if (tape->static_tape_ != nullptr) {
+      tape->static_tape_->invalidate();
+      tape->static_tape_ = nullptr;
+      internal::num_recording_static_tapes().fetch_sub(1);
+    }
+    tape->var_stack_.clear();
+    tape->var_nochain_stack_.clear();
+    for (auto& x : tape->var_alloc_stack_) {
+      delete x;
+    }
+    tape->var_alloc_stack_.clear();
+    tape->nested_var_stack_sizes_.clear();
+    tape->nested_var_nochain_stack_sizes_.clear();
+    tape->nested_var_alloc_stack_starts_.clear();
+    for (std::size_t n = tape->memalloc_.nested_bytes_used().size(); n > 0;
+         --n) {
+      tape->memalloc_.recover_nested();
+    }
+    tape->memalloc_.recover_all();
+  }
+
+  std::array<std::atomic<tape_t*>, max_tapes> slots_;
+};
+
+/**
+ * Return the pool of AD tapes of a NUMA node. Threads which are not pinned
+ * use the pool of the first node. The pools are never destroyed, since
+ * worker threads may return their tapes during static destruction.
+ *
+ * @param node index of the node into `internal::numa_node_cpus()`
+ * @return reference to the pool
+ */
+inline ad_tape_pool& get_ad_tape_pool(int node = 0) {
+  static const std::vector<ad_tape_pool*>* pools = [] {
+    auto* node_pools = new std::vector<ad_tape_pool*>();
+    for (std::size_t i = 0; i < internal::numa_node_cpus().size(); ++i) {
+      node_pools->push_back(new ad_tape_pool());
+    }
+    return node_pools;
+  }();
+  return *(*pools)[node < 0 ? 0 : node % pools->size()];
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
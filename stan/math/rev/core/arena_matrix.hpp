@@ -39,9 +39,9 @@ class arena_matrix : public Eigen::Map<MatrixType> {
    * @param cols number of columns
    */
   arena_matrix(Eigen::Index rows, Eigen::Index cols)
-      : Base::Map(
-          ChainableStack::instance_->memalloc_.alloc_array<Scalar>(rows * cols),
-          rows, cols) {}
+      : Base::Map(ChainableStack::instance_->memalloc_
+                      .alloc_aligned_array<Scalar>(rows * cols),
+                  rows, cols) {}
 
   /**
    * Constructs `arena_matrix` with given size. This only works if
@@ -49,9 +49,9 @@ class arena_matrix : public Eigen::Map<MatrixType> {
    * @param size number of elements
    */
   explicit arena_matrix(Eigen::Index size)
-      : Base::Map(
-          ChainableStack::instance_->memalloc_.alloc_array<Scalar>(size),
-          size) {}
+      : Base::Map(ChainableStack::instance_->memalloc_
+                      .alloc_aligned_array<Scalar>(size),
+                  size) {}
 
   /**
    * Constructs `arena_matrix` from an expression.
@@ -60,7 +60,7 @@ class arena_matrix : public Eigen::Map<MatrixType> {
   template <typename T, require_eigen_t<T>* = nullptr>
   arena_matrix(const T& other)  // NOLINT
       : Base::Map(
-          ChainableStack::instance_->memalloc_.alloc_array<Scalar>(
+          ChainableStack::instance_->memalloc_.alloc_aligned_array<Scalar>(
               other.size()),
           (RowsAtCompileTime == 1 && T::ColsAtCompileTime == 1)
                   || (ColsAtCompileTime == 1 && T::RowsAtCompileTime == 1)
@@ -116,14 +116,14 @@ class arena_matrix : public Eigen::Map<MatrixType> {
     if ((RowsAtCompileTime == 1 && T::ColsAtCompileTime == 1)
         || (ColsAtCompileTime == 1 && T::RowsAtCompileTime == 1)) {
       // placement new changes what data map points to - there is no allocation
-      new (this) Base(
-          ChainableStack::instance_->memalloc_.alloc_array<Scalar>(a.size()),
-          a.cols(), a.rows());
+      new (this) Base(ChainableStack::instance_->memalloc_
+                          .alloc_aligned_array<Scalar>(a.size()),
+                      a.cols(), a.rows());
 
     } else {
-      new (this) Base(
-          ChainableStack::instance_->memalloc_.alloc_array<Scalar>(a.size()),
-          a.rows(), a.cols());
+      new (this) Base(ChainableStack::instance_->memalloc_
+                          .alloc_aligned_array<Scalar>(a.size()),
+                      a.rows(), a.cols());
     }
     Base::operator=(a);
     return *this;
@@ -7,6 +7,8 @@
 namespace stan {
 namespace math {
 
+class static_tape;
+
 // Internal macro used to modify global pointer definition to the
 // global AD instance.
 #ifdef STAN_THREADS
@@ -110,6 +112,9 @@ struct AutodiffStackSingleton {
     std::vector<size_t> nested_var_stack_sizes_;
     std::vector<size_t> nested_var_nochain_stack_sizes_;
     std::vector<size_t> nested_var_alloc_stack_starts_;
+
+    // static tape recording the scalar operations, if any
+    static_tape *static_tape_{nullptr};
   };
 
   explicit AutodiffStackSingleton(AutodiffStackSingleton_t const &) = delete;
@@ -118,15 +123,10 @@ struct AutodiffStackSingleton {
   static STAN_THREADS_DEF AutodiffStackStorage *instance_;
 
  private:
+  // a tape which is already set, for example one checked out of the
+  // ad_tape_pool by a TBB worker thread, is used and not owned
   static bool init() {
-    static STAN_THREADS_DEF bool is_initialized = false;
-    if (!is_initialized) {
-      is_initialized = true;
-      instance_ = new AutodiffStackStorage();
-      return true;
-    }
     if (!instance_) {
-      is_initialized = true;
       instance_ = new AutodiffStackStorage();
       return true;
     }
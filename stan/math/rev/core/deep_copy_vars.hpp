@@ -81,6 +81,21 @@ inline auto deep_copy_vars(EigT&& arg) {
       .eval();
 }
 
+/**
+ * Reallocate a new vari for a `var_value` containing an Eigen type. The value
+ * is not copied; the new vari shares the memory of the value of `arg` and only
+ * gets its own adjoint.
+ *
+ * @tparam VarMat A `var_value` with an Eigen type as its value
+ * @param arg A `var_value` containing an Eigen type
+ * @return A new `var_value` sharing the value of `arg`
+ */
+template <typename VarMat, require_var_matrix_t<VarMat>* = nullptr>
+inline auto deep_copy_vars(VarMat&& arg) {
+  using mat_t = plain_type_t<value_type_t<VarMat>>;
+  return var_value<mat_t>(new vari_value<mat_t>(arg.vi_->val_, false));
+}
+
 }  // namespace math
 }  // namespace stan
 
@@ -1,18 +1,37 @@
 #ifndef STAN_MATH_REV_CORE_INIT_CHAINABLESTACK_HPP
 #define STAN_MATH_REV_CORE_INIT_CHAINABLESTACK_HPP
 
+#include <stan/math/rev/core/ad_tape_pool.hpp>
 #include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/prim/core/thread_affinity.hpp>
 
 #include <tbb/task_scheduler_observer.h>
 
-#include <mutex>
-#include <unordered_map>
-#include <utility>
-#include <thread>
-#include <tuple>
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace stan {
 namespace math {
+namespace internal {
+
+/**
+ * AD tape checked out of the ad_tape_pool by the calling thread.
+ */
+struct ad_tape_checkout {
+  ad_tape_pool::tape_t* tape_{nullptr};
+  // node of the pool the tape belongs to
+  int node_{0};
+  // number of scheduler entries not yet matched by an exit
+  int depth_{0};
+};
+
+inline ad_tape_checkout& thread_ad_tape_checkout() {
+  static thread_local ad_tape_checkout checkout;
+  return checkout;
+}
+
+}  // namespace internal
 
 /**
  * TBB observer object which is a callback hook called whenever the
@@ -20,45 +39,111 @@ namespace math {
  * hook ensures that each worker thread has an initialized AD tape
  * ready for use.
  *
+ * Threads without a tape check one out of the ad_tape_pool when they
+ * enter the scheduler and return it when they leave, such that the
+ * tape's memory is reused when the scheduler churns threads. Entries and
+ * exits only touch thread local state and the lock-free pool. The first
+ * call to `init_threadpool_tbb()` fills the pool with one tape per worker
+ * thread. The AD tape of the main thread is created by the constructor.
+ *
+ * If the worker threads have an affinity (see thread_affinity), a worker
+ * thread is pinned before it checks out its AD tape from the pool of its
+ * NUMA node, and new tapes are touched right away, such that they are
+ * allocated on that node. A worker thread moved to another node by a NUMA
+ * node arena swaps its tape for one of the new node if its tape is empty.
+ *
  * Refer to
  * https://software.intel.com/content/www/us/en/develop/documentation/tbb-documentation/top/intel-threading-building-blocks-developer-reference/task-scheduler/taskschedulerobserver.html
  * for details on the observer concept.
  */
 class ad_tape_observer final : public tbb::task_scheduler_observer {
-  using stack_ptr = std::unique_ptr<ChainableStack>;
-  using ad_map = std::unordered_map<std::thread::id, stack_ptr>;
-
  public:
-  ad_tape_observer() : tbb::task_scheduler_observer(), thread_tape_map_() {
-    on_scheduler_entry(true);  // register current process
-    observe(true);             // activates the observer
+  ad_tape_observer()
+      : tbb::task_scheduler_observer(),
+        main_stack_(std::make_unique<ChainableStack>()) {
+    internal::numa_node_change_callback() = &ad_tape_observer::relocate_tape;
+    internal::threadpool_init_callback() = &ad_tape_observer::reserve_tapes;
+    observe(true);  // activates the observer
   }
 
   ~ad_tape_observer() { observe(false); }
 
   void on_scheduler_entry(bool worker) {
-    std::lock_guard<std::mutex> thread_tape_map_lock(thread_tape_map_mutex_);
-    const std::thread::id thread_id = std::this_thread::get_id();
-    if (thread_tape_map_.find(thread_id) == thread_tape_map_.end()) {
-      ad_map::iterator insert_elem;
-      bool status = false;
-      std::tie(insert_elem, status)
-          = thread_tape_map_.emplace(ad_map::value_type{thread_id, nullptr});
-      insert_elem->second = std::make_unique<ChainableStack>();
+    if (worker) {
+      internal::pin_worker_thread();
+    }
+    internal::ad_tape_checkout& checkout = internal::thread_ad_tape_checkout();
+    if (checkout.depth_++ == 0 && ChainableStack::instance_ == nullptr) {
+      checkout.node_ = internal::thread_numa_node();
+      checkout.tape_ = get_ad_tape_pool(checkout.node_).acquire();
+      ChainableStack::instance_ = checkout.tape_;
     }
   }
 
   void on_scheduler_exit(bool worker) {
-    std::lock_guard<std::mutex> thread_tape_map_lock(thread_tape_map_mutex_);
-    auto elem = thread_tape_map_.find(std::this_thread::get_id());
-    if (elem != thread_tape_map_.end()) {
-      thread_tape_map_.erase(elem);
+    internal::ad_tape_checkout& checkout = internal::thread_ad_tape_checkout();
+    if (--checkout.depth_ == 0 && checkout.tape_ != nullptr) {
+      if (ChainableStack::instance_ == checkout.tape_) {
+        ChainableStack::instance_ = nullptr;
+      }
+      get_ad_tape_pool(checkout.node_).release(checkout.tape_);
+      checkout.tape_ = nullptr;
+    }
+  }
+
+  /**
+   * Swap the AD tape checked out by the calling thread for a tape of the
+   * NUMA node the thread runs on. The tape is only swapped if it is empty,
+   * since existing vars point into it.
+   */
+  static void relocate_tape() {
+    internal::ad_tape_checkout& checkout = internal::thread_ad_tape_checkout();
+    ChainableStack::AutodiffStackStorage* instance = ChainableStack::instance_;
+    const int node = internal::thread_numa_node();
+    if (checkout.tape_ == nullptr || instance != checkout.tape_
+        || checkout.node_ == node || !instance->var_stack_.empty()
+        || !instance->var_nochain_stack_.empty()
+        || !instance->var_alloc_stack_.empty()
+        || !instance->nested_var_stack_sizes_.empty()
+        || instance->static_tape_ != nullptr
+        || instance->memalloc_.bytes_used() != 0) {
+      return;
+    }
+    get_ad_tape_pool(checkout.node_).release(checkout.tape_);
+    checkout.node_ = node;
+    checkout.tape_ = get_ad_tape_pool(node).acquire();
+    ChainableStack::instance_ = checkout.tape_;
+  }
+
+  /**
+   * Fill the AD tape pools with one tape per worker thread of a threadpool
+   * with the given number of threads, one of which is the main thread.
+   * Pinned workers are assigned round robin to the NUMA nodes, so each node
+   * gets its share of the tapes, touched while the calling thread is pinned
+   * to the node such that they are allocated there. Otherwise all tapes go
+   * to the pool of the first node.
+   *
+   * @param num_threads number of threads of the threadpool
+   */
+  static void reserve_tapes(int num_threads) {
+    const std::size_t num_workers = std::max(num_threads - 1, 0);
+    if (internal::tbb_thread_affinity() == thread_affinity::none) {
+      get_ad_tape_pool(0).reserve(num_workers);
+      return;
+    }
+    const std::vector<std::vector<int>>& nodes = internal::numa_node_cpus();
+    const internal::thread_placement placement
+        = internal::current_thread_placement();
+    for (std::size_t node = 0; node < nodes.size(); ++node) {
+      internal::pin_current_thread(nodes[node]);
+      get_ad_tape_pool(node).reserve((num_workers + nodes.size() - 1 - node)
+                                     / nodes.size());
     }
+    internal::restore_thread_placement(placement);
   }
 
  private:
-  ad_map thread_tape_map_;
-  std::mutex thread_tape_map_mutex_;
+  std::unique_ptr<ChainableStack> main_stack_;
 };
 
 namespace {
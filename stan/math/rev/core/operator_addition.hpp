@@ -3,6 +3,7 @@
 
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/prim/err/check_matching_dims.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
 #include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
@@ -51,11 +52,14 @@ namespace math {
  * @return Variable result of adding two variables.
  */
 inline var operator+(const var& a, const var& b) {
-  return make_callback_vari(a.vi_->val_ + b.vi_->val_,
-                            [avi = a.vi_, bvi = b.vi_](const auto& vi) mutable {
-                              avi->adj_ += vi.adj_;
-                              bvi->adj_ += vi.adj_;
-                            });
+  return internal::record_tape_op(
+      tape_op::add_vv,
+      make_callback_vari(a.vi_->val_ + b.vi_->val_,
+                         [avi = a.vi_, bvi = b.vi_](const auto& vi) mutable {
+                           avi->adj_ += vi.adj_;
+                           bvi->adj_ += vi.adj_;
+                         }),
+      a, b);
 }
 
 /**
@@ -75,9 +79,12 @@ inline var operator+(const var& a, Arith b) {
   if (unlikely(b == 0.0)) {
     return a;
   }
-  return make_callback_vari(
-      a.vi_->val_ + b,
-      [avi = a.vi_](const auto& vi) mutable { avi->adj_ += vi.adj_; });
+  return internal::record_tape_op(
+      tape_op::add_vd,
+      make_callback_vari(
+          a.vi_->val_ + b,
+          [avi = a.vi_](const auto& vi) mutable { avi->adj_ += vi.adj_; }),
+      a, b);
 }
 
 /**
@@ -8,6 +8,7 @@
 #include <stan/math/prim/fun/is_any_nan.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/rev/core/std_complex.hpp>
 #include <stan/math/rev/core/operator_addition.hpp>
 #include <stan/math/rev/core/operator_multiplication.hpp>
@@ -59,12 +60,16 @@ namespace math {
  * second.
  */
 inline var operator/(const var& dividend, const var& divisor) {
-  return make_callback_var(
-      dividend.val() / divisor.val(), [dividend, divisor](auto&& vi) {
-        dividend.adj() += vi.adj() / divisor.val();
-        divisor.adj()
-            -= vi.adj() * dividend.val() / (divisor.val() * divisor.val());
-      });
+  return internal::record_tape_op(
+      tape_op::div_vv,
+      make_callback_var(
+          dividend.val() / divisor.val(),
+          [dividend, divisor](auto&& vi) {
+            dividend.adj() += vi.adj() / divisor.val();
+            divisor.adj()
+                -= vi.adj() * dividend.val() / (divisor.val() * divisor.val());
+          }),
+      dividend, divisor);
 }
 
 /**
@@ -85,9 +90,13 @@ inline var operator/(const var& dividend, Arith divisor) {
   if (divisor == 1.0) {
     return dividend;
   }
-  return make_callback_var(
-      dividend.val() / divisor,
-      [dividend, divisor](auto&& vi) { dividend.adj() += vi.adj() / divisor; });
+  return internal::record_tape_op(
+      tape_op::div_vd,
+      make_callback_var(dividend.val() / divisor,
+                        [dividend, divisor](auto&& vi) {
+                          dividend.adj() += vi.adj() / divisor;
+                        }),
+      dividend, divisor);
 }
 
 /**
@@ -104,10 +113,15 @@ inline var operator/(const var& dividend, Arith divisor) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline var operator/(Arith dividend, const var& divisor) {
-  return make_callback_var(
-      dividend / divisor.val(), [dividend, divisor](auto&& vi) {
-        divisor.adj() -= vi.adj() * dividend / (divisor.val() * divisor.val());
-      });
+  return internal::record_tape_op(
+      tape_op::div_dv,
+      make_callback_var(
+          dividend / divisor.val(),
+          [dividend, divisor](auto&& vi) {
+            divisor.adj()
+                -= vi.adj() * dividend / (divisor.val() * divisor.val());
+          }),
+      divisor, dividend);
 }
 
 /**
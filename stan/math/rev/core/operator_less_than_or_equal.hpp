@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_LESS_THAN_OR_EQUAL_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/prim/meta.hpp>
 
 namespace stan {
@@ -25,7 +26,8 @@ namespace math {
  * the second's.
  */
 inline bool operator<=(const var& a, const var& b) {
-  return a.val() <= b.val();
+  return internal::record_tape_guard(tape_guard::le, a.val() <= b.val(), a,
+                                     b);
 }
 
 /**
@@ -40,7 +42,7 @@ inline bool operator<=(const var& a, const var& b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator<=(const var& a, Arith b) {
-  return a.val() <= b;
+  return internal::record_tape_guard(tape_guard::le, a.val() <= b, a, b);
 }
 
 /**
@@ -55,7 +57,7 @@ inline bool operator<=(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator<=(Arith a, const var& b) {
-  return a <= b.val();
+  return internal::record_tape_guard(tape_guard::ge, a <= b.val(), b, a);
 }
 
 }  // namespace math
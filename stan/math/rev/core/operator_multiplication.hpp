@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/rev/core/operator_addition.hpp>
 #include <stan/math/rev/core/operator_subtraction.hpp>
 #include <stan/math/rev/core/operator_plus_equal.hpp>
@@ -74,7 +75,8 @@ class multiply_vd_vari final : public op_vd_vari {
  * @return Variable result of multiplying operands.
  */
 inline var operator*(const var& a, const var& b) {
-  return {new internal::multiply_vv_vari(a.vi_, b.vi_)};
+  return internal::record_tape_op(
+      tape_op::mul_vv, new internal::multiply_vv_vari(a.vi_, b.vi_), a, b);
 }
 
 /**
@@ -94,7 +96,8 @@ inline var operator*(const var& a, Arith b) {
   if (b == 1.0) {
     return a;
   }
-  return {new internal::multiply_vd_vari(a.vi_, b)};
+  return internal::record_tape_op(
+      tape_op::mul_vd, new internal::multiply_vd_vari(a.vi_, b), a, b);
 }
 
 /**
@@ -114,7 +117,8 @@ inline var operator*(Arith a, const var& b) {
   if (a == 1.0) {
     return b;
   }
-  return {new internal::multiply_vd_vari(b.vi_, a)};  // by symmetry
+  return internal::record_tape_op(  // by symmetry
+      tape_op::mul_vd, new internal::multiply_vd_vari(b.vi_, a), b, a);
 }
 
 /**
@@ -4,6 +4,7 @@
 #include <stan/math/rev/core/std_complex.hpp>
 #include <stan/math/rev/core/operator_equal.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/prim/meta.hpp>
 #include <complex>
 
@@ -28,7 +29,8 @@ namespace math {
  * second's.
  */
 inline bool operator!=(const var& a, const var& b) {
-  return a.val() != b.val();
+  return internal::record_tape_guard(tape_guard::ne, a.val() != b.val(), a,
+                                     b);
 }
 
 /**
@@ -43,7 +45,7 @@ inline bool operator!=(const var& a, const var& b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator!=(const var& a, Arith b) {
-  return a.val() != b;
+  return internal::record_tape_guard(tape_guard::ne, a.val() != b, a, b);
 }
 
 /**
@@ -58,7 +60,7 @@ inline bool operator!=(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator!=(Arith a, const var& b) {
-  return a != b.val();
+  return internal::record_tape_guard(tape_guard::ne, a != b.val(), b, a);
 }
 
 /**
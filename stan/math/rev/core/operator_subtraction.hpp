@@ -3,6 +3,7 @@
 
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/rev/core/arena_matrix.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
 #include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
@@ -54,11 +55,14 @@ namespace math {
  * the first.
  */
 inline var operator-(const var& a, const var& b) {
-  return make_callback_vari(a.vi_->val_ - b.vi_->val_,
-                            [avi = a.vi_, bvi = b.vi_](const auto& vi) mutable {
-                              avi->adj_ += vi.adj_;
-                              bvi->adj_ -= vi.adj_;
-                            });
+  return internal::record_tape_op(
+      tape_op::sub_vv,
+      make_callback_vari(a.vi_->val_ - b.vi_->val_,
+                         [avi = a.vi_, bvi = b.vi_](const auto& vi) mutable {
+                           avi->adj_ += vi.adj_;
+                           bvi->adj_ -= vi.adj_;
+                         }),
+      a, b);
 }
 
 /**
@@ -79,9 +83,12 @@ inline var operator-(const var& a, Arith b) {
   if (unlikely(b == 0.0)) {
     return a;
   }
-  return make_callback_vari(
-      a.vi_->val_ - b,
-      [avi = a.vi_](const auto& vi) mutable { avi->adj_ += vi.adj_; });
+  return internal::record_tape_op(
+      tape_op::sub_vd,
+      make_callback_vari(
+          a.vi_->val_ - b,
+          [avi = a.vi_](const auto& vi) mutable { avi->adj_ += vi.adj_; }),
+      a, b);
 }
 
 /**
@@ -99,9 +106,12 @@ inline var operator-(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline var operator-(Arith a, const var& b) {
-  return make_callback_vari(
-      a - b.vi_->val_,
-      [bvi = b.vi_](const auto& vi) mutable { bvi->adj_ -= vi.adj_; });
+  return internal::record_tape_op(
+      tape_op::sub_dv,
+      make_callback_vari(
+          a - b.vi_->val_,
+          [bvi = b.vi_](const auto& vi) mutable { bvi->adj_ -= vi.adj_; }),
+      b, a);
 }
 
 /**
@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_nan.hpp>
@@ -24,7 +25,10 @@ namespace math {
  * @return Reference the result of decrementing this input variable.
  */
 inline var& operator--(var& a) {
-  a = make_callback_var(a.val() - 1.0, [a](auto& vi) { a.adj() += vi.adj(); });
+  a = internal::record_tape_op(
+      tape_op::sub_vd,
+      make_callback_var(a.val() - 1.0, [a](auto& vi) { a.adj() += vi.adj(); }),
+      a, 1.0);
   return a;
 }
 
@@ -41,7 +45,10 @@ inline var& operator--(var& a) {
  */
 inline var operator--(var& a, int /*dummy*/) {
   var temp(a);
-  a = make_callback_var(a.val() - 1.0, [a](auto& vi) { a.adj() += vi.adj(); });
+  a = internal::record_tape_op(
+      tape_op::sub_vd,
+      make_callback_var(a.val() - 1.0, [a](auto& vi) { a.adj() += vi.adj(); }),
+      a, 1.0);
   return temp;
 }
 
@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_nan.hpp>
@@ -20,7 +21,10 @@ namespace math {
  * @return Reference the result of incrementing this input variable.
  */
 inline var& operator++(var& a) {
-  a = make_callback_var(a.val() + 1.0, [a](auto& vi) { a.adj() += vi.adj(); });
+  a = internal::record_tape_op(
+      tape_op::add_vd,
+      make_callback_var(a.val() + 1.0, [a](auto& vi) { a.adj() += vi.adj(); }),
+      a, 1.0);
   return a;
 }
 
@@ -37,7 +41,10 @@ inline var& operator++(var& a) {
  */
 inline var operator++(var& a, int /*dummy*/) {
   var temp(a);
-  a = make_callback_var(a.val() + 1.0, [a](auto& vi) { a.adj() += vi.adj(); });
+  a = internal::record_tape_op(
+      tape_op::add_vd,
+      make_callback_var(a.val() + 1.0, [a](auto& vi) { a.adj() += vi.adj(); }),
+      a, 1.0);
   return temp;
 }
 
@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_nan.hpp>
@@ -35,8 +36,11 @@ namespace math {
  * @return Negation of variable.
  */
 inline var operator-(const var& a) {
-  return make_callback_var(
-      -a.val(), [a](const auto& vi) mutable { a.adj() -= vi.adj(); });
+  return internal::record_tape_op(
+      tape_op::neg,
+      make_callback_var(
+          -a.val(), [a](const auto& vi) mutable { a.adj() -= vi.adj(); }),
+      a);
 }
 
 /**
@@ -3,6 +3,7 @@
 
 #include <stan/math/rev/core/vari.hpp>
 #include <stan/math/rev/core/vv_vari.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
 
 namespace stan {
 namespace math {
@@ -15,7 +16,9 @@ class precomp_vv_vari final : public op_vv_vari {
 
  public:
   precomp_vv_vari(double val, vari* avi, vari* bvi, double da, double db)
-      : op_vv_vari(val, avi, bvi), da_(da), db_(db) {}
+      : op_vv_vari(val, avi, bvi), da_(da), db_(db) {
+    internal::record_tape_vari(tape_op::precomp_vv, this, avi, bvi, da, db);
+  }
   void chain() {
     avi_->adj_ += adj_ * da_;
     bvi_->adj_ += adj_ * db_;
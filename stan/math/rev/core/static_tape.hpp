@@ -0,0 +1,925 @@
+#ifndef STAN_MATH_REV_CORE_STATIC_TAPE_HPP
+#define STAN_MATH_REV_CORE_STATIC_TAPE_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/var.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <tbb/task_arena.h>
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Scalar operations which can be recorded on a `static_tape`. The
+ * suffixes follow the `vv_vari`, `vd_vari` and `dv_vari` naming, where
+ * `v` denotes a `var` operand and `d` a constant `double` operand.
+ * `precomp_vv` holds the partials of a `precomp_vv_vari`.
+ */
+enum class tape_op : unsigned char {
+  add_vv,
+  add_vd,
+  sub_vv,
+  sub_vd,
+  sub_dv,
+  mul_vv,
+  mul_vd,
+  div_vv,
+  div_vd,
+  div_dv,
+  neg,
+  exp,
+  log,
+  sqrt,
+  square,
+  log_sum_exp_vv,
+  log_sum_exp_vd,
+  precomp_vv
+};
+
+/**
+ * Comparisons of `var` values recorded as branch guards on a
+ * `static_tape`.
+ */
+enum class tape_guard : unsigned char { lt, le, gt, ge, eq, ne };
+
+namespace internal {
+
+/**
+ * Return the number of `static_tape`s recording on any thread. The scalar
+ * operations only look for the tape of their thread if it is not zero,
+ * so that they pay for a single load and branch when nothing records.
+ *
+ * @return reference to the number of recording tapes
+ */
+inline std::atomic<int>& num_recording_static_tapes() {
+  static std::atomic<int> num_recording{0};
+  return num_recording;
+}
+
+}  // namespace internal
+
+/**
+ * A record-and-replay tape for scalar functions with fixed control flow.
+ *
+ * While a `static_tape` is recording, the core scalar operations
+ * (arithmetic operators, `exp`, `log`, `sqrt`, `square`, `log_sum_exp`
+ * and `precomp_vv_vari`) write a compact record of themselves in addition
+ * to building the regular expression graph. Comparisons between `var`s are
+ * recorded as guards together with their outcome.
+ *
+ * The records are kept in a structure-of-arrays layout, one contiguous
+ * array per field, and values and adjoints are indexed by slot rather
+ * than held in separately allocated `vari`s. The sweeps walk the records
+ * in order and dispatch on the opcode with a `switch`, without any
+ * virtual call or pointer chasing.
+ *
+ * A recording is complete if every `vari` put on the chaining stack while
+ * recording was produced by a recorded operation. Any other operation (for
+ * instance `lgamma` or a matrix function) leaves the tape incomplete. The
+ * reverse sweep of a complete tape, `grad()`, gives the same adjoints as
+ * calling `chain()` on each recorded `vari`.
+ *
+ * A recording may also have a vector of dependent variables, in which
+ * case `jacobian()` computes their Jacobian with reverse sweeps that carry
+ * a fixed number of adjoints per slot, one for each of several dependent
+ * variables. The sparsity patterns of the Jacobian and of the Hessian can
+ * be read off a complete recording without computing any derivative.
+ *
+ * A complete tape can be replayed for new input values unless it holds
+ * precomputed partials or operations which mark it as not replayable,
+ * such as `floor()`. A replay runs one forward sweep recomputing the values
+ * and one reverse sweep over the stored records. It allocates no memory
+ * and constructs no `vari`. If any of the recorded guards evaluates
+ * differently for the new inputs the control flow has changed, `replay()`
+ * returns `false` and the tape has to be recorded again.
+ *
+ * If `STAN_THREADS` is defined, recordings with at least
+ * `parallel_threshold()` operations are swept in reverse on the TBB
+ * threads, unless the calling thread's arena has a single thread. The
+ * slots are grouped into levels by their distance from the dependent
+ * variable and the adjoints of all slots of a level are computed
+ * concurrently, each one by summing the
+ * contributions of the operations that use it in recording order. As
+ * every adjoint is written by exactly one thread no atomic updates are
+ * needed, and the result does not depend on the number of threads. It
+ * only differs from the serial sweep by the order of the summation.
+ *
+ * `var`s which are not inputs and are not produced by recorded operations
+ * are treated as constants and keep the value they had while recording.
+ * Branches on `value_of(x)` rather than on `var` comparisons cannot be
+ * detected and must not be used in functions recorded on a `static_tape`.
+ *
+ * The sweeps and replays are defined in `static_tape_sweep.hpp`, which is
+ * included by `stan/math/rev/core.hpp` but not by the scalar operations
+ * that record themselves.
+ */
+class static_tape {
+ public:
+  /**
+   * A recorded comparison. The right hand side is the constant `c` if
+   * `b` is -1.
+   */
+  struct guard_record {
+    tape_guard kind;
+    bool outcome;
+    int a;
+    int b;
+    double c;
+  };
+
+  static_tape() = default;
+  static_tape(const static_tape&) = delete;
+  static_tape& operator=(const static_tape&) = delete;
+
+  ~static_tape() { clear(); }
+
+  /**
+   * Return `true` if a recording has been completed.
+   */
+  inline bool is_recorded() const { return recorded_; }
+
+  /**
+   * Return `true` if every chaining `vari` of a completed recording is
+   * on the tape, so that `grad()` can be used.
+   */
+  inline bool is_complete() const { return recorded_ && complete_; }
+
+  /**
+   * Return `true` if a completed recording can be replayed.
+   */
+  inline bool is_replayable() const {
+    return recorded_ && complete_ && replayable_;
+  }
+
+  /**
+   * Return `true` if the Hessian can be computed from a completed
+   * recording, which requires it to be complete and to hold no
+   * precomputed partials, as their second derivatives are unknown.
+   */
+  inline bool is_twice_differentiable() const {
+    return is_complete() && !precomputed_;
+  }
+
+  /**
+   * Return `true` if this tape is currently recording.
+   */
+  inline bool is_recording() const {
+    return ChainableStack::instance_ != nullptr
+           && ChainableStack::instance_->static_tape_ == this;
+  }
+
+  /**
+   * Return the number of inputs of the recording.
+   */
+  inline size_t num_inputs() const { return num_inputs_; }
+
+  /**
+   * Return the number of dependent variables of the recording.
+   */
+  inline size_t num_outputs() const { return outputs_.size(); }
+
+  /**
+   * Return the number of recorded operations.
+   */
+  inline size_t size() const { return op_.size(); }
+
+  /**
+   * Return the number of recorded branch guards.
+   */
+  inline size_t num_guards() const { return guards_.size(); }
+
+  /**
+   * Discard the recording and stop recording if this tape is active.
+   */
+  inline void clear() {
+    end_recording();
+    op_.clear();
+    res_.clear();
+    a_.clear();
+    b_.clear();
+    c_.clear();
+    d_.clear();
+    guards_.clear();
+    val_.clear();
+    adj_.clear();
+    lane_adj_.clear();
+    lane_tan_.clear();
+    hess_.clear();
+    outputs_.clear();
+    slots_.clear();
+    consumer_starts_.clear();
+    consumer_edges_.clear();
+    level_starts_.clear();
+    level_slots_.clear();
+    num_inputs_ = 0;
+    output_ = 0;
+    recorded_ = false;
+    complete_ = true;
+    replayable_ = true;
+    precomputed_ = false;
+  }
+
+  /**
+   * Start recording the operations applied to the specified inputs.
+   * Any previous recording is discarded.
+   *
+   * @tparam EigVec type of Eigen vector of `var`s
+   * @param x independent variables
+   */
+  template <typename EigVec, require_eigen_vector_vt<is_var, EigVec>* = nullptr>
+  inline void start_recording(const EigVec& x) {
+    clear();
+    num_inputs_ = x.size();
+    val_.reserve(num_inputs_);
+    for (Eigen::Index i = 0; i < x.size(); ++i) {
+      slots_.emplace(x.coeff(i).vi_, val_.size());
+      val_.push_back(x.coeff(i).val());
+    }
+    stack_start_ = ChainableStack::instance_->var_stack_.size();
+    if (ChainableStack::instance_->static_tape_ != nullptr) {
+      ChainableStack::instance_->static_tape_->end_recording();
+    }
+    ChainableStack::instance_->static_tape_ = this;
+    internal::num_recording_static_tapes().fetch_add(1);
+  }
+
+  /**
+   * Stop recording and register the dependent variable.
+   *
+   * @param f dependent variable
+   */
+  inline void stop_recording(const var& f) {
+    end_recording();
+    complete_ = ChainableStack::instance_->var_stack_.size()
+                == stack_start_ + op_.size();
+    output_ = slot(f.vi_);
+    outputs_.assign(1, output_);
+    slots_.clear();
+    adj_.resize(val_.size());
+    recorded_ = true;
+  }
+
+  /**
+   * Stop recording and register a vector of dependent variables. Only
+   * Jacobians can be computed from such a recording, the gradient
+   * functions use the first dependent variable.
+   *
+   * @tparam EigVec type of Eigen vector of `var`s
+   * @param f dependent variables
+   */
+  template <typename EigVec, require_eigen_vector_vt<is_var, EigVec>* = nullptr>
+  inline void stop_recording(const EigVec& f) {
+    end_recording();
+    complete_ = ChainableStack::instance_->var_stack_.size()
+                == stack_start_ + op_.size();
+    outputs_.resize(f.size());
+    for (Eigen::Index i = 0; i < f.size(); ++i) {
+      outputs_[i] = slot(f.coeff(i).vi_);
+    }
+    output_ = outputs_.empty() ? 0 : outputs_[0];
+    slots_.clear();
+    adj_.resize(val_.size());
+    recorded_ = true;
+  }
+
+  /**
+   * Mark the current recording as not replayable.
+   */
+  inline void invalidate() { replayable_ = false; }
+
+  /**
+   * Record an operation.
+   *
+   * @param op operation
+   * @param res result of the operation
+   * @param a first operand
+   * @param b second operand or `nullptr` if the operation takes a constant
+   * @param c constant operand or partial with respect to `a`
+   * @param d partial with respect to `b`
+   */
+  inline void push_op(tape_op op, vari* res, vari* a, vari* b, double c,
+                      double d = 0.0) {
+    if (op == tape_op::precomp_vv) {
+      replayable_ = false;
+      precomputed_ = true;
+    }
+    a_.push_back(slot(a));
+    b_.push_back(b == nullptr ? -1 : slot(b));
+    res_.push_back(val_.size());
+    slots_.emplace(res, val_.size());
+    val_.push_back(res->val_);
+    op_.push_back(op);
+    c_.push_back(c);
+    d_.push_back(d);
+  }
+
+  /**
+   * Record the outcome of a comparison.
+   *
+   * @param kind comparison
+   * @param outcome result of the comparison
+   * @param a left hand side
+   * @param b right hand side or `nullptr` if it is the constant `c`
+   * @param c constant right hand side
+   */
+  inline void push_guard(tape_guard kind, bool outcome, vari* a, vari* b,
+                         double c) {
+    const int b_slot = b == nullptr ? -1 : slot(b);
+    guards_.push_back({kind, outcome, slot(a), b_slot, c});
+  }
+
+  /**
+   * Return the minimum number of recorded operations for which the reverse
+   * sweep runs in parallel.
+   */
+  inline size_t parallel_threshold() const { return parallel_threshold_; }
+
+  /**
+   * Set the minimum number of recorded operations for which the reverse
+   * sweep runs in parallel.
+   *
+   * @param n minimum number of operations
+   */
+  inline void set_parallel_threshold(size_t n) { parallel_threshold_ = n; }
+
+  /**
+   * Return `true` if the reverse sweep over the recording runs in parallel
+   * when called from the calling thread. This requires `STAN_THREADS`, at
+   * least `parallel_threshold()` operations and more than one thread in
+   * the current TBB arena, as on a single thread the parallel sweep is
+   * slower than the serial one.
+   */
+  inline bool sweeps_in_parallel() const {
+#ifdef STAN_THREADS
+    return op_.size() >= parallel_threshold_
+           && tbb::this_task_arena::max_concurrency() > 1;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * Compute the gradient at the recorded inputs with a reverse sweep over
+   * the recorded operations.
+   *
+   * @param[out] grad_fx gradient of the dependent variable
+   * @throw std::domain_error if the recording is not complete
+   */
+  inline void grad(Eigen::VectorXd& grad_fx);
+
+  /**
+   * Replay the recording for new inputs.
+   *
+   * @tparam EigVec type of Eigen vector of arithmetic values
+   * @param[in] x new values of the independent variables
+   * @param[out] fx value of the dependent variable
+   * @param[out] grad_fx gradient of the dependent variable
+   * @return `false` if the recording is not replayable or one of the
+   * recorded guards does not hold for `x`, in which case `fx` and
+   * `grad_fx` are left unchanged
+   * @throw std::domain_error if no recording has been made
+   * @throw std::invalid_argument if the size of `x` does not match the
+   * number of recorded inputs
+   */
+  template <typename EigVec,
+            require_eigen_vector_vt<std::is_arithmetic, EigVec>* = nullptr>
+  inline bool replay(const EigVec& x, double& fx, Eigen::VectorXd& grad_fx);
+
+  /**
+   * Compute the Jacobian of the dependent variables at the recorded
+   * inputs. Every reverse sweep propagates the adjoints of `Lanes`
+   * dependent variables at once, so the tape is swept
+   * `ceil(num_outputs() / Lanes)` times.
+   *
+   * @tparam Lanes number of adjoints carried per slot
+   * @param[out] J Jacobian with one row per dependent variable and one
+   * column per input
+   * @throw std::domain_error if the recording is not complete
+   */
+  template <int Lanes = 4>
+  inline void jacobian(Eigen::MatrixXd& J);
+
+  /**
+   * Replay the recording for new inputs and compute the Jacobian of the
+   * dependent variables, see `jacobian()`.
+   *
+   * @tparam Lanes number of adjoints carried per slot
+   * @tparam EigVec type of Eigen vector of arithmetic values
+   * @param[in] x new values of the independent variables
+   * @param[out] fx values of the dependent variables
+   * @param[out] J Jacobian with one row per dependent variable and one
+   * column per input
+   * @return `false` if the recording is not replayable or one of the
+   * recorded guards does not hold for `x`, in which case `fx` and `J`
+   * are left unchanged
+   * @throw std::domain_error if no recording has been made
+   * @throw std::invalid_argument if the size of `x` does not match the
+   * number of recorded inputs
+   */
+  template <int Lanes = 4, typename EigVec,
+            require_eigen_vector_vt<std::is_arithmetic, EigVec>* = nullptr>
+  inline bool replay_jacobian(const EigVec& x, Eigen::VectorXd& fx,
+                              Eigen::MatrixXd& J);
+
+  /**
+   * Compute the gradient and the Hessian of the (first) dependent
+   * variable at the recorded inputs with one second order reverse sweep
+   * over the recorded operations.
+   *
+   * <p>The sweep is the edge pushing algorithm of Gower and Mello (2012).
+   * Along with the adjoints it carries the symmetric second order
+   * adjoints of the pairs of slots, stored sparsely by slot. Each
+   * operation pushes the second order adjoints of its result onto its
+   * operands and adds its own second derivatives, weighted by the
+   * adjoint of its result. Only pairs of slots that interact nonlinearly
+   * are ever stored, so the cost is proportional to the size of the
+   * recording and the number of such pairs rather than to the number of
+   * inputs times the size of the recording.
+   *
+   * @param[out] grad_fx gradient of the dependent variable
+   * @param[out] H Hessian of the dependent variable
+   * @throw std::domain_error if the recording is not twice
+   * differentiable, see `is_twice_differentiable()`
+   */
+  inline void hessian(Eigen::VectorXd& grad_fx, Eigen::MatrixXd& H);
+
+  /**
+   * Compute the gradient and the sparse Hessian of the (first) dependent
+   * variable at the recorded inputs, see
+   * `hessian(Eigen::VectorXd&, Eigen::MatrixXd&)`.
+   *
+   * @param[out] grad_fx gradient of the dependent variable
+   * @param[out] H Hessian of the dependent variable, holding the pairs of
+   * inputs which interact nonlinearly
+   * @throw std::domain_error if the recording is not twice
+   * differentiable, see `is_twice_differentiable()`
+   */
+  inline void hessian(Eigen::VectorXd& grad_fx,
+                      Eigen::SparseMatrix<double>& H);
+
+  /**
+   * Replay the recording for new inputs and compute the gradient and the
+   * Hessian of the (first) dependent variable, see `hessian()`.
+   *
+   * @tparam EigVec type of Eigen vector of arithmetic values
+   * @tparam Hess type of the Hessian, `Eigen::MatrixXd` or
+   * `Eigen::SparseMatrix<double>`
+   * @param[in] x new values of the independent variables
+   * @param[out] fx value of the dependent variable
+   * @param[out] grad_fx gradient of the dependent variable
+   * @param[out] H Hessian of the dependent variable
+   * @return `false` if the recording is not replayable or one of the
+   * recorded guards does not hold for `x`, in which case the outputs
+   * are left unchanged
+   * @throw std::domain_error if the recording is not twice
+   * differentiable, see `is_twice_differentiable()`
+   * @throw std::invalid_argument if the size of `x` does not match the
+   * number of recorded inputs
+   */
+  template <typename EigVec, typename Hess,
+            require_eigen_vector_vt<std::is_arithmetic, EigVec>* = nullptr>
+  inline bool replay_hessian(const EigVec& x, double& fx,
+                             Eigen::VectorXd& grad_fx, Hess& H);
+
+  /**
+   * Compute the products of the Hessian of the (first) dependent
+   * variable at the recorded inputs with the columns of the specified
+   * matrix.
+   *
+   * <p>The recorded operations are differentiated forward in the
+   * direction of each column, and the reverse sweep is differentiated
+   * along with them, which gives the derivative of the gradient in that
+   * direction. The adjoints are the same for all directions and are
+   * computed once, while the tangents and adjoint tangents of `Lanes`
+   * directions are carried per slot, so that the loops over the
+   * directions can be vectorized. Each direction thus costs about as
+   * much as one reverse sweep, without evaluating the function again.
+   *
+   * @tparam Lanes number of directions carried per slot
+   * @param[in] V directions, one per column
+   * @param[out] grad_fx_dot_V products of the gradient of the dependent
+   * variable with the directions
+   * @param[out] HV products of the Hessian of the dependent variable with
+   * the directions, one column per direction
+   * @throw std::invalid_argument if the number of rows of `V` does not
+   * match the number of recorded inputs
+   * @throw std::domain_error if the recording is not twice
+   * differentiable, see `is_twice_differentiable()`
+   */
+  template <int Lanes = 4>
+  inline void hessian_times_vector(const Eigen::MatrixXd& V,
+                                   Eigen::VectorXd& grad_fx_dot_V,
+                                   Eigen::MatrixXd& HV);
+
+  /**
+   * Replay the recording for new inputs and compute the products of the
+   * Hessian of the (first) dependent variable with the specified
+   * directions, see `hessian_times_vector()`.
+   *
+   * @tparam Lanes number of directions carried per slot
+   * @tparam EigVec type of Eigen vector of arithmetic values
+   * @param[in] x new values of the independent variables
+   * @param[in] V directions, one per column
+   * @param[out] fx value of the dependent variable
+   * @param[out] grad_fx_dot_V products of the gradient of the dependent
+   * variable with the directions
+   * @param[out] HV products of the Hessian of the dependent variable with
+   * the directions, one column per direction
+   * @return `false` if the recording is not replayable or one of the
+   * recorded guards does not hold for `x`, in which case the outputs
+   * are left unchanged
+   * @throw std::domain_error if the recording is not twice
+   * differentiable, see `is_twice_differentiable()`
+   * @throw std::invalid_argument if the size of `x` or the number of rows
+   * of `V` does not match the number of recorded inputs
+   */
+  template <int Lanes = 4, typename EigVec,
+            require_eigen_vector_vt<std::is_arithmetic, EigVec>* = nullptr>
+  inline bool replay_hessian_times_vector(const EigVec& x,
+                                          const Eigen::MatrixXd& V,
+                                          double& fx,
+                                          Eigen::VectorXd& grad_fx_dot_V,
+                                          Eigen::MatrixXd& HV);
+
+  /**
+   * Return the sparsity pattern of the Jacobian of the dependent
+   * variables. The sets of inputs each slot depends on are propagated
+   * forward through the recorded operations, so an entry is non-zero if
+   * the dependent variable is computed from the input, even if the
+   * partial happens to be zero at the recorded inputs.
+   *
+   * @return pattern with one row per dependent variable and one column
+   * per input, whose stored entries are all one
+   * @throw std::domain_error if the recording is not complete
+   */
+  inline Eigen::SparseMatrix<double> jacobian_sparsity() const;
+
+  /**
+   * Return the sparsity pattern of the Hessian of the (first) dependent
+   * variable. Every recorded operation which the dependent variable
+   * depends on and which is nonlinear in its operands makes the inputs
+   * of those operands interact, as in the nonlinear interaction domain
+   * propagation of Walther (2008).
+   *
+   * @return symmetric pattern with one row and column per input, whose
+   * stored entries are all one
+   * @throw std::domain_error if the recording is not complete
+   */
+  inline Eigen::SparseMatrix<double> hessian_sparsity() const;
+
+ private:
+  std::vector<tape_op> op_;
+  std::vector<int> res_;
+  std::vector<int> a_;
+  std::vector<int> b_;
+  std::vector<double> c_;
+  std::vector<double> d_;
+  std::vector<guard_record> guards_;
+  std::vector<double> val_;
+  std::vector<double> adj_;
+  std::vector<double> lane_adj_;
+  std::vector<double> lane_tan_;
+  std::vector<std::vector<std::pair<int, double>>> hess_;
+  std::vector<int> outputs_;
+  std::unordered_map<const vari*, int> slots_;
+  std::vector<int> consumer_starts_;
+  std::vector<int> consumer_edges_;
+  std::vector<int> level_starts_;
+  std::vector<int> level_slots_;
+  size_t num_inputs_{0};
+  size_t stack_start_{0};
+  size_t parallel_threshold_{1 << 16};
+  int output_{0};
+  bool recorded_{false};
+  bool complete_{true};
+  bool replayable_{true};
+  bool precomputed_{false};
+
+  /**
+   * Stop recording if this tape is active.
+   */
+  inline void end_recording() {
+    if (is_recording()) {
+      ChainableStack::instance_->static_tape_ = nullptr;
+      internal::num_recording_static_tapes().fetch_sub(1);
+    }
+  }
+
+  /**
+   * Return the index of the specified vari, registering it as a constant
+   * if it has not been seen before.
+   */
+  inline int slot(const vari* vi) {
+    auto it = slots_.find(vi);
+    if (it != slots_.end()) {
+      return it->second;
+    }
+    const int new_slot = val_.size();
+    slots_.emplace(vi, new_slot);
+    val_.push_back(vi->val_);
+    return new_slot;
+  }
+
+  /**
+   * Return the second partial derivative of the `i`th operation with
+   * respect to its operands at positions `pos1` and `pos2`, where 0 is
+   * the first and 1 the second operand.
+   */
+  inline double second_partial(size_t i, int pos1, int pos2) const;
+
+  /**
+   * Add `w` to the second order adjoint of the pair of slots `j` and `k`.
+   */
+  inline void add_second_order(int j, int k, double w);
+
+  /**
+   * Sum the second order adjoints of slot `j` which refer to the same
+   * slot and drop those referring to slots above `last`. The entries are
+   * appended without lookup while sweeping, so one slot may appear
+   * several times, and entries referring to slots whose operation has
+   * been swept are left behind rather than erased.
+   */
+  inline void compact_second_order(int j, int last);
+
+  /**
+   * Run the edge pushing sweep, leaving the adjoints in `adj_` and the
+   * second order adjoints of the pairs of inputs in `hess_`.
+   */
+  inline void edge_pushing_sweep();
+
+  /**
+   * Return the union of two sorted sets of input indices.
+   */
+  static inline std::vector<int> merge_dependencies(
+      const std::vector<int>& u, const std::vector<int>& v);
+
+  /**
+   * Return for every slot the sorted indices of the inputs it is computed
+   * from.
+   */
+  inline std::vector<std::vector<int>> input_dependencies() const;
+
+  /**
+   * Recompute the values for new inputs and check the guards.
+   *
+   * @return `false` if the recording is not replayable or one of the
+   * recorded guards does not hold
+   * @throw std::domain_error if no recording has been made
+   * @throw std::invalid_argument if the size of `x` does not match the
+   * number of recorded inputs
+   */
+  template <typename EigVec>
+  inline bool forward(const EigVec& x);
+
+  inline bool guard_holds(const guard_record& guard) const {
+    const double a = val_[guard.a];
+    const double b = guard.b < 0 ? guard.c : val_[guard.b];
+    switch (guard.kind) {
+      case tape_guard::lt:
+        return (a < b) == guard.outcome;
+      case tape_guard::le:
+        return (a <= b) == guard.outcome;
+      case tape_guard::gt:
+        return (a > b) == guard.outcome;
+      case tape_guard::ge:
+        return (a >= b) == guard.outcome;
+      case tape_guard::eq:
+        return (a == b) == guard.outcome;
+      case tape_guard::ne:
+        return (a != b) == guard.outcome;
+    }
+    return false;
+  }
+
+  /**
+   * Compute the value of the `i`th operation. As `Op` is a compile time
+   * constant the `switch` is resolved by the compiler.
+   */
+  template <tape_op Op>
+  inline void forward_op(size_t i);
+
+  /**
+   * Propagate the adjoint of the `i`th operation to its operands. As `Op`
+   * is a compile time constant the `switch` is resolved by the compiler.
+   */
+  template <tape_op Op>
+  inline void reverse_op(size_t i);
+
+  inline void forward_sweep();
+
+  /**
+   * Return the partial derivative of the `i`th operation with respect to
+   * its first operand if `pos` is 0 and to its second one otherwise.
+   */
+  inline double partial(size_t i, int pos) const;
+
+  /**
+   * Build the lists of operations using each slot and group the slots
+   * which the dependent variable depends on by their distance from it.
+   */
+  inline void build_levels();
+
+  /**
+   * Compute the adjoint of slot `s` from the adjoints of the results of
+   * the operations using it.
+   */
+  inline void gather_adjoint(int s);
+
+  inline void parallel_reverse_sweep();
+
+  /**
+   * Propagate the adjoints of the dependent variables `first, ...,
+   * first + Lanes - 1` at once. The adjoints of slot `s` are stored at
+   * `lane_adj_[s * Lanes, ..., s * Lanes + Lanes - 1]`, so that the loops
+   * over the lanes can be vectorized.
+   */
+  template <int Lanes>
+  inline void reverse_sweep_lanes(size_t first);
+
+  /**
+   * Propagate the tangents of the directions `first, ..., first + cols -
+   * 1` given by the columns of `V` forward through the recorded
+   * operations. The tangents of slot `s` are stored at `lane_tan_[s *
+   * Lanes, ..., s * Lanes + Lanes - 1]`, and unused lanes stay zero.
+   */
+  template <int Lanes>
+  inline void tangent_sweep_lanes(const Eigen::MatrixXd& V,
+                                  Eigen::Index first, Eigen::Index cols);
+
+  /**
+   * Propagate the tangents of the adjoints backwards through the
+   * recorded operations, given the adjoints in `adj_` and the tangents in
+   * `lane_tan_`. The adjoint tangent of an operand receives the adjoint
+   * tangent of the result times the partial, plus the adjoint of the
+   * result times the second partials applied to the operand tangents.
+   */
+  template <int Lanes>
+  inline void second_order_sweep_lanes();
+
+  inline void reverse_sweep();
+};
+
+namespace internal {
+
+/**
+ * Return the `static_tape` recording on the calling thread. The tape of
+ * the thread is only looked up if some tape records, and a thread without
+ * an AD tape never records.
+ *
+ * @return active tape or `nullptr` if none
+ */
+inline static_tape* active_static_tape() {
+  if (likely(num_recording_static_tapes().load(std::memory_order_relaxed)
+             == 0)
+      || ChainableStack::instance_ == nullptr) {
+    return nullptr;
+  }
+  return ChainableStack::instance_->static_tape_;
+}
+
+/**
+ * Record an operation given by its `vari`s on the active `static_tape`, if
+ * any.
+ *
+ * @param op operation
+ * @param res result of the operation
+ * @param a first operand
+ * @param b second operand or `nullptr` if the operation takes a constant
+ * @param c constant operand or partial with respect to `a`
+ * @param d partial with respect to `b`
+ */
+inline void record_tape_vari(tape_op op, vari* res, vari* a, vari* b,
+                             double c, double d = 0.0) {
+  static_tape* tape = active_static_tape();
+  if (unlikely(tape != nullptr)) {
+    tape->push_op(op, res, a, b, c, d);
+  }
+}
+
+/**
+ * Record a unary operation on the active `static_tape`, if any.
+ *
+ * @param op operation
+ * @param res result of the operation
+ * @param a operand
+ * @return `res`
+ */
+inline var record_tape_op(tape_op op, const var& res, const var& a) {
+  static_tape* tape = active_static_tape();
+  if (unlikely(tape != nullptr)) {
+    tape->push_op(op, res.vi_, a.vi_, nullptr, 0.0);
+  }
+  return res;
+}
+
+/**
+ * Record a binary operation of two `var`s on the active `static_tape`, if
+ * any.
+ *
+ * @param op operation
+ * @param res result of the operation
+ * @param a first operand
+ * @param b second operand
+ * @return `res`
+ */
+inline var record_tape_op(tape_op op, const var& res, const var& a,
+                          const var& b) {
+  static_tape* tape = active_static_tape();
+  if (unlikely(tape != nullptr)) {
+    tape->push_op(op, res.vi_, a.vi_, b.vi_, 0.0);
+  }
+  return res;
+}
+
+/**
+ * Record a binary operation of a `var` and a constant on the active
+ * `static_tape`, if any.
+ *
+ * @param op operation
+ * @param res result of the operation
+ * @param a variable operand
+ * @param c constant operand
+ * @return `res`
+ */
+inline var record_tape_op(tape_op op, const var& res, const var& a,
+                          double c) {
+  static_tape* tape = active_static_tape();
+  if (unlikely(tape != nullptr)) {
+    tape->push_op(op, res.vi_, a.vi_, nullptr, c);
+  }
+  return res;
+}
+
+/**
+ * Operations on `var_value`s holding matrices are never recorded.
+ *
+ * @tparam T type of the value
+ * @param res result of the operation
+ * @return `res`
+ */
+template <typename T, require_not_floating_point_t<T>* = nullptr>
+inline const var_value<T>& record_tape_op(tape_op /* op */,
+                                          const var_value<T>& res,
+                                          const var_value<T>& /* a */) {
+  return res;
+}
+
+/**
+ * Record the outcome of a comparison of two `var`s on the active
+ * `static_tape`, if any.
+ *
+ * @param kind comparison
+ * @param outcome result of the comparison
+ * @param a left hand side
+ * @param b right hand side
+ * @return `outcome`
+ */
+inline bool record_tape_guard(tape_guard kind, bool outcome, const var& a,
+                              const var& b) {
+  static_tape* tape = active_static_tape();
+  if (unlikely(tape != nullptr)) {
+    tape->push_guard(kind, outcome, a.vi_, b.vi_, 0.0);
+  }
+  return outcome;
+}
+
+/**
+ * Record the outcome of a comparison of a `var` and a constant on the
+ * active `static_tape`, if any.
+ *
+ * @param kind comparison
+ * @param outcome result of the comparison
+ * @param a left hand side
+ * @param c constant right hand side
+ * @return `outcome`
+ */
+inline bool record_tape_guard(tape_guard kind, bool outcome, const var& a,
+                              double c) {
+  static_tape* tape = active_static_tape();
+  if (unlikely(tape != nullptr)) {
+    tape->push_guard(kind, outcome, a.vi_, nullptr, c);
+  }
+  return outcome;
+}
+
+/**
+ * Mark the active `static_tape`, if any, as not replayable. Used by
+ * operations whose result depends on the values of their operands without
+ * carrying a derivative, such as `floor()`.
+ */
+inline void invalidate_static_tape() {
+  static_tape* tape = active_static_tape();
+  if (unlikely(tape != nullptr)) {
+    tape->invalidate();
+  }
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
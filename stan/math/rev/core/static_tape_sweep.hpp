@@ -0,0 +1,926 @@
+#ifndef STAN_MATH_REV_CORE_STATIC_TAPE_SWEEP_HPP
+#define STAN_MATH_REV_CORE_STATIC_TAPE_SWEEP_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core/static_tape.hpp>
+#include <stan/math/prim/err/check_size_match.hpp>
+#include <stan/math/prim/err/throw_domain_error.hpp>
+#include <stan/math/prim/fun/constants.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/inv_logit.hpp>
+#include <stan/math/prim/fun/log_sum_exp.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+inline void static_tape::grad(Eigen::VectorXd& grad_fx) {
+  if (!is_complete()) {
+    throw_domain_error("static_tape::grad", "recording", "",
+                       "is not complete", "");
+  }
+  reverse_sweep();
+  grad_fx = Eigen::Map<const Eigen::VectorXd>(adj_.data(), num_inputs_);
+}
+
+template <typename EigVec,
+          require_eigen_vector_vt<std::is_arithmetic, EigVec>*>
+inline bool static_tape::replay(const EigVec& x, double& fx,
+                                Eigen::VectorXd& grad_fx) {
+  if (!forward(x)) {
+    return false;
+  }
+  reverse_sweep();
+  fx = val_[output_];
+  grad_fx = Eigen::Map<const Eigen::VectorXd>(adj_.data(), num_inputs_);
+  return true;
+}
+
+template <int Lanes>
+inline void static_tape::jacobian(Eigen::MatrixXd& J) {
+  if (!is_complete()) {
+    throw_domain_error("static_tape::jacobian", "recording", "",
+                       "is not complete", "");
+  }
+  J.resize(outputs_.size(), num_inputs_);
+  lane_adj_.resize(val_.size() * Lanes);
+  for (size_t first = 0; first < outputs_.size(); first += Lanes) {
+    reverse_sweep_lanes<Lanes>(first);
+    const size_t rows = std::min<size_t>(Lanes, outputs_.size() - first);
+    for (size_t i = 0; i < num_inputs_; ++i) {
+      for (size_t l = 0; l < rows; ++l) {
+        J.coeffRef(first + l, i) = lane_adj_[i * Lanes + l];
+      }
+    }
+  }
+}
+
+template <int Lanes, typename EigVec,
+          require_eigen_vector_vt<std::is_arithmetic, EigVec>*>
+inline bool static_tape::replay_jacobian(const EigVec& x, Eigen::VectorXd& fx,
+                                         Eigen::MatrixXd& J) {
+  if (!forward(x)) {
+    return false;
+  }
+  fx.resize(outputs_.size());
+  for (size_t j = 0; j < outputs_.size(); ++j) {
+    fx.coeffRef(j) = val_[outputs_[j]];
+  }
+  jacobian<Lanes>(J);
+  return true;
+}
+
+inline void static_tape::hessian(Eigen::VectorXd& grad_fx, Eigen::MatrixXd& H) {
+  edge_pushing_sweep();
+  grad_fx = Eigen::Map<const Eigen::VectorXd>(adj_.data(), num_inputs_);
+  H.setZero(num_inputs_, num_inputs_);
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    for (const auto& entry : hess_[i]) {
+      H.coeffRef(i, entry.first) = entry.second;
+    }
+  }
+}
+
+inline void static_tape::hessian(Eigen::VectorXd& grad_fx,
+                                 Eigen::SparseMatrix<double>& H) {
+  edge_pushing_sweep();
+  grad_fx = Eigen::Map<const Eigen::VectorXd>(adj_.data(), num_inputs_);
+  std::vector<Eigen::Triplet<double>> entries;
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    for (const auto& entry : hess_[i]) {
+      entries.emplace_back(i, entry.first, entry.second);
+    }
+  }
+  H.resize(num_inputs_, num_inputs_);
+  H.setFromTriplets(entries.begin(), entries.end());
+}
+
+template <typename EigVec, typename Hess,
+          require_eigen_vector_vt<std::is_arithmetic, EigVec>*>
+inline bool static_tape::replay_hessian(const EigVec& x, double& fx,
+                                        Eigen::VectorXd& grad_fx, Hess& H) {
+  if (!is_twice_differentiable()) {
+    throw_domain_error("static_tape::replay_hessian", "recording", "",
+                       "is not twice differentiable", "");
+  }
+  if (!forward(x)) {
+    return false;
+  }
+  fx = val_[output_];
+  hessian(grad_fx, H);
+  return true;
+}
+
+template <int Lanes>
+inline void static_tape::hessian_times_vector(const Eigen::MatrixXd& V,
+                                              Eigen::VectorXd& grad_fx_dot_V,
+                                              Eigen::MatrixXd& HV) {
+  if (!is_twice_differentiable()) {
+    throw_domain_error("static_tape::hessian_times_vector", "recording",
+                       "", "is not twice differentiable", "");
+  }
+  check_size_match("static_tape::hessian_times_vector", "rows of V",
+                   V.rows(), "number of inputs", num_inputs_);
+  reverse_sweep();
+  grad_fx_dot_V.resize(V.cols());
+  HV.resize(num_inputs_, V.cols());
+  lane_tan_.resize(val_.size() * Lanes);
+  lane_adj_.resize(val_.size() * Lanes);
+  for (Eigen::Index first = 0; first < V.cols(); first += Lanes) {
+    const Eigen::Index cols
+        = std::min<Eigen::Index>(Lanes, V.cols() - first);
+    tangent_sweep_lanes<Lanes>(V, first, cols);
+    second_order_sweep_lanes<Lanes>();
+    for (Eigen::Index l = 0; l < cols; ++l) {
+      grad_fx_dot_V.coeffRef(first + l) = lane_tan_[output_ * Lanes + l];
+    }
+    for (size_t i = 0; i < num_inputs_; ++i) {
+      for (Eigen::Index l = 0; l < cols; ++l) {
+        HV.coeffRef(i, first + l) = lane_adj_[i * Lanes + l];
+      }
+    }
+  }
+}
+
+template <int Lanes, typename EigVec,
+          require_eigen_vector_vt<std::is_arithmetic, EigVec>*>
+inline bool static_tape::replay_hessian_times_vector(
+    const EigVec& x, const Eigen::MatrixXd& V, double& fx,
+    Eigen::VectorXd& grad_fx_dot_V, Eigen::MatrixXd& HV) {
+  if (!is_twice_differentiable()) {
+    throw_domain_error("static_tape::replay_hessian_times_vector",
+                       "recording", "", "is not twice differentiable", "");
+  }
+  if (!forward(x)) {
+    return false;
+  }
+  fx = val_[output_];
+  hessian_times_vector<Lanes>(V, grad_fx_dot_V, HV);
+  return true;
+}
+
+inline Eigen::SparseMatrix<double> static_tape::jacobian_sparsity() const {
+  if (!is_complete()) {
+    throw_domain_error("static_tape::jacobian_sparsity", "recording", "",
+                       "is not complete", "");
+  }
+  const std::vector<std::vector<int>> deps = input_dependencies();
+  std::vector<Eigen::Triplet<double>> entries;
+  for (size_t j = 0; j < outputs_.size(); ++j) {
+    for (int i : deps[outputs_[j]]) {
+      entries.emplace_back(j, i, 1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> pattern(outputs_.size(), num_inputs_);
+  pattern.setFromTriplets(entries.begin(), entries.end());
+  return pattern;
+}
+
+inline Eigen::SparseMatrix<double> static_tape::hessian_sparsity() const {
+  if (!is_complete()) {
+    throw_domain_error("static_tape::hessian_sparsity", "recording", "",
+                       "is not complete", "");
+  }
+  const std::vector<std::vector<int>> deps = input_dependencies();
+  std::vector<bool> needed(val_.size(), false);
+  needed[output_] = true;
+  for (size_t i = op_.size(); i-- > 0;) {
+    if (needed[res_[i]]) {
+      needed[a_[i]] = true;
+      if (b_[i] >= 0) {
+        needed[b_[i]] = true;
+      }
+    }
+  }
+  std::vector<std::vector<int>> interactions(num_inputs_);
+  auto interact = [&](const std::vector<int>& u, const std::vector<int>& v) {
+    for (int i : u) {
+      for (int j : v) {
+        interactions[i].push_back(j);
+        interactions[j].push_back(i);
+      }
+    }
+  };
+  for (size_t i = 0; i < op_.size(); ++i) {
+    const bool is_needed = needed[res_[i]];
+    if (!is_needed) {
+      continue;
+    }
+    const std::vector<int>& a = deps[a_[i]];
+    switch (op_[i]) {
+      case tape_op::exp:
+      case tape_op::log:
+      case tape_op::sqrt:
+      case tape_op::square:
+      case tape_op::div_dv:
+      case tape_op::log_sum_exp_vd:
+        interact(a, a);
+        break;
+      case tape_op::mul_vv:
+        interact(a, deps[b_[i]]);
+        break;
+      case tape_op::div_vv:
+        interact(a, deps[b_[i]]);
+        interact(deps[b_[i]], deps[b_[i]]);
+        break;
+      case tape_op::log_sum_exp_vv:
+      case tape_op::precomp_vv: {
+        std::vector<int> ab = merge_dependencies(a, deps[b_[i]]);
+        interact(ab, ab);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  std::vector<Eigen::Triplet<double>> entries;
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    std::sort(interactions[i].begin(), interactions[i].end());
+    interactions[i].erase(
+        std::unique(interactions[i].begin(), interactions[i].end()),
+        interactions[i].end());
+    for (int j : interactions[i]) {
+      entries.emplace_back(i, j, 1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> pattern(num_inputs_, num_inputs_);
+  pattern.setFromTriplets(entries.begin(), entries.end());
+  return pattern;
+}
+
+inline double static_tape::second_partial(size_t i, int pos1, int pos2) const {
+  const double* val = val_.data();
+  const int res = res_[i];
+  const int a = a_[i];
+  const int b = b_[i];
+  const double c = c_[i];
+  switch (op_[i]) {
+    case tape_op::mul_vv:
+      return pos1 != pos2 ? 1.0 : 0.0;
+    case tape_op::div_vv:
+      if (pos1 == 0 && pos2 == 0) {
+        return 0.0;
+      } else if (pos1 != pos2) {
+        return -1.0 / (val[b] * val[b]);
+      }
+      return 2.0 * val[a] / (val[b] * val[b] * val[b]);
+    case tape_op::div_dv:
+      return 2.0 * c / (val[a] * val[a] * val[a]);
+    case tape_op::exp:
+      return val[res];
+    case tape_op::log:
+      return -1.0 / (val[a] * val[a]);
+    case tape_op::sqrt:
+      return -0.25 / (val[res] * val[a]);
+    case tape_op::square:
+      return 2.0;
+    case tape_op::log_sum_exp_vv: {
+      const double p = inv_logit(val[a] - val[b]);
+      return pos1 == pos2 ? p * (1.0 - p) : -p * (1.0 - p);
+    }
+    case tape_op::log_sum_exp_vd: {
+      if (val[res] == NEGATIVE_INFTY) {
+        return 0.0;
+      }
+      const double p = inv_logit(val[a] - c);
+      return p * (1.0 - p);
+    }
+    default:
+      return 0.0;
+  }
+}
+
+inline void static_tape::add_second_order(int j, int k, double w) {
+  if (w == 0.0) {
+    return;
+  }
+  hess_[j].emplace_back(k, w);
+  if (j != k) {
+    hess_[k].emplace_back(j, w);
+  }
+}
+
+inline void static_tape::compact_second_order(int j, int last) {
+  auto& entries = hess_[j];
+  std::sort(entries.begin(), entries.end(),
+            [](const std::pair<int, double>& lhs,
+               const std::pair<int, double>& rhs) {
+              return lhs.first < rhs.first;
+            });
+  size_t n = 0;
+  for (size_t e = 0; e < entries.size() && entries[e].first <= last; ++e) {
+    if (n > 0 && entries[n - 1].first == entries[e].first) {
+      entries[n - 1].second += entries[e].second;
+    } else {
+      entries[n++] = entries[e];
+    }
+  }
+  entries.resize(n);
+}
+
+inline void static_tape::edge_pushing_sweep() {
+  if (!is_twice_differentiable()) {
+    throw_domain_error("static_tape::hessian", "recording", "",
+                       "is not twice differentiable", "");
+  }
+  std::fill(adj_.begin(), adj_.end(), 0.0);
+  adj_[output_] = 1.0;
+  hess_.resize(val_.size());
+  for (auto& row : hess_) {
+    row.clear();
+  }
+  for (size_t i = op_.size(); i-- > 0;) {
+    const int v = res_[i];
+    // the distinct operands and the total partials with respect to them
+    int pred[2] = {a_[i], b_[i]};
+    double d[2] = {partial(i, 0), b_[i] >= 0 ? partial(i, 1) : 0.0};
+    double dd[3] = {second_partial(i, 0, 0), 0.0, 0.0};
+    int num_pred = 1;
+    if (pred[1] == pred[0]) {
+      d[0] += d[1];
+      dd[0] += 2.0 * second_partial(i, 0, 1) + second_partial(i, 1, 1);
+    } else if (pred[1] >= 0) {
+      num_pred = 2;
+      dd[1] = second_partial(i, 0, 1);
+      dd[2] = second_partial(i, 1, 1);
+    }
+
+    // pushing; the slots above v are results of swept operations or
+    // constants, whose second order adjoints are not needed
+    compact_second_order(v, v);
+    for (const auto& edge : hess_[v]) {
+      const int p = edge.first;
+      const double w = edge.second;
+      if (p == v) {
+        add_second_order(pred[0], pred[0], d[0] * d[0] * w);
+        if (num_pred == 2) {
+          add_second_order(pred[0], pred[1], d[0] * d[1] * w);
+          add_second_order(pred[1], pred[1], d[1] * d[1] * w);
+        }
+        continue;
+      }
+      for (int k = 0; k < num_pred; ++k) {
+        add_second_order(pred[k], p, (pred[k] == p ? 2.0 : 1.0) * d[k] * w);
+      }
+    }
+    hess_[v].clear();
+
+    // creating
+    const double g = adj_[v];
+    if (g != 0.0) {
+      add_second_order(pred[0], pred[0], g * dd[0]);
+      if (num_pred == 2) {
+        add_second_order(pred[0], pred[1], g * dd[1]);
+        add_second_order(pred[1], pred[1], g * dd[2]);
+      }
+    }
+
+    // adjoints
+    for (int k = 0; k < num_pred; ++k) {
+      adj_[pred[k]] += g * d[k];
+    }
+  }
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    compact_second_order(i, num_inputs_ - 1);
+  }
+}
+
+inline std::vector<int> static_tape::merge_dependencies(
+    const std::vector<int>& u, const std::vector<int>& v) {
+  std::vector<int> uv;
+  uv.reserve(u.size() + v.size());
+  std::set_union(u.begin(), u.end(), v.begin(), v.end(),
+                 std::back_inserter(uv));
+  return uv;
+}
+
+inline std::vector<std::vector<int>> static_tape::input_dependencies() const {
+  std::vector<std::vector<int>> deps(val_.size());
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    deps[i].push_back(i);
+  }
+  for (size_t i = 0; i < op_.size(); ++i) {
+    deps[res_[i]] = b_[i] < 0 ? deps[a_[i]]
+                              : merge_dependencies(deps[a_[i]], deps[b_[i]]);
+  }
+  return deps;
+}
+
+template <typename EigVec>
+inline bool static_tape::forward(const EigVec& x) {
+  if (!is_recorded()) {
+    throw_domain_error("static_tape::replay", "recording", "",
+                       "has not been made", "");
+  }
+  if (!is_replayable()) {
+    return false;
+  }
+  check_size_match("static_tape::replay", "inputs", x.size(),
+                   "recorded inputs", num_inputs_);
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    val_[i] = x.coeff(i);
+  }
+  forward_sweep();
+  for (const auto& guard : guards_) {
+    if (!guard_holds(guard)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <tape_op Op>
+inline void static_tape::forward_op(size_t i) {
+  double* val = val_.data();
+  const int res = res_[i];
+  const int a = a_[i];
+  const int b = b_[i];
+  const double c = c_[i];
+  switch (Op) {
+    case tape_op::add_vv:
+      val[res] = val[a] + val[b];
+      break;
+    case tape_op::add_vd:
+      val[res] = val[a] + c;
+      break;
+    case tape_op::sub_vv:
+      val[res] = val[a] - val[b];
+      break;
+    case tape_op::sub_vd:
+      val[res] = val[a] - c;
+      break;
+    case tape_op::sub_dv:
+      val[res] = c - val[a];
+      break;
+    case tape_op::mul_vv:
+      val[res] = val[a] * val[b];
+      break;
+    case tape_op::mul_vd:
+      val[res] = val[a] * c;
+      break;
+    case tape_op::div_vv:
+      val[res] = val[a] / val[b];
+      break;
+    case tape_op::div_vd:
+      val[res] = val[a] / c;
+      break;
+    case tape_op::div_dv:
+      val[res] = c / val[a];
+      break;
+    case tape_op::neg:
+      val[res] = -val[a];
+      break;
+    case tape_op::exp:
+      val[res] = std::exp(val[a]);
+      break;
+    case tape_op::log:
+      val[res] = std::log(val[a]);
+      break;
+    case tape_op::sqrt:
+      val[res] = std::sqrt(val[a]);
+      break;
+    case tape_op::square:
+      val[res] = val[a] * val[a];
+      break;
+    case tape_op::log_sum_exp_vv:
+      val[res] = log_sum_exp(val[a], val[b]);
+      break;
+    case tape_op::log_sum_exp_vd:
+      val[res] = log_sum_exp(val[a], c);
+      break;
+    case tape_op::precomp_vv:
+      // values with precomputed partials cannot be recomputed
+      break;
+  }
+}
+
+template <tape_op Op>
+inline void static_tape::reverse_op(size_t i) {
+  const double* val = val_.data();
+  double* adj = adj_.data();
+  const int res = res_[i];
+  const int a = a_[i];
+  const int b = b_[i];
+  const double c = c_[i];
+  const double g = adj[res];
+  switch (Op) {
+    case tape_op::add_vv:
+      adj[a] += g;
+      adj[b] += g;
+      break;
+    case tape_op::add_vd:
+      adj[a] += g;
+      break;
+    case tape_op::sub_vv:
+      adj[a] += g;
+      adj[b] -= g;
+      break;
+    case tape_op::sub_vd:
+      adj[a] += g;
+      break;
+    case tape_op::sub_dv:
+      adj[a] -= g;
+      break;
+    case tape_op::mul_vv:
+      adj[a] += val[b] * g;
+      adj[b] += val[a] * g;
+      break;
+    case tape_op::mul_vd:
+      adj[a] += g * c;
+      break;
+    case tape_op::div_vv:
+      adj[a] += g / val[b];
+      adj[b] -= g * val[a] / (val[b] * val[b]);
+      break;
+    case tape_op::div_vd:
+      adj[a] += g / c;
+      break;
+    case tape_op::div_dv:
+      adj[a] -= g * c / (val[a] * val[a]);
+      break;
+    case tape_op::neg:
+      adj[a] -= g;
+      break;
+    case tape_op::exp:
+      adj[a] += g * val[res];
+      break;
+    case tape_op::log:
+      adj[a] += g / val[a];
+      break;
+    case tape_op::sqrt:
+      adj[a] += g / (2.0 * val[res]);
+      break;
+    case tape_op::square:
+      adj[a] += g * 2.0 * val[a];
+      break;
+    case tape_op::log_sum_exp_vv:
+      adj[a] += g * inv_logit(val[a] - val[b]);
+      adj[b] += g * inv_logit(val[b] - val[a]);
+      break;
+    case tape_op::log_sum_exp_vd:
+      if (val[res] == NEGATIVE_INFTY) {
+        adj[a] += g;
+      } else {
+        adj[a] += g * inv_logit(val[a] - c);
+      }
+      break;
+    case tape_op::precomp_vv:
+      adj[a] += g * c;
+      adj[b] += g * d_[i];
+      break;
+  }
+}
+
+inline void static_tape::forward_sweep() {
+  for (size_t i = 0; i < op_.size(); ++i) {
+    switch (op_[i]) {
+      case tape_op::add_vv:
+        forward_op<tape_op::add_vv>(i);
+        break;
+      case tape_op::add_vd:
+        forward_op<tape_op::add_vd>(i);
+        break;
+      case tape_op::sub_vv:
+        forward_op<tape_op::sub_vv>(i);
+        break;
+      case tape_op::sub_vd:
+        forward_op<tape_op::sub_vd>(i);
+        break;
+      case tape_op::sub_dv:
+        forward_op<tape_op::sub_dv>(i);
+        break;
+      case tape_op::mul_vv:
+        forward_op<tape_op::mul_vv>(i);
+        break;
+      case tape_op::mul_vd:
+        forward_op<tape_op::mul_vd>(i);
+        break;
+      case tape_op::div_vv:
+        forward_op<tape_op::div_vv>(i);
+        break;
+      case tape_op::div_vd:
+        forward_op<tape_op::div_vd>(i);
+        break;
+      case tape_op::div_dv:
+        forward_op<tape_op::div_dv>(i);
+        break;
+      case tape_op::neg:
+        forward_op<tape_op::neg>(i);
+        break;
+      case tape_op::exp:
+        forward_op<tape_op::exp>(i);
+        break;
+      case tape_op::log:
+        forward_op<tape_op::log>(i);
+        break;
+      case tape_op::sqrt:
+        forward_op<tape_op::sqrt>(i);
+        break;
+      case tape_op::square:
+        forward_op<tape_op::square>(i);
+        break;
+      case tape_op::log_sum_exp_vv:
+        forward_op<tape_op::log_sum_exp_vv>(i);
+        break;
+      case tape_op::log_sum_exp_vd:
+        forward_op<tape_op::log_sum_exp_vd>(i);
+        break;
+      case tape_op::precomp_vv:
+        forward_op<tape_op::precomp_vv>(i);
+        break;
+    }
+  }
+}
+
+inline double static_tape::partial(size_t i, int pos) const {
+  const double* val = val_.data();
+  const int res = res_[i];
+  const int a = a_[i];
+  const int b = b_[i];
+  const double c = c_[i];
+  switch (op_[i]) {
+    case tape_op::add_vv:
+    case tape_op::add_vd:
+    case tape_op::sub_vd:
+      return 1.0;
+    case tape_op::sub_vv:
+      return pos == 0 ? 1.0 : -1.0;
+    case tape_op::sub_dv:
+    case tape_op::neg:
+      return -1.0;
+    case tape_op::mul_vv:
+      return pos == 0 ? val[b] : val[a];
+    case tape_op::mul_vd:
+      return c;
+    case tape_op::div_vv:
+      return pos == 0 ? 1.0 / val[b] : -val[a] / (val[b] * val[b]);
+    case tape_op::div_vd:
+      return 1.0 / c;
+    case tape_op::div_dv:
+      return -c / (val[a] * val[a]);
+    case tape_op::exp:
+      return val[res];
+    case tape_op::log:
+      return 1.0 / val[a];
+    case tape_op::sqrt:
+      return 1.0 / (2.0 * val[res]);
+    case tape_op::square:
+      return 2.0 * val[a];
+    case tape_op::log_sum_exp_vv:
+      return pos == 0 ? inv_logit(val[a] - val[b])
+                      : inv_logit(val[b] - val[a]);
+    case tape_op::log_sum_exp_vd:
+      return val[res] == NEGATIVE_INFTY ? 1.0 : inv_logit(val[a] - c);
+    case tape_op::precomp_vv:
+      return pos == 0 ? c : d_[i];
+  }
+  return 0.0;
+}
+
+inline void static_tape::build_levels() {
+  const int num_slots = val_.size();
+  const int num_ops = op_.size();
+  consumer_starts_.assign(num_slots + 1, 0);
+  for (int i = 0; i < num_ops; ++i) {
+    ++consumer_starts_[a_[i] + 1];
+    if (b_[i] >= 0) {
+      ++consumer_starts_[b_[i] + 1];
+    }
+  }
+  for (int s = 0; s < num_slots; ++s) {
+    consumer_starts_[s + 1] += consumer_starts_[s];
+  }
+  consumer_edges_.resize(consumer_starts_[num_slots]);
+  std::vector<int> next(consumer_starts_.begin(), consumer_starts_.end() - 1);
+  for (int i = 0; i < num_ops; ++i) {
+    consumer_edges_[next[a_[i]]++] = 2 * i;
+    if (b_[i] >= 0) {
+      consumer_edges_[next[b_[i]]++] = 2 * i + 1;
+    }
+  }
+
+  std::vector<int> level(num_slots, -1);
+  level[output_] = 0;
+  int num_levels = 1;
+  for (int i = num_ops; i-- > 0;) {
+    const int res_level = level[res_[i]];
+    if (res_level < 0) {
+      continue;
+    }
+    level[a_[i]] = std::max(level[a_[i]], res_level + 1);
+    if (b_[i] >= 0) {
+      level[b_[i]] = std::max(level[b_[i]], res_level + 1);
+    }
+    num_levels = std::max(num_levels, res_level + 2);
+  }
+  level_starts_.assign(num_levels + 1, 0);
+  for (int s = 0; s < num_slots; ++s) {
+    if (level[s] >= 0) {
+      ++level_starts_[level[s] + 1];
+    }
+  }
+  for (int l = 0; l < num_levels; ++l) {
+    level_starts_[l + 1] += level_starts_[l];
+  }
+  level_slots_.resize(level_starts_[num_levels]);
+  next.assign(level_starts_.begin(), level_starts_.end() - 1);
+  for (int s = 0; s < num_slots; ++s) {
+    if (level[s] >= 0) {
+      level_slots_[next[level[s]]++] = s;
+    }
+  }
+}
+
+inline void static_tape::gather_adjoint(int s) {
+  double g = s == output_ ? 1.0 : 0.0;
+  for (int e = consumer_starts_[s]; e < consumer_starts_[s + 1]; ++e) {
+    const int i = consumer_edges_[e] / 2;
+    g += partial(i, consumer_edges_[e] % 2) * adj_[res_[i]];
+  }
+  adj_[s] = g;
+}
+
+inline void static_tape::parallel_reverse_sweep() {
+  if (level_starts_.empty()) {
+    build_levels();
+  }
+  std::fill(adj_.begin(), adj_.end(), 0.0);
+  constexpr int grainsize = 256;
+  for (size_t l = 0; l + 1 < level_starts_.size(); ++l) {
+    const int begin = level_starts_[l];
+    const int end = level_starts_[l + 1];
+    if (end - begin < 2 * grainsize) {
+      for (int k = begin; k < end; ++k) {
+        gather_adjoint(level_slots_[k]);
+      }
+      continue;
+    }
+    tbb::parallel_for(tbb::blocked_range<int>(begin, end, grainsize),
+                      [&](const tbb::blocked_range<int>& r) {
+                        for (int k = r.begin(); k < r.end(); ++k) {
+                          gather_adjoint(level_slots_[k]);
+                        }
+                      });
+  }
+}
+
+template <int Lanes>
+inline void static_tape::reverse_sweep_lanes(size_t first) {
+  double* adj = lane_adj_.data();
+  std::fill(lane_adj_.begin(), lane_adj_.end(), 0.0);
+  for (int l = 0; l < Lanes && first + l < outputs_.size(); ++l) {
+    adj[outputs_[first + l] * Lanes + l] += 1.0;
+  }
+  for (size_t i = op_.size(); i-- > 0;) {
+    const double* g = adj + res_[i] * Lanes;
+    double* adj_a = adj + a_[i] * Lanes;
+    const double partial_a = partial(i, 0);
+    for (int l = 0; l < Lanes; ++l) {
+      adj_a[l] += partial_a * g[l];
+    }
+    if (b_[i] >= 0) {
+      double* adj_b = adj + b_[i] * Lanes;
+      const double partial_b = partial(i, 1);
+      for (int l = 0; l < Lanes; ++l) {
+        adj_b[l] += partial_b * g[l];
+      }
+    }
+  }
+}
+
+template <int Lanes>
+inline void static_tape::tangent_sweep_lanes(const Eigen::MatrixXd& V,
+                                             Eigen::Index first,
+                                             Eigen::Index cols) {
+  double* tan = lane_tan_.data();
+  std::fill(lane_tan_.begin(), lane_tan_.end(), 0.0);
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    for (Eigen::Index l = 0; l < cols; ++l) {
+      tan[i * Lanes + l] = V.coeff(i, first + l);
+    }
+  }
+  for (size_t i = 0; i < op_.size(); ++i) {
+    double* t = tan + res_[i] * Lanes;
+    const double* t_a = tan + a_[i] * Lanes;
+    const double partial_a = partial(i, 0);
+    for (int l = 0; l < Lanes; ++l) {
+      t[l] = partial_a * t_a[l];
+    }
+    if (b_[i] >= 0) {
+      const double* t_b = tan + b_[i] * Lanes;
+      const double partial_b = partial(i, 1);
+      for (int l = 0; l < Lanes; ++l) {
+        t[l] += partial_b * t_b[l];
+      }
+    }
+  }
+}
+
+template <int Lanes>
+inline void static_tape::second_order_sweep_lanes() {
+  const double* tan = lane_tan_.data();
+  double* adj = lane_adj_.data();
+  std::fill(lane_adj_.begin(), lane_adj_.end(), 0.0);
+  for (size_t i = op_.size(); i-- > 0;) {
+    const double g = adj_[res_[i]];
+    const double* g_tan = adj + res_[i] * Lanes;
+    const double* t_a = tan + a_[i] * Lanes;
+    double* adj_a = adj + a_[i] * Lanes;
+    const double partial_a = partial(i, 0);
+    const double h_aa = g * second_partial(i, 0, 0);
+    if (b_[i] < 0) {
+      for (int l = 0; l < Lanes; ++l) {
+        adj_a[l] += partial_a * g_tan[l] + h_aa * t_a[l];
+      }
+      continue;
+    }
+    const double* t_b = tan + b_[i] * Lanes;
+    double* adj_b = adj + b_[i] * Lanes;
+    const double partial_b = partial(i, 1);
+    const double h_ab = g * second_partial(i, 0, 1);
+    const double h_bb = g * second_partial(i, 1, 1);
+    for (int l = 0; l < Lanes; ++l) {
+      adj_a[l] += partial_a * g_tan[l] + h_aa * t_a[l] + h_ab * t_b[l];
+    }
+    for (int l = 0; l < Lanes; ++l) {
+      adj_b[l] += partial_b * g_tan[l] + h_ab * t_a[l] + h_bb * t_b[l];
+    }
+  }
+}
+
+inline void static_tape::reverse_sweep() {
+  if (sweeps_in_parallel()) {
+    parallel_reverse_sweep();
+    return;
+  }
+  std::fill(adj_.begin(), adj_.end(), 0.0);
+  adj_[output_] = 1.0;
+  for (size_t i = op_.size(); i-- > 0;) {
+    switch (op_[i]) {
+      case tape_op::add_vv:
+        reverse_op<tape_op::add_vv>(i);
+        break;
+      case tape_op::add_vd:
+        reverse_op<tape_op::add_vd>(i);
+        break;
+      case tape_op::sub_vv:
+        reverse_op<tape_op::sub_vv>(i);
+        break;
+      case tape_op::sub_vd:
+        reverse_op<tape_op::sub_vd>(i);
+        break;
+      case tape_op::sub_dv:
+        reverse_op<tape_op::sub_dv>(i);
+        break;
+      case tape_op::mul_vv:
+        reverse_op<tape_op::mul_vv>(i);
+        break;
+      case tape_op::mul_vd:
+        reverse_op<tape_op::mul_vd>(i);
+        break;
+      case tape_op::div_vv:
+        reverse_op<tape_op::div_vv>(i);
+        break;
+      case tape_op::div_vd:
+        reverse_op<tape_op::div_vd>(i);
+        break;
+      case tape_op::div_dv:
+        reverse_op<tape_op::div_dv>(i);
+        break;
+      case tape_op::neg:
+        reverse_op<tape_op::neg>(i);
+        break;
+      case tape_op::exp:
+        reverse_op<tape_op::exp>(i);
+        break;
+      case tape_op::log:
+        reverse_op<tape_op::log>(i);
+        break;
+      case tape_op::sqrt:
+        reverse_op<tape_op::sqrt>(i);
+        break;
+      case tape_op::square:
+        reverse_op<tape_op::square>(i);
+        break;
+      case tape_op::log_sum_exp_vv:
+        reverse_op<tape_op::log_sum_exp_vv>(i);
+        break;
+      case tape_op::log_sum_exp_vd:
+        reverse_op<tape_op::log_sum_exp_vd>(i);
+        break;
+      case tape_op::precomp_vv:
+        reverse_op<tape_op::precomp_vv>(i);
+        break;
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -44,7 +44,10 @@ namespace math {
  * @param a Input variable.
  * @return Ceiling of the variable.
  */
-inline var ceil(const var& a) { return var(std::ceil(a.val())); }
+inline var ceil(const var& a) {
+  internal::invalidate_static_tape();
+  return var(std::ceil(a.val()));
+}
 
 template <typename T, require_matrix_t<T>* = nullptr>
 inline auto ceil(const var_value<T>& a) {
@@ -40,9 +40,13 @@ namespace math {
  * @return Exponentiated variable.
  */
 inline var exp(const var& a) {
-  return make_callback_var(std::exp(a.val()), [a](auto& vi) mutable {
-    a.adj() += vi.adj() * vi.val();
-  });
+  return internal::record_tape_op(
+      tape_op::exp,
+      make_callback_var(std::exp(a.val()),
+                        [a](auto& vi) mutable {
+                          a.adj() += vi.adj() * vi.val();
+                        }),
+      a);
 }
 
 /**
@@ -48,11 +48,11 @@ namespace math {
  * @return Absolute value of variable.
  */
 inline var fabs(const var& a) {
-  if (a.val() > 0.0) {
+  if (a > 0.0) {
     return a;
-  } else if (a.val() < 0.0) {
+  } else if (a < 0.0) {
     return -a;
-  } else if (a.val() == 0) {
+  } else if (a == 0) {
     return var(new vari(0));
   } else {
     return make_callback_var(NOT_A_NUMBER,
@@ -90,9 +90,8 @@ class fdim_dv_vari : public op_dv_vari {
  */
 inline var fdim(const var& a, const var& b) {
   // reversed test to get NaN vals automatically in second case
-  return (a.vi_->val_ <= b.vi_->val_)
-             ? var(new vari(0.0))
-             : var(new internal::fdim_vv_vari(a.vi_, b.vi_));
+  return (a <= b) ? var(new vari(0.0))
+                  : var(new internal::fdim_vv_vari(a.vi_, b.vi_));
 }
 
 /**
@@ -109,8 +108,8 @@ inline var fdim(const var& a, const var& b) {
  */
 inline var fdim(double a, const var& b) {
   // reversed test to get NaN vals automatically in second case
-  return a <= b.vi_->val_ ? var(new vari(0.0))
-                          : var(new internal::fdim_dv_vari(a, b.vi_));
+  return a <= b ? var(new vari(0.0))
+                : var(new internal::fdim_dv_vari(a, b.vi_));
 }
 
 /**
@@ -126,8 +125,8 @@ inline var fdim(double a, const var& b) {
  */
 inline var fdim(const var& a, double b) {
   // reversed test to get NaN vals automatically in second case
-  return a.vi_->val_ <= b ? var(new vari(0.0))
-                          : var(new internal::fdim_vd_vari(a.vi_, b));
+  return a <= b ? var(new vari(0.0))
+                : var(new internal::fdim_vd_vari(a.vi_, b));
 }
 
 }  // namespace math
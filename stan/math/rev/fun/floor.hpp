@@ -44,7 +44,10 @@ namespace math {
  * @param a Input variable.
  * @return Floor of the variable.
  */
-inline var floor(const var& a) { return var(std::floor(a.val())); }
+inline var floor(const var& a) {
+  internal::invalidate_static_tape();
+  return var(std::floor(a.val()));
+}
 
 template <typename T, require_eigen_t<T>* = nullptr>
 inline auto floor(const var_value<T>& a) {
@@ -49,10 +49,15 @@ namespace math {
  */
 template <typename T, require_stan_scalar_or_eigen_t<T>* = nullptr>
 inline auto log(const var_value<T>& a) {
-  return make_callback_var(log(a.val()), [a](auto& vi) mutable {
-    as_array_or_scalar(a.adj())
-        += as_array_or_scalar(vi.adj()) / as_array_or_scalar(a.val());
-  });
+  return internal::record_tape_op(
+      tape_op::log,
+      make_callback_var(log(a.val()),
+                        [a](auto& vi) mutable {
+                          as_array_or_scalar(a.adj())
+                              += as_array_or_scalar(vi.adj())
+                                 / as_array_or_scalar(a.val());
+                        }),
+      a);
 }
 
 /**
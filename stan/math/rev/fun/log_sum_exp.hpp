@@ -43,19 +43,25 @@ class log_sum_exp_vd_vari : public op_vd_vari {
  * Returns the log sum of exponentials.
  */
 inline var log_sum_exp(const var& a, const var& b) {
-  return var(new internal::log_sum_exp_vv_vari(a.vi_, b.vi_));
+  return internal::record_tape_op(
+      tape_op::log_sum_exp_vv, new internal::log_sum_exp_vv_vari(a.vi_, b.vi_),
+      a, b);
 }
 /**
  * Returns the log sum of exponentials.
  */
 inline var log_sum_exp(const var& a, double b) {
-  return var(new internal::log_sum_exp_vd_vari(a.vi_, b));
+  return internal::record_tape_op(
+      tape_op::log_sum_exp_vd, new internal::log_sum_exp_vd_vari(a.vi_, b), a,
+      b);
 }
 /**
  * Returns the log sum of exponentials.
  */
 inline var log_sum_exp(double a, const var& b) {
-  return var(new internal::log_sum_exp_vd_vari(b.vi_, a));
+  return internal::record_tape_op(
+      tape_op::log_sum_exp_vd, new internal::log_sum_exp_vd_vari(b.vi_, a), b,
+      a);
 }
 
 /**
@@ -40,7 +40,10 @@ namespace math {
  * @param a Specified variable.
  * @return Rounded variable.
  */
-inline var round(const var& a) { return var(round(a.val())); }
+inline var round(const var& a) {
+  internal::invalidate_static_tape();
+  return var(round(a.val()));
+}
 
 }  // namespace math
 }  // namespace stan
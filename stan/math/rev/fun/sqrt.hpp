@@ -42,9 +42,13 @@ namespace math {
  * @return Square root of variable.
  */
 inline var sqrt(const var& a) {
-  return make_callback_var(std::sqrt(a.val()), [a](auto& vi) mutable {
-    a.adj() += vi.adj() / (2.0 * vi.val());
-  });
+  return internal::record_tape_op(
+      tape_op::sqrt,
+      make_callback_var(std::sqrt(a.val()),
+                        [a](auto& vi) mutable {
+                          a.adj() += vi.adj() / (2.0 * vi.val());
+                        }),
+      a);
 }
 
 /**
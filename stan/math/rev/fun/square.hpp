@@ -33,9 +33,13 @@ namespace math {
  * @return Square of variable.
  */
 inline var square(const var& x) {
-  return make_callback_var(square(x.val()), [x](auto& vi) mutable {
-    x.adj() += vi.adj() * 2.0 * x.val();
-  });
+  return internal::record_tape_op(
+      tape_op::square,
+      make_callback_var(square(x.val()),
+                        [x](auto& vi) mutable {
+                          x.adj() += vi.adj() * 2.0 * x.val();
+                        }),
+      x);
 }
 
 /**
@@ -0,0 +1,174 @@
+#ifndef STAN_MATH_REV_FUNCTOR_CHECKPOINT_HPP
+#define STAN_MATH_REV_FUNCTOR_CHECKPOINT_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/fun/value_of.hpp>
+#include <stan/math/rev/fun/to_arena.hpp>
+#include <stan/math/prim/err/check_positive.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <stan/math/prim/functor/checkpoint.hpp>
+#include <tuple>
+#include <utility>
+
+namespace stan {
+namespace math {
+
+/**
+ * Call the specified function on the specified arguments without keeping
+ * the expression graph of the call in memory until the reverse pass.
+ *
+ * The forward pass evaluates `f` on the values of the arguments and only
+ * stores copies of the arguments on the autodiff arena. The reverse pass
+ * evaluates `f` again with `var`s under nested autodiff, propagates the
+ * adjoints of the result through this recomputed graph to the arguments and
+ * frees the recomputed graph again. This trades a second evaluation of `f`
+ * for the memory of its expression graph.
+ *
+ * `f` must be callable with both `double` and `var` arguments and return a
+ * scalar or an Eigen type. It is copied onto the autodiff arena and hence
+ * must be trivially destructible; lambdas should only capture arithmetic
+ * values or pointers. Calls of `checkpoint` may be nested inside `f`.
+ *
+ * @tparam F type of function
+ * @tparam Args types of arguments
+ * @param f function
+ * @param args arguments
+ * @return `f(args...)`
+ */
+template <typename F, typename... Args,
+          require_any_st_var<Args...>* = nullptr>
+inline auto checkpoint(const F& f, const Args&... args) {
+  using ret_val_t = plain_type_t<decltype(f(value_of(args)...))>;
+  using ret_t = promote_scalar_t<var, ret_val_t>;
+  arena_t<ret_t> ret = ret_val_t(f(value_of(args)...));
+
+  auto arena_args = std::make_tuple(to_arena(args)...);
+  const size_t num_vars = count_vars(args...);
+  vari** varis
+      = ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_vars);
+  save_varis(varis, args...);
+
+  reverse_pass_callback([f, arena_args, ret, varis, num_vars]() mutable {
+    nested_rev_autodiff nested;
+    auto local_args = math::apply(
+        [](const auto&... args) {
+          return std::make_tuple(deep_copy_vars(args)...);
+        },
+        arena_args);
+    ret_t local_ret
+        = math::apply([&f](const auto&... args) { return f(args...); },
+                      local_args);
+    local_ret.adj() = ret.adj();
+    grad();
+    Eigen::VectorXd adjs = Eigen::VectorXd::Zero(num_vars);
+    math::apply(
+        [&adjs](const auto&... args) {
+          accumulate_adjoints(adjs.data(), args...);
+        },
+        local_args);
+    for (size_t i = 0; i < num_vars; ++i) {
+      varis[i]->adj_ += adjs.coeff(i);
+    }
+  });
+  return ret_t(ret);
+}
+
+namespace internal {
+
+template <typename F, typename T, typename... Args,
+          require_all_not_st_var<T, Args...>* = nullptr>
+inline auto checkpoint_range(const F& step, int begin, int end, const T& y,
+                             const Args&... args) {
+  plain_type_t<decltype(step(begin, y, args...))> y_i
+      = step(begin, y, args...);
+  for (int i = begin + 1; i < end; ++i) {
+    y_i = step(i, y_i, args...);
+  }
+  return y_i;
+}
+
+template <typename F, typename T, typename... Args>
+using checkpoint_state_t = promote_scalar_t<
+    var, plain_type_t<decltype(std::declval<const F&>()(
+             0, value_of(std::declval<const T&>()),
+             value_of(std::declval<const Args&>())...))>>;
+
+template <typename F, typename T, typename... Args,
+          require_any_st_var<T, Args...>* = nullptr>
+inline checkpoint_state_t<F, T, Args...> checkpoint_range(
+    const F& step, int begin, int end, const T& y, const Args&... args);
+
+/**
+ * Functor applying the steps `[begin, end)` of a `checkpoint_loop`.
+ */
+template <typename F>
+struct checkpoint_segment {
+  F step_;
+  int begin_;
+  int end_;
+
+  template <typename T, typename... Args>
+  inline auto operator()(const T& y, const Args&... args) const {
+    return checkpoint_range(step_, begin_, end_, y, args...);
+  }
+};
+
+/**
+ * Apply the steps `[begin, end)` of a `checkpoint_loop` by checkpointing
+ * both halves of the range, which in turn split their ranges when they are
+ * recomputed in the reverse pass. A single step is evaluated directly.
+ */
+template <typename F, typename T, typename... Args,
+          require_any_st_var<T, Args...>*>
+inline checkpoint_state_t<F, T, Args...> checkpoint_range(
+    const F& step, int begin, int end, const T& y, const Args&... args) {
+  if (end - begin == 1) {
+    return step(begin, y, args...);
+  }
+  const int mid = begin + (end - begin) / 2;
+  auto y_mid = checkpoint(checkpoint_segment<F>{step, begin, mid}, y, args...);
+  return checkpoint(checkpoint_segment<F>{step, mid, end}, y_mid, args...);
+}
+
+}  // namespace internal
+
+/**
+ * Apply the specified step function `n` times, starting from the state `y0`:
+ * `y_{i + 1} = step(i, y_i, args...)` for `i` in `0, ..., n - 1`, without
+ * keeping the expression graph of the steps in memory until the reverse
+ * pass.
+ *
+ * The steps are checkpointed with a binary schedule: the loop is split into
+ * two halves which are evaluated with `checkpoint()`, and the reverse pass
+ * of each half splits it again, down to single steps. At most
+ * `O(log(n))` states and the expression graph of one step are held at any
+ * time, and every step is evaluated `O(log(n))` times on `double`s and
+ * once on `var`s.
+ *
+ * The state must be a scalar or an Eigen type and `step` must be callable
+ * with both `double` and `var` arguments and be trivially destructible, see
+ * `checkpoint()`.
+ *
+ * @tparam F type of step function
+ * @tparam T type of initial state
+ * @tparam Args types of additional arguments
+ * @param step step function
+ * @param n number of steps
+ * @param y0 initial state
+ * @param args additional arguments passed to every step
+ * @return state after the last step
+ * @throw std::domain_error if `n` is not positive
+ */
+template <typename F, typename T, typename... Args,
+          require_any_st_var<T, Args...>* = nullptr>
+inline auto checkpoint_loop(const F& step, int n, const T& y0,
+                            const Args&... args) {
+  check_positive("checkpoint_loop", "number of steps", n);
+  return internal::checkpoint_range(step, 0, n, y0, to_arena(args)...);
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
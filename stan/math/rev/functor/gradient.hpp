@@ -120,6 +120,77 @@ void gradient(const F& f, const EigVec& x, double& fx, InputIt first_grad_fx,
   }
 }
 
+/**
+ * Calculate the value and the gradient of the specified function
+ * at the specified argument, reusing the expression graph recorded
+ * on the specified tape.
+ *
+ * <p>The first call records the scalar operations of the function on
+ * the tape and computes the gradient with a reverse sweep over the
+ * recorded operations, or with <code>grad()</code> if not every
+ * operation could be recorded. Later calls replay the recording for the
+ * new argument with one forward and one reverse sweep over the recorded
+ * operations, without allocating memory or constructing any
+ * <code>vari</code>. If the control flow of the
+ * function changed for the new argument, as detected by the comparisons
+ * of <code>var</code>s recorded on the tape, the function is evaluated
+ * again and the tape is recorded anew.
+ *
+ * <p>If the function uses operations which cannot be recorded (see
+ * <code>static_tape</code>), the tape is marked as not replayable and
+ * all calls compute the gradient as <code>gradient(f, x, fx,
+ * grad_fx)</code> would until the tape is cleared.
+ *
+ * <p>The functor must implement
+ *
+ * <code>
+ * var
+ * operator()(const
+ * Eigen::Matrix<var, Eigen::Dynamic, 1>&)
+ * </code>
+ *
+ * and the tape must only be used with one function.
+ *
+ * @tparam F Type of function
+ * @param[in, out] tape Tape holding the recording of the function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] grad_fx Gradient of function at argument
+ */
+template <typename F>
+void gradient(static_tape& tape, const F& f,
+              const Eigen::Matrix<double, Eigen::Dynamic, 1>& x, double& fx,
+              Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+  if (tape.is_replayable() && tape.replay(x, fx, grad_fx)) {
+    return;
+  }
+  if (tape.is_recorded() && !tape.is_replayable()) {
+    gradient(f, x, fx, grad_fx);
+    return;
+  }
+  nested_rev_autodiff nested;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  tape.start_recording(x_var);
+  var fx_var;
+  try {
+    fx_var = f(x_var);
+  } catch (...) {
+    tape.clear();
+    throw;
+  }
+  tape.stop_recording(fx_var);
+  fx = fx_var.val();
+  if (tape.is_complete()) {
+    tape.grad(grad_fx);
+    return;
+  }
+  grad_fx.resize(x.size());
+  grad(fx_var.vi_);
+  grad_fx = x_var.adj();
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
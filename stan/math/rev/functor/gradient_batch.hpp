@@ -0,0 +1,86 @@
+#ifndef STAN_MATH_REV_FUNCTOR_GRADIENT_BATCH_HPP
+#define STAN_MATH_REV_FUNCTOR_GRADIENT_BATCH_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/gradient.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/err/check_positive.hpp>
+
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+namespace stan {
+namespace math {
+
+/**
+ * Calculate the values and the gradients of the specified function
+ * at a batch of arguments, which are the columns of a matrix.
+ *
+ * <p>The functor must implement
+ *
+ * <code>
+ * var
+ * operator()(const
+ * Eigen::Matrix<var, Eigen::Dynamic, 1>&)
+ * </code>
+ *
+ * and be safe to call from several threads at once.
+ *
+ * <p>If <code>STAN_THREADS</code> is defined, the arguments are
+ * distributed over the threads of the current TBB arena in chunks of at
+ * least <code>grainsize</code> columns. Every argument is evaluated with
+ * nested autodiff on the AD tape of the thread running it, so a thread
+ * reuses the memory of its tape for all the arguments it evaluates and
+ * no tape is shared between threads. Otherwise the arguments are
+ * evaluated in order on the calling thread. The results do not depend on
+ * the number of threads.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Arguments to function, one per column
+ * @param[out] fx Function applied to each argument
+ * @param[out] grad_fx Gradient of function at each argument, one per
+ * column
+ * @param[in] grainsize Minimal number of arguments evaluated by one task
+ * @throw std::domain_error if grainsize is not positive
+ */
+template <typename F>
+void gradient_batch(
+    const F& f, const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& x,
+    Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& grad_fx,
+    int grainsize = 1) {
+  check_positive("gradient_batch", "grainsize", grainsize);
+  const Eigen::Index num_points = x.cols();
+  fx.resize(num_points);
+  grad_fx.resize(x.rows(), num_points);
+
+  auto evaluate_point = [&](Eigen::Index i) {
+    double* grad_i = grad_fx.col(i).data();
+    gradient(f, x.col(i), fx.coeffRef(i), grad_i, grad_i + x.rows());
+  };
+
+#ifdef STAN_THREADS
+  // task isolation keeps other tasks from running on the AD tape of a
+  // thread while it evaluates an argument, see map_rect_concurrent
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(
+        tbb::blocked_range<Eigen::Index>(0, num_points, grainsize),
+        [&](const tbb::blocked_range<Eigen::Index>& r) {
+          for (Eigen::Index i = r.begin(); i != r.end(); ++i) {
+            evaluate_point(i);
+          }
+        });
+  });
+#else
+  for (Eigen::Index i = 0; i < num_points; ++i) {
+    evaluate_point(i);
+  }
+#endif
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -34,6 +34,68 @@ void jacobian(const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
   J.transposeInPlace();
 }
 
+/**
+ * Calculate the value and the Jacobian of the specified function at the
+ * specified argument, reusing the expression graph recorded on the
+ * specified tape.
+ *
+ * <p>The first call records the scalar operations of the function on the
+ * tape. Instead of one reverse pass per output, the Jacobian is computed
+ * with one reverse sweep over the recorded operations per `Lanes` outputs,
+ * each sweep carrying `Lanes` adjoints per operand. Later calls replay the
+ * recording for the new argument. If the control flow of the function
+ * changed, the tape is recorded anew, see `gradient(static_tape&, ...)`.
+ *
+ * <p>If not every operation could be recorded, this behaves like
+ * <code>jacobian(f, x, fx, J)</code>.
+ *
+ * @tparam Lanes number of outputs propagated per reverse sweep
+ * @tparam F Type of function
+ * @param[in, out] tape Tape holding the recording of the function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] J Jacobian of function at argument
+ */
+template <int Lanes = 4, typename F>
+void jacobian(static_tape& tape, const F& f,
+              const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+              Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+              Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& J) {
+  if (tape.is_replayable() && tape.replay_jacobian<Lanes>(x, fx, J)) {
+    return;
+  }
+  if (tape.is_recorded() && !tape.is_replayable()) {
+    jacobian(f, x, fx, J);
+    return;
+  }
+  nested_rev_autodiff nested;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  tape.start_recording(x_var);
+  Eigen::Matrix<var, Eigen::Dynamic, 1> fx_var;
+  try {
+    fx_var = f(x_var);
+  } catch (...) {
+    tape.clear();
+    throw;
+  }
+  tape.stop_recording(fx_var);
+  fx = fx_var.val();
+  if (tape.is_complete()) {
+    tape.jacobian<Lanes>(J);
+    return;
+  }
+  J.resize(fx_var.size(), x.size());
+  for (int i = 0; i < fx_var.size(); ++i) {
+    if (i > 0) {
+      nested.set_zero_all_adjoints();
+    }
+    grad(fx_var(i).vi_);
+    J.row(i) = x_var.adj();
+  }
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
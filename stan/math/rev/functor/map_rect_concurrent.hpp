@@ -6,12 +6,16 @@
 #include <stan/math/prim/functor/map_rect_concurrent.hpp>
 #include <stan/math/prim/functor/map_rect_reduce.hpp>
 #include <stan/math/prim/functor/map_rect_combine.hpp>
+#include <stan/math/prim/functor/map_rect_schedule.hpp>
 #include <stan/math/rev/core/chainablestack.hpp>
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <vector>
 
 namespace stan {
@@ -36,15 +40,25 @@ map_rect_concurrent(
   std::vector<matrix_d> job_output(num_jobs);
   std::vector<int> world_f_out(num_jobs, 0);
 
-  auto execute_chunk = [&](std::size_t start, std::size_t end) -> void {
-    for (std::size_t i = start; i != end; ++i) {
-      job_output[i] = ReduceF()(shared_params_dbl, value_of(job_params[i]),
-                                x_r[i], x_i[i], msgs);
-      world_f_out[i] = job_output[i].cols();
-    }
+  auto execute_job = [&](std::size_t i) -> void {
+    job_output[i] = ReduceF()(shared_params_dbl, value_of(job_params[i]),
+                              x_r[i], x_i[i], msgs);
+    world_f_out[i] = job_output[i].cols();
   };
 
 #ifdef STAN_THREADS
+  // Jobs are started in the order of decreasing expected cost. Every worker
+  // task repeatedly takes the next chunk of jobs until none is left, so
+  // threads finishing early take over the remaining jobs.
+  map_rect_schedule& schedule = get_map_rect_schedule<call_id, F>();
+  const std::vector<std::size_t> job_order = schedule.job_order(num_jobs);
+  const std::size_t chunk_size = schedule.chunk_size();
+  std::vector<double> job_seconds(num_jobs, 0.0);
+  std::atomic<std::size_t> next_job{0};
+  const std::size_t num_workers = std::min<std::size_t>(
+      tbb::this_task_arena::max_concurrency(),
+      (num_jobs + chunk_size - 1) / chunk_size);
+
   // we must use task isolation as described here:
   // https://software.intel.com/content/www/us/en/develop/documentation/tbb-documentation/top/intel-threading-building-blocks-developer-guide/task-isolation.html
   // this is to ensure that the thread local AD tape ressource is
@@ -52,13 +66,34 @@ map_rect_concurrent(
   // whenever this function is being used itself in a parallel
   // context (like running multiple chains for Stan)
   tbb::this_task_arena::isolate([&] {
-    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_jobs),
-                      [&](const tbb::blocked_range<size_t>& r) {
-                        execute_chunk(r.begin(), r.end());
-                      });
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, num_workers, 1),
+        [&](const tbb::blocked_range<size_t>& r) {
+          for (std::size_t worker = r.begin(); worker != r.end(); ++worker) {
+            for (std::size_t start = next_job.fetch_add(chunk_size);
+                 start < static_cast<std::size_t>(num_jobs);
+                 start = next_job.fetch_add(chunk_size)) {
+              const std::size_t end
+                  = std::min<std::size_t>(start + chunk_size, num_jobs);
+              for (std::size_t k = start; k != end; ++k) {
+                const std::size_t i = job_order[k];
+                const auto job_start = std::chrono::steady_clock::now();
+                execute_job(i);
+                job_seconds[i] = std::chrono::duration<double>(
+                                     std::chrono::steady_clock::now()
+                                     - job_start)
+                                     .count();
+              }
+            }
+          }
+        },
+        tbb::simple_partitioner());
   });
+  schedule.record(job_seconds);
 #else
-  execute_chunk(0, num_jobs);
+  for (int i = 0; i < num_jobs; ++i) {
+    execute_job(i);
+  }
 #endif
 
   // collect results
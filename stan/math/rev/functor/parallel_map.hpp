@@ -0,0 +1,221 @@
+#ifndef STAN_MATH_REV_FUNCTOR_PARALLEL_MAP_HPP
+#define STAN_MATH_REV_FUNCTOR_PARALLEL_MAP_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/functor.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/fun/value_of.hpp>
+
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Builds the result of one element of `parallel_map` from its value, creating
+ * a new `var` for every scalar of the value with `make_var`. The scalars are
+ * visited in the same order as `save_varis()` visits the `var`s of a
+ * container.
+ *
+ * @tparam F Type of functor creating `var`s
+ * @param x value
+ * @param make_var functor called with a value and returning a `var`
+ * @return `var` of `x`
+ */
+template <typename F>
+inline var parallel_map_make_vars(double x, F& make_var) {
+  return make_var(x);
+}
+
+template <typename EigMat, typename F,
+          require_eigen_vt<std::is_arithmetic, EigMat>* = nullptr>
+inline auto parallel_map_make_vars(const EigMat& x, F& make_var) {
+  promote_scalar_t<var, plain_type_t<EigMat>> ret(x.rows(), x.cols());
+  for (Eigen::Index i = 0; i < x.size(); ++i) {
+    ret.coeffRef(i) = make_var(x.coeff(i));
+  }
+  return ret;
+}
+
+template <typename T, typename F>
+inline auto parallel_map_make_vars(const std::vector<T>& x, F& make_var) {
+  std::vector<promote_scalar_t<var, T>> ret;
+  ret.reserve(x.size());
+  for (const auto& x_i : x) {
+    ret.emplace_back(parallel_map_make_vars(x_i, make_var));
+  }
+  return ret;
+}
+
+/**
+ * Var specialization of parallel_map_impl
+ *
+ * @tparam MapFunction Type of map function
+ * @tparam ReturnType Must be var
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ */
+template <typename MapFunction, typename ReturnType, typename Vec,
+          typename... Args>
+struct parallel_map_impl<MapFunction, require_var_t<ReturnType>, ReturnType,
+                         Vec, Args...> {
+  using result_t = parallel_map_result_t<MapFunction, Vec, Args...>;
+  using value_t = plain_type_t<decltype(value_of(std::declval<result_t>()))>;
+
+  /**
+   * Value and Jacobian of the result of `MapFunction` for one element
+   */
+  struct local_result {
+    value_t value_;
+    // Jacobian of the flattened result with respect to the operands
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        jacobian_;
+    std::string msgs_;
+  };
+
+  /**
+   * Call an instance of the function `MapFunction` on every element of an
+   *   input sequence and return the results.
+   *
+   * This specialization is parallelized using tbb and works for reverse
+   *   mode autodiff. Every element is computed with nested autodiff on the
+   *   tape of the thread running it, using copies of its operands. The
+   *   Jacobian of its result with respect to the element of the sliced
+   *   argument and the shared arguments is computed right away, with one
+   *   reverse sweep per scalar of the result, and stored as precomputed
+   *   gradients of the returned `var`s. The sliced argument is not
+   *   flattened; every element can have a result of a different size.
+   *
+   * @param vmapped Vector containing one element per result
+   * @param grainsize Grainsize for tbb
+   * @param[in, out] msgs The print stream for warning messages
+   * @param args Shared arguments used in every call
+   * @return Results for all elements of `vmapped`
+   */
+  inline std::vector<result_t> operator()(Vec&& vmapped, int grainsize,
+                                          std::ostream* msgs,
+                                          Args&&... args) const {
+    const std::size_t num_elements = vmapped.size();
+    const std::size_t num_vars_shared_terms = count_vars(args...);
+    std::vector<local_result> local_results(num_elements);
+
+    // we must use task isolation as described here:
+    // https://software.intel.com/content/www/us/en/develop/documentation/tbb-documentation/top/intel-threading-building-blocks-developer-guide/task-isolation.html
+    // this is to ensure that the thread local AD tape ressource is
+    // not being modified from a different task which may happen
+    // whenever this function is being used itself in a parallel
+    // context (like running multiple chains for Stan)
+    tbb::this_task_arena::isolate([&] {
+      tbb::parallel_for(
+          tbb::blocked_range<std::size_t>(0, num_elements, grainsize),
+          [&](const tbb::blocked_range<std::size_t>& r) {
+            for (std::size_t i = r.begin(); i < r.end(); ++i) {
+              local_results[i] = map_element(vmapped[i], i, args...);
+            }
+          });
+    });
+
+    vari** shared_varis
+        = ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            num_vars_shared_terms);
+    save_varis(shared_varis, args...);
+
+    std::vector<result_t> results;
+    results.reserve(num_elements);
+    for (std::size_t i = 0; i < num_elements; ++i) {
+      local_result& local = local_results[i];
+      const std::size_t num_vars_element = count_vars(vmapped[i]);
+      const std::size_t num_operands
+          = num_vars_element + num_vars_shared_terms;
+      vari** varis = ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+          num_operands);
+      save_varis(varis, vmapped[i]);
+      std::copy(shared_varis, shared_varis + num_vars_shared_terms,
+                varis + num_vars_element);
+      Eigen::Index k = 0;
+      auto make_var = [&](double val) {
+        double* partials
+            = ChainableStack::instance_->memalloc_.alloc_array<double>(
+                num_operands);
+        Eigen::Map<Eigen::RowVectorXd>(partials, num_operands)
+            = local.jacobian_.row(k++);
+        return var(new precomputed_gradients_vari(val, num_operands, varis,
+                                                  partials));
+      };
+      results.emplace_back(parallel_map_make_vars(local.value_, make_var));
+      if (msgs) {
+        *msgs << local.msgs_;
+      }
+    }
+    return results;
+  }
+
+ private:
+  /**
+   * Compute the value and Jacobian of `MapFunction` for one element with
+   *   nested autodiff.
+   *
+   * @tparam T Type of the element of the sliced argument
+   * @param x Element of the sliced argument
+   * @param i Index of the element
+   * @param args Shared arguments
+   * @return Value and Jacobian
+   */
+  template <typename T>
+  static local_result map_element(const T& x, std::size_t i,
+                                  const Args&... args) {
+    local_result local;
+    std::stringstream local_msgs;
+
+    // Initialize nested autodiff stack
+    const nested_rev_autodiff begin_nest;
+
+    // Create nested autodiff copies of all operands that do not point
+    //   back to main autodiff stack
+    auto local_x = deep_copy_vars(x);
+    auto local_args = std::make_tuple(deep_copy_vars(args)...);
+    const std::size_t num_operands = count_vars(local_x, args...);
+
+    result_t local_result_v = math::apply(
+        [&](auto&&... local_args) {
+          return MapFunction()(local_x, i, &local_msgs, local_args...);
+        },
+        local_args);
+
+    const std::size_t num_results = count_vars(local_result_v);
+    std::vector<vari*> result_varis(num_results);
+    save_varis(result_varis.data(), local_result_v);
+
+    local.value_ = value_of(local_result_v);
+    local.jacobian_.resize(num_results, num_operands);
+    local.jacobian_.setZero();
+    for (std::size_t k = 0; k < num_results; ++k) {
+      if (k > 0) {
+        set_zero_all_adjoints_nested();
+      }
+      grad(result_varis[k]);
+      math::apply(
+          [&](auto&&... local_args) {
+            accumulate_adjoints(local.jacobian_.row(k).data(), local_x,
+                                local_args...);
+          },
+          local_args);
+    }
+    local.msgs_ = local_msgs.str();
+    return local;
+  }
+};
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+
+#endif
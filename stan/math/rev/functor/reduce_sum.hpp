@@ -8,6 +8,7 @@
 #include <tbb/task_arena.h>
 #include <tbb/parallel_reduce.h>
 #include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
 
 #include <tuple>
 #include <memory>
@@ -18,6 +19,182 @@ namespace stan {
 namespace math {
 namespace internal {
 
+/**
+ * Returns the number of `var`s in a shared argument of `reduce_sum` whose
+ * adjoints are passed on one by one. A `var_value` containing an Eigen type
+ * has none, as its adjoint is passed on as a whole.
+ *
+ * @tparam T type of the argument
+ * @param x argument
+ * @return number of `var`s
+ */
+template <typename T, require_not_var_matrix_t<T>* = nullptr>
+inline size_t reduce_sum_count_vars(const T& x) {
+  return count_vars(x);
+}
+
+template <typename T, require_var_matrix_t<T>* = nullptr>
+inline size_t reduce_sum_count_vars(const T&) {
+  return 0;
+}
+
+/**
+ * Returns the number of adjoints of a shared argument of `reduce_sum` that
+ * are passed on as a whole, which is the size of a `var_value` containing an
+ * Eigen type and zero for all other arguments.
+ *
+ * @tparam T type of the argument
+ * @param x argument
+ * @return number of adjoints
+ */
+template <typename T, require_not_var_matrix_t<T>* = nullptr>
+inline size_t reduce_sum_count_matrix_adjoints(const T&) {
+  return 0;
+}
+
+template <typename T, require_var_matrix_t<T>* = nullptr>
+inline size_t reduce_sum_count_matrix_adjoints(const T& x) {
+  return x.size();
+}
+
+/**
+ * Saves the varis of the `var`s counted by `reduce_sum_count_vars()`.
+ *
+ * @tparam T type of the argument
+ * @param dest destination
+ * @param x argument
+ * @return pointer past the last saved vari
+ */
+template <typename T, require_not_var_matrix_t<T>* = nullptr>
+inline vari** reduce_sum_save_varis(vari** dest, const T& x) {
+  return save_varis(dest, x);
+}
+
+template <typename T, require_var_matrix_t<T>* = nullptr>
+inline vari** reduce_sum_save_varis(vari** dest, const T&) {
+  return dest;
+}
+
+/**
+ * Adds the adjoints of the `var`s counted by `reduce_sum_count_vars()` to
+ * `dest`.
+ *
+ * @tparam T type of the argument
+ * @param dest destination
+ * @param x argument
+ * @return pointer past the last added adjoint
+ */
+template <typename T, require_not_var_matrix_t<T>* = nullptr>
+inline double* reduce_sum_accumulate_adjoints(double* dest, const T& x) {
+  return accumulate_adjoints(dest, x);
+}
+
+template <typename T, require_var_matrix_t<T>* = nullptr>
+inline double* reduce_sum_accumulate_adjoints(double* dest, const T&) {
+  return dest;
+}
+
+/**
+ * Adds the adjoints counted by `reduce_sum_count_matrix_adjoints()` to `dest`.
+ *
+ * @tparam T type of the argument
+ * @param dest destination
+ * @param x argument
+ * @return pointer past the last added adjoint
+ */
+template <typename T, require_not_var_matrix_t<T>* = nullptr>
+inline double* reduce_sum_accumulate_matrix_adjoints(double* dest,
+                                                     const T&) {
+  return dest;
+}
+
+template <typename T, require_var_matrix_t<T>* = nullptr>
+inline double* reduce_sum_accumulate_matrix_adjoints(double* dest,
+                                                     const T& x) {
+  Eigen::Map<plain_type_t<value_type_t<T>>>(dest, x.rows(), x.cols())
+      += x.adj();
+  return dest + x.size();
+}
+
+/**
+ * Adds the adjoints of all shared arguments to `dest`. The adjoints of
+ * `var`s passed on one by one come first, followed by those of the
+ * `var_value`s containing Eigen types.
+ *
+ * @tparam Args types of the shared arguments
+ * @param dest destination
+ * @param args shared arguments
+ */
+template <typename... Args>
+inline void reduce_sum_accumulate_shared_adjoints(double* dest,
+                                                  const Args&... args) {
+  static_cast<void>(std::initializer_list<int>{
+      (dest = reduce_sum_accumulate_adjoints(dest, args), 0)...});
+  static_cast<void>(std::initializer_list<int>{
+      (dest = reduce_sum_accumulate_matrix_adjoints(dest, args), 0)...});
+}
+
+/**
+ * Returns a tuple holding the argument if it is a `var_value` containing an
+ * Eigen type and an empty tuple otherwise.
+ *
+ * @tparam T type of the argument
+ * @param x argument
+ * @return tuple
+ */
+template <typename T, require_not_var_matrix_t<T>* = nullptr>
+inline std::tuple<> reduce_sum_var_matrix(const T&) {
+  return std::tuple<>();
+}
+
+template <typename T, require_var_matrix_t<T>* = nullptr>
+inline auto reduce_sum_var_matrix(const T& x) {
+  return std::make_tuple(x);
+}
+
+/**
+ * Returns a tuple holding a zero matrix of the size of the argument if it is
+ * a `var_value` containing an Eigen type and an empty tuple otherwise.
+ *
+ * @tparam T type of the argument
+ * @param x argument
+ * @return tuple
+ */
+template <typename T, require_not_var_matrix_t<T>* = nullptr>
+inline std::tuple<> reduce_sum_var_matrix_zero(const T&) {
+  return std::tuple<>();
+}
+
+template <typename T, require_var_matrix_t<T>* = nullptr>
+inline auto reduce_sum_var_matrix_zero(const T& x) {
+  return std::make_tuple(
+      plain_type_t<value_type_t<T>>::Zero(x.rows(), x.cols()).eval());
+}
+
+/**
+ * Creates the result of `reduce_sum` with precomputed gradients.
+ *
+ * @tparam ContainerOperands types of `var_value`s containing Eigen types
+ * @tparam ContainerGradients types of their gradients
+ * @param val value of the sum
+ * @param size number of `var`s in `varis`
+ * @param varis varis of `var`s passed one by one
+ * @param partials gradients with respect to `varis`
+ * @param container_operands `var_value`s containing Eigen types
+ * @param container_gradients gradients with respect to `container_operands`
+ * @return sum
+ */
+template <typename... ContainerOperands, typename... ContainerGradients>
+inline var make_reduce_sum_var(
+    double val, size_t size, vari** varis, double* partials,
+    const std::tuple<ContainerOperands...>& container_operands,
+    const std::tuple<ContainerGradients...>& container_gradients) {
+  return var(new precomputed_gradients_vari_template<
+             std::tuple<arena_t<ContainerOperands>...>,
+             std::tuple<arena_t<ContainerGradients>...>>(
+      val, size, varis, partials, container_operands, container_gradients));
+}
+
 /**
  * Var specialization of reduce_sum_impl
  *
@@ -39,6 +216,12 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
     scoped_args_tuple() : stack_(), args_tuple_holder_(nullptr) {}
   };
 
+  /**
+   * Copies of the shared arguments for every thread taking part in one call
+   */
+  using local_args_tuples_t
+      = tbb::enumerable_thread_specific<scoped_args_tuple>;
+
   /**
    * This struct is used by the TBB to accumulate partial
    *  sums over consecutive ranges of the input. To distribute the workload,
@@ -50,21 +233,28 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
    */
   struct recursive_reducer {
     const size_t num_vars_per_term_;
-    const size_t num_vars_shared_terms_;  // Number of vars in shared arguments
+    // Number of adjoints of shared arguments
+    const size_t num_shared_adjoints_;
+    // If true, adjoints of shared arguments are accumulated per thread
+    const bool thread_local_adjoints_;
     double* sliced_partials_;  // Points to adjoints of the partial calculations
+    local_args_tuples_t* local_args_tuples_;
     Vec vmapped_;
     std::stringstream msgs_;
     std::tuple<Args...> args_tuple_;
-    scoped_args_tuple local_args_tuple_scope_;
     double sum_{0.0};
     Eigen::VectorXd args_adjoints_{0};
 
     template <typename VecT, typename... ArgsT>
-    recursive_reducer(size_t num_vars_per_term, size_t num_vars_shared_terms,
-                      double* sliced_partials, VecT&& vmapped, ArgsT&&... args)
+    recursive_reducer(size_t num_vars_per_term, size_t num_shared_adjoints,
+                      bool thread_local_adjoints, double* sliced_partials,
+                      local_args_tuples_t* local_args_tuples, VecT&& vmapped,
+                      ArgsT&&... args)
         : num_vars_per_term_(num_vars_per_term),
-          num_vars_shared_terms_(num_vars_shared_terms),
+          num_shared_adjoints_(num_shared_adjoints),
+          thread_local_adjoints_(thread_local_adjoints),
           sliced_partials_(sliced_partials),
+          local_args_tuples_(local_args_tuples),
           vmapped_(std::forward<VecT>(vmapped)),
           args_tuple_(std::forward<ArgsT>(args)...) {}
 
@@ -76,21 +266,32 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
      */
     recursive_reducer(recursive_reducer& other, tbb::split)
         : num_vars_per_term_(other.num_vars_per_term_),
-          num_vars_shared_terms_(other.num_vars_shared_terms_),
+          num_shared_adjoints_(other.num_shared_adjoints_),
+          thread_local_adjoints_(other.thread_local_adjoints_),
           sliced_partials_(other.sliced_partials_),
+          local_args_tuples_(other.local_args_tuples_),
           vmapped_(other.vmapped_),
           args_tuple_(other.args_tuple_) {}
 
     /**
      * Compute, using nested autodiff, the value and Jacobian of
      *  `ReduceFunction` called over the range defined by r and accumulate those
-     *  in member variable sum_ (for the value) and args_adjoints_ (for the
-     *  Jacobian). The nested autodiff uses deep copies of the involved operands
-     *  ensuring that no side effects are implied to the adjoints of the input
-     *  operands which reside potentially on a autodiff tape stored in a
-     *  different thread other than the current thread of execution. This
-     * function may be called multiple times per object instantiation (so the
-     * sum_ and args_adjoints_ must be accumulated, not just assigned).
+     *  in member variable sum_ (for the value) and the adjoints of the shared
+     *  arguments (for the Jacobian). The nested autodiff uses copies of the
+     *  shared operands, which are made once per thread and call, ensuring
+     *  that no side effects are implied to the adjoints of the input operands
+     *  which reside potentially on a autodiff tape stored in a different
+     *  thread other than the current thread of execution. The values of
+     *  `var_value`s containing Eigen types are not copied, only their
+     *  adjoints are separate.
+     *
+     * If `thread_local_adjoints_` is true, the adjoints of the copies are
+     *  left to accumulate over all ranges the thread computes and are summed
+     *  once after the reduction. Otherwise they are moved into args_adjoints_
+     *  after every range, so that they are summed in a deterministic order.
+     *  This function may be called multiple times per object instantiation
+     *  (so the sum_ and args_adjoints_ must be accumulated, not just
+     *  assigned).
      *
      * @param r Range over which to compute reduce_sum
      */
@@ -99,33 +300,29 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
         return;
       }
 
-      if (args_adjoints_.size() == 0) {
-        args_adjoints_ = Eigen::VectorXd::Zero(num_vars_shared_terms_);
-      }
+      // Obtain reference to the thread's copy of all shared arguments that do
+      // not point back to main autodiff stack
+      scoped_args_tuple& local_args_tuple_scope = local_args_tuples_->local();
 
-      // Obtain reference to a local copy of all shared arguments that do
-      // not point
-      //   back to main autodiff stack
-
-      if (!local_args_tuple_scope_.args_tuple_holder_) {
-        // shared arguments need to be copied to reducer-specific
+      if (!local_args_tuple_scope.args_tuple_holder_) {
+        // shared arguments need to be copied to thread-specific
         // scope. In this case no need for zeroing adjoints, since the
         // fresh copy has all adjoints set to zero.
-        local_args_tuple_scope_.stack_.execute([&]() {
+        local_args_tuple_scope.stack_.execute([&]() {
           math::apply(
               [&](auto&&... args) {
-                local_args_tuple_scope_.args_tuple_holder_ = std::make_unique<
+                local_args_tuple_scope.args_tuple_holder_ = std::make_unique<
                     typename scoped_args_tuple::args_tuple_t>(
                     deep_copy_vars(args)...);
               },
               args_tuple_);
         });
-      } else {
+      } else if (!thread_local_adjoints_) {
         // set adjoints of shared arguments to zero
-        local_args_tuple_scope_.stack_.execute([] { set_zero_all_adjoints(); });
+        local_args_tuple_scope.stack_.execute([] { set_zero_all_adjoints(); });
       }
 
-      auto& args_tuple_local = *(local_args_tuple_scope_.args_tuple_holder_);
+      auto& args_tuple_local = *(local_args_tuple_scope.args_tuple_holder_);
 
       // Initialize nested autodiff stack
       const nested_rev_autodiff begin_nest;
@@ -157,11 +354,17 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
                           std::move(local_sub_slice));
 
       // Accumulate adjoints of shared_arguments
-      math::apply(
-          [&](auto&&... args) {
-            accumulate_adjoints(args_adjoints_.data(), args...);
-          },
-          args_tuple_local);
+      if (!thread_local_adjoints_) {
+        if (args_adjoints_.size() == 0) {
+          args_adjoints_ = Eigen::VectorXd::Zero(num_shared_adjoints_);
+        }
+        math::apply(
+            [&](auto&&... args) {
+              reduce_sum_accumulate_shared_adjoints(args_adjoints_.data(),
+                                                    args...);
+            },
+            args_tuple_local);
+      }
     }
 
     /**
@@ -214,6 +417,11 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
    *  than or equal to grainsize and accumulate all the partial sums
    *  in the same order. This still may not achieve bitwise reproducibility.
    *
+   * The shared arguments are copied once per thread. With auto partitioning
+   *  their adjoints are also accumulated per thread and only summed once at
+   *  the end, so the cost of the shared arguments does not grow with the
+   *  number of pieces.
+   *
    * @param vmapped Vector containing one element per term of sum
    * @param auto_partitioning Work partitioning style
    * @param grainsize Suggested grainsize for tbb
@@ -230,21 +438,33 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
     const std::size_t num_terms = vmapped.size();
     const std::size_t num_vars_per_term = count_vars(vmapped[0]);
     const std::size_t num_vars_sliced_terms = num_terms * num_vars_per_term;
-    const std::size_t num_vars_shared_terms = count_vars(args...);
+    std::size_t num_vars_shared_terms = 0;
+    std::size_t num_shared_adjoints = 0;
+    static_cast<void>(std::initializer_list<int>{
+        (num_vars_shared_terms += reduce_sum_count_vars(args),
+         num_shared_adjoints += reduce_sum_count_matrix_adjoints(args), 0)...});
+    num_shared_adjoints += num_vars_shared_terms;
 
     vari** varis = ChainableStack::instance_->memalloc_.alloc_array<vari*>(
         num_vars_sliced_terms + num_vars_shared_terms);
     double* partials = ChainableStack::instance_->memalloc_.alloc_array<double>(
         num_vars_sliced_terms + num_vars_shared_terms);
 
-    save_varis(varis, vmapped);
-    save_varis(varis + num_vars_sliced_terms, args...);
+    vari** shared_varis = save_varis(varis, vmapped);
+    static_cast<void>(std::initializer_list<int>{
+        (shared_varis = reduce_sum_save_varis(shared_varis, args), 0)...});
 
     for (size_t i = 0; i < num_vars_sliced_terms; ++i) {
       partials[i] = 0.0;
     }
 
-    recursive_reducer worker(num_vars_per_term, num_vars_shared_terms, partials,
+    auto container_operands = std::tuple_cat(reduce_sum_var_matrix(args)...);
+    auto container_gradients
+        = std::tuple_cat(reduce_sum_var_matrix_zero(args)...);
+
+    local_args_tuples_t local_args_tuples;
+    recursive_reducer worker(num_vars_per_term, num_shared_adjoints,
+                             auto_partitioning, partials, &local_args_tuples,
                              std::forward<Vec>(vmapped),
                              std::forward<Args>(args)...);
 
@@ -266,17 +486,41 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
       }
     });
 
+    if (auto_partitioning) {
+      worker.args_adjoints_ = Eigen::VectorXd::Zero(num_shared_adjoints);
+      for (auto& local_args_tuple_scope : local_args_tuples) {
+        if (local_args_tuple_scope.args_tuple_holder_) {
+          math::apply(
+              [&](auto&&... args) {
+                reduce_sum_accumulate_shared_adjoints(
+                    worker.args_adjoints_.data(), args...);
+              },
+              *local_args_tuple_scope.args_tuple_holder_);
+        }
+      }
+    }
+
     for (size_t i = 0; i < num_vars_shared_terms; ++i) {
       partials[num_vars_sliced_terms + i] = worker.args_adjoints_.coeff(i);
     }
+    const double* matrix_adjoints
+        = worker.args_adjoints_.data() + num_vars_shared_terms;
+    math::for_each(
+        [&matrix_adjoints](auto& grad) {
+          using grad_t = std::decay_t<decltype(grad)>;
+          grad = Eigen::Map<const grad_t>(matrix_adjoints, grad.rows(),
+                                          grad.cols());
+          matrix_adjoints += grad.size();
+        },
+        container_gradients);
 
     if (msgs) {
       *msgs << worker.msgs_.str();
     }
 
-    return var(new precomputed_gradients_vari(
+    return make_reduce_sum_var(
         worker.sum_, num_vars_sliced_terms + num_vars_shared_terms, varis,
-        partials));
+        partials, container_operands, container_gradients);
   }
 };
 }  // namespace internal
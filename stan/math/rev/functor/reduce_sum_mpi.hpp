@@ -0,0 +1,121 @@
+#ifdef STAN_MPI
+
+#ifndef STAN_MATH_REV_FUNCTOR_REDUCE_SUM_MPI_HPP
+#define STAN_MATH_REV_FUNCTOR_REDUCE_SUM_MPI_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/functor.hpp>
+#include <stan/math/prim/fun/num_elements.hpp>
+#include <stan/math/prim/fun/promote_scalar.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/reduce_sum.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Var specialization of reduce_sum_mpi_local
+ *
+ * @tparam ReduceFunction Type of reducer function
+ * @tparam ReturnType Must be var
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ */
+template <typename ReduceFunction, typename ReturnType, typename Vec,
+          typename... Args>
+struct reduce_sum_mpi_local<ReduceFunction, require_var_t<ReturnType>,
+                            ReturnType, Vec, Args...> {
+  /**
+   * Returns the number of adjoints of the shared arguments, which is the
+   *   number of scalars of the shared arguments which are parameters.
+   *
+   * @param args Values of the shared arguments
+   * @return Number of adjoints
+   */
+  static std::size_t num_adjoints(const reduce_sum_mpi_value_t<Args>&... args) {
+    const std::array<std::size_t, sizeof...(Args) + 1> num_vars{
+        {0, (is_var<scalar_type_t<Args>>::value
+                 ? static_cast<std::size_t>(num_elements(args))
+                 : 0)...}};
+    return std::accumulate(num_vars.begin(), num_vars.end(), std::size_t{0});
+  }
+
+  /**
+   * Sums the terms of the slice of the sliced argument held by one rank with
+   *   the local `reduce_sum` and computes the gradient of the partial sum
+   *   with respect to the shared parameters.
+   *
+   * The shared parameters are created from their values on a nested
+   *   autodiff tape, such that the partial sum can be computed on the root
+   *   and the workers alike.
+   *
+   * @param slice Slice of the sliced argument
+   * @param offset Index of the first term of the slice in the sliced argument
+   * @param grainsize Grainsize for tbb
+   * @param[in, out] msgs The print stream for warning messages
+   * @param[out] result Partial sum followed by the adjoints of the shared
+   * arguments, which must be zero initialized
+   * @param args Values of the shared arguments used in every sum term
+   */
+  inline void operator()(const Vec& slice, int offset, int grainsize,
+                         std::ostream* msgs, double* result,
+                         const reduce_sum_mpi_value_t<Args>&... args) const {
+    // Initialize nested autodiff stack
+    const nested_rev_autodiff begin_nest;
+
+    std::tuple<Args...> local_args(
+        promote_scalar<scalar_type_t<Args>>(args)...);
+
+    var partial_sum = math::apply(
+        [&](auto&&... local_args) {
+          return reduce_sum<reduce_sum_mpi_offset<ReduceFunction>>(
+              slice, grainsize, msgs, offset, local_args...);
+        },
+        local_args);
+
+    grad(partial_sum.vi_);
+    result[0] = partial_sum.val();
+    math::apply(
+        [&](auto&&... local_args) {
+          accumulate_adjoints(result + 1, local_args...);
+        },
+        local_args);
+  }
+
+  /**
+   * Returns the sum of terms with the summed adjoints of the shared
+   *   arguments as precomputed gradients.
+   *
+   * @param result Sum of the partial sums of all ranks followed by the
+   * summed adjoints of the shared arguments
+   * @param args Shared arguments used in every sum term
+   * @return Sum of terms
+   */
+  static var combine(const std::vector<double>& result, const Args&... args) {
+    const std::size_t num_vars = count_vars(args...);
+    vari** varis
+        = ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_vars);
+    double* partials
+        = ChainableStack::instance_->memalloc_.alloc_array<double>(num_vars);
+    save_varis(varis, args...);
+    std::copy(result.begin() + 1, result.end(), partials);
+
+    return var(new precomputed_gradients_vari(result[0], num_vars, varis,
+                                              partials));
+  }
+};
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef STAN_MATH_REV_FUNCTOR_SPARSE_JACOBIAN_HPP
+#define STAN_MATH_REV_FUNCTOR_SPARSE_JACOBIAN_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/column_coloring.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Compute the Jacobian with the specified sparsity pattern from an
+ * expression graph built in the specified nested scope. The rows of
+ * the pattern are colored so that rows of one color have no column in
+ * common, and one reverse pass per color propagates the adjoints of
+ * all dependent variables of that color at once.
+ *
+ * @param[in, out] nested scope holding the expression graph
+ * @param[in] x_var independent variables
+ * @param[in] fx_var dependent variables
+ * @param[in] pattern sparsity pattern of the Jacobian
+ * @param[out] fx values of the dependent variables
+ * @param[out] J Jacobian of the dependent variables
+ */
+inline void sparse_jacobian_sweeps(
+    nested_rev_autodiff& nested,
+    const Eigen::Matrix<var, Eigen::Dynamic, 1>& x_var,
+    const Eigen::Matrix<var, Eigen::Dynamic, 1>& fx_var,
+    const Eigen::SparseMatrix<double>& pattern,
+    Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+    Eigen::SparseMatrix<double>& J) {
+  check_size_match("sparse_jacobian", "rows of pattern", pattern.rows(),
+                   "size of function value", fx_var.size());
+  check_size_match("sparse_jacobian", "columns of pattern", pattern.cols(),
+                   "size of argument", x_var.size());
+  fx = fx_var.val();
+  const Eigen::SparseMatrix<double> rows = pattern.transpose();
+  const std::vector<int> color = column_coloring(rows);
+  const int num_colors
+      = color.empty() ? 0 : *std::max_element(color.begin(), color.end()) + 1;
+
+  std::vector<Eigen::Triplet<double>> entries;
+  entries.reserve(pattern.nonZeros());
+  for (int c = 0; c < num_colors; ++c) {
+    nested.set_zero_all_adjoints();
+    for (int i = 0; i < fx_var.size(); ++i) {
+      if (color[i] == c) {
+        fx_var.coeff(i).vi_->adj_ = 1.0;
+      }
+    }
+    grad();
+    for (int i = 0; i < fx_var.size(); ++i) {
+      if (color[i] != c) {
+        continue;
+      }
+      for (Eigen::SparseMatrix<double>::InnerIterator it(rows, i); it; ++it) {
+        entries.emplace_back(i, it.row(), x_var.coeff(it.row()).adj());
+      }
+    }
+  }
+  J.resize(pattern.rows(), pattern.cols());
+  J.setFromTriplets(entries.begin(), entries.end());
+}
+
+}  // namespace internal
+
+/**
+ * Calculate the value and the Jacobian with the specified sparsity
+ * pattern of the specified function at the specified argument.
+ *
+ * <p>The function is evaluated once. The dependent variables are
+ * colored so that no two of the same color depend on the same input,
+ * and one reverse pass per color computes the rows of all dependent
+ * variables of that color. The number of reverse passes is thus the
+ * number of colors rather than the number of dependent variables.
+ *
+ * <p>The functor must implement
+ *
+ * <code>
+ * Eigen::Matrix\<var, Eigen::Dynamic, 1\>
+ * operator()(const
+ * Eigen::Matrix\<var, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for <code>var</code>.
+ * Entries of the Jacobian outside of the pattern are not computed and
+ * must be zero.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[in] pattern sparsity pattern of the Jacobian, whose stored
+ * entries are the structural non-zeros
+ * @param[out] fx Function applied to argument
+ * @param[out] J Jacobian of function at argument, with the sparsity
+ * pattern of `pattern`
+ * @throw std::invalid_argument if the size of the pattern does not
+ * match the sizes of the argument and of the function value
+ */
+template <typename F>
+void sparse_jacobian(const F& f,
+                     const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                     const Eigen::SparseMatrix<double>& pattern,
+                     Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+                     Eigen::SparseMatrix<double>& J) {
+  nested_rev_autodiff nested;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  Eigen::Matrix<var, Eigen::Dynamic, 1> fx_var = f(x_var);
+  internal::sparse_jacobian_sweeps(nested, x_var, fx_var, pattern, fx, J);
+}
+
+/**
+ * Calculate the value and the sparse Jacobian of the specified function
+ * at the specified argument, detecting the sparsity pattern.
+ *
+ * <p>The function is evaluated once while recording it on a
+ * `static_tape`, from which the sparsity pattern is determined, see
+ * `static_tape::jacobian_sparsity()`. The Jacobian is then computed as
+ * by `sparse_jacobian(f, x, pattern, fx, J)`. If the function uses
+ * operations which cannot be recorded, the pattern is taken to be
+ * dense.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] J Jacobian of function at argument
+ */
+template <typename F>
+void sparse_jacobian(const F& f,
+                     const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                     Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+                     Eigen::SparseMatrix<double>& J) {
+  nested_rev_autodiff nested;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  static_tape tape;
+  tape.start_recording(x_var);
+  Eigen::Matrix<var, Eigen::Dynamic, 1> fx_var = f(x_var);
+  tape.stop_recording(fx_var);
+  Eigen::SparseMatrix<double> pattern;
+  if (tape.is_complete()) {
+    pattern = tape.jacobian_sparsity();
+  } else {
+    pattern = Eigen::MatrixXd::Ones(fx_var.size(), x.size()).sparseView();
+  }
+  internal::sparse_jacobian_sweeps(nested, x_var, fx_var, pattern, fx, J);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
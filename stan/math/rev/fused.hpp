@@ -0,0 +1,9 @@
+#ifndef STAN_MATH_REV_FUSED_HPP
+#define STAN_MATH_REV_FUSED_HPP
+
+#include <stan/math/rev/fused/fused_base.hpp>
+#include <stan/math/rev/fused/fuse.hpp>
+#include <stan/math/rev/fused/unary_operation.hpp>
+#include <stan/math/rev/fused/binary_operation.hpp>
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef STAN_MATH_REV_FUSED_BINARY_OPERATION_HPP
+#define STAN_MATH_REV_FUSED_BINARY_OPERATION_HPP
+
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/rev/fused/fuse.hpp>
+#include <stan/math/rev/fused/fused_base.hpp>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+/**
+ * Elementwise binary operation of fused expressions. At most one of the
+ * operands is a scalar.
+ *
+ * @tparam Op operation with static members `val()` for Eigen arrays,
+ * `value()` for scalars and `partial_a()` and `partial_b()`, the
+ * derivatives given the operands and the value
+ * @tparam A type of the first operand expression
+ * @tparam B type of the second operand expression
+ */
+template <typename Op, typename A, typename B>
+class fused_binary : public fused_base<fused_binary<Op, A, B>> {
+  A a_;
+  B b_;
+  double x_{0};
+  double y_{0};
+  double f_{0};
+
+ public:
+  using matrix_t = std::conditional_t<A::is_scalar, typename B::matrix_t,
+                                      typename A::matrix_t>;
+  static constexpr bool is_scalar = false;
+  static constexpr bool has_var = A::has_var || B::has_var;
+  static constexpr bool has_var_value = A::has_var_value || B::has_var_value;
+
+  fused_binary(const char* function, const A& a, const B& b)
+      : a_(a), b_(b) {
+    if (!A::is_scalar && !B::is_scalar) {
+      check_size_match(function, "Rows of ", "a", a.rows(), "rows of ", "b",
+                       b.rows());
+      check_size_match(function, "Columns of ", "a", a.cols(), "columns of ",
+                       "b", b.cols());
+    }
+  }
+
+  inline Eigen::Index rows() const {
+    return A::is_scalar ? b_.rows() : a_.rows();
+  }
+  inline Eigen::Index cols() const {
+    return A::is_scalar ? b_.cols() : a_.cols();
+  }
+  inline void prepare() {
+    a_.prepare();
+    b_.prepare();
+  }
+  inline auto val() const { return Op::val(a_.val(), b_.val()); }
+  inline double forward(Eigen::Index i, Eigen::Index j) {
+    x_ = a_.forward(i, j);
+    y_ = b_.forward(i, j);
+    f_ = Op::value(x_, y_);
+    return f_;
+  }
+  inline void backward(Eigen::Index i, Eigen::Index j, double adj) {
+    a_.backward(i, j, adj * Op::partial_a(x_, y_, f_));
+    b_.backward(i, j, adj * Op::partial_b(x_, y_, f_));
+  }
+};
+
+namespace internal {
+struct fused_add_op {
+  template <typename T1, typename T2>
+  static inline auto val(const T1& x, const T2& y) {
+    return x + y;
+  }
+  static inline double value(double x, double y) { return x + y; }
+  static inline double partial_a(double x, double y, double f) { return 1.0; }
+  static inline double partial_b(double x, double y, double f) { return 1.0; }
+};
+
+struct fused_subtract_op {
+  template <typename T1, typename T2>
+  static inline auto val(const T1& x, const T2& y) {
+    return x - y;
+  }
+  static inline double value(double x, double y) { return x - y; }
+  static inline double partial_a(double x, double y, double f) { return 1.0; }
+  static inline double partial_b(double x, double y, double f) {
+    return -1.0;
+  }
+};
+
+struct fused_multiply_op {
+  template <typename T1, typename T2>
+  static inline auto val(const T1& x, const T2& y) {
+    return x * y;
+  }
+  static inline double value(double x, double y) { return x * y; }
+  static inline double partial_a(double x, double y, double f) { return y; }
+  static inline double partial_b(double x, double y, double f) { return x; }
+};
+
+struct fused_divide_op {
+  template <typename T1, typename T2>
+  static inline auto val(const T1& x, const T2& y) {
+    return x / y;
+  }
+  static inline double value(double x, double y) { return x / y; }
+  static inline double partial_a(double x, double y, double f) {
+    return 1.0 / y;
+  }
+  static inline double partial_b(double x, double y, double f) {
+    return -f / y;
+  }
+};
+
+template <typename Op, typename T1, typename T2>
+inline auto make_fused_binary(const char* function, const T1& a,
+                              const T2& b) {
+  using A = std::decay_t<decltype(as_fused_operand(a))>;
+  using B = std::decay_t<decltype(as_fused_operand(b))>;
+  return fused_binary<Op, A, B>(function, as_fused_operand(a),
+                                as_fused_operand(b));
+}
+}  // namespace internal
+
+/**
+ * Return the elementwise sum of the operands, at least one of which is a
+ * fused expression and the other a fused expression or a scalar.
+ *
+ * @tparam T1 type of the first operand
+ * @tparam T2 type of the second operand
+ * @param a first operand
+ * @param b second operand
+ * @return fused expression of the sum
+ * @throw std::invalid_argument if the dimensions of the operands do not
+ * match
+ */
+template <typename T1, typename T2,
+          require_any_fused_expression_t<T1, T2>* = nullptr,
+          require_all_fused_operand_t<T1, T2>* = nullptr>
+inline auto operator+(const T1& a, const T2& b) {
+  return internal::make_fused_binary<internal::fused_add_op>("operator+", a,
+                                                              b);
+}
+
+/**
+ * Return the elementwise difference of the operands, at least one of
+ * which is a fused expression and the other a fused expression or a
+ * scalar.
+ *
+ * @tparam T1 type of the first operand
+ * @tparam T2 type of the second operand
+ * @param a first operand
+ * @param b second operand
+ * @return fused expression of the difference
+ * @throw std::invalid_argument if the dimensions of the operands do not
+ * match
+ */
+template <typename T1, typename T2,
+          require_any_fused_expression_t<T1, T2>* = nullptr,
+          require_all_fused_operand_t<T1, T2>* = nullptr>
+inline auto operator-(const T1& a, const T2& b) {
+  return internal::make_fused_binary<internal::fused_subtract_op>(
+      "operator-", a, b);
+}
+
+/**
+ * Return the elementwise product of the operands, at least one of which
+ * is a fused expression and the other a fused expression or a scalar.
+ *
+ * @tparam T1 type of the first operand
+ * @tparam T2 type of the second operand
+ * @param a first operand
+ * @param b second operand
+ * @return fused expression of the product
+ * @throw std::invalid_argument if the dimensions of the operands do not
+ * match
+ */
+template <typename T1, typename T2,
+          require_any_fused_expression_t<T1, T2>* = nullptr,
+          require_all_fused_operand_t<T1, T2>* = nullptr>
+inline auto elt_multiply(const T1& a, const T2& b) {
+  return internal::make_fused_binary<internal::fused_multiply_op>(
+      "elt_multiply", a, b);
+}
+
+/**
+ * Return the elementwise quotient of the operands, at least one of which
+ * is a fused expression and the other a fused expression or a scalar.
+ *
+ * @tparam T1 type of the first operand
+ * @tparam T2 type of the second operand
+ * @param a first operand
+ * @param b second operand
+ * @return fused expression of the quotient
+ * @throw std::invalid_argument if the dimensions of the operands do not
+ * match
+ */
+template <typename T1, typename T2,
+          require_any_fused_expression_t<T1, T2>* = nullptr,
+          require_all_fused_operand_t<T1, T2>* = nullptr>
+inline auto elt_divide(const T1& a, const T2& b) {
+  return internal::make_fused_binary<internal::fused_divide_op>("elt_divide",
+                                                                 a, b);
+}
+
+/**
+ * Return the product of a fused expression and a scalar. Products of two
+ * fused expressions are written with `elt_multiply()`, as for matrices.
+ *
+ * @tparam T1 type of the first operand
+ * @tparam T2 type of the second operand
+ * @param a first operand
+ * @param b second operand
+ * @return fused expression of the product
+ */
+template <typename T1, typename T2,
+          require_any_fused_expression_t<T1, T2>* = nullptr,
+          require_any_arithmetic_t<T1, T2>* = nullptr>
+inline auto operator*(const T1& a, const T2& b) {
+  return elt_multiply(a, b);
+}
+
+/**
+ * Return the quotient of a fused expression and a scalar, or of a scalar
+ * and a fused expression. Quotients of two fused expressions are written
+ * with `elt_divide()`, as for matrices.
+ *
+ * @tparam T1 type of the first operand
+ * @tparam T2 type of the second operand
+ * @param a first operand
+ * @param b second operand
+ * @return fused expression of the quotient
+ */
+template <typename T1, typename T2,
+          require_any_fused_expression_t<T1, T2>* = nullptr,
+          require_any_arithmetic_t<T1, T2>* = nullptr>
+inline auto operator/(const T1& a, const T2& b) {
+  return elt_divide(a, b);
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef STAN_MATH_REV_FUSED_FUSE_HPP
+#define STAN_MATH_REV_FUSED_FUSE_HPP
+
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/fused/fused_base.hpp>
+
+namespace stan {
+namespace math {
+
+/**
+ * Leaf of a fused expression referring to the values and adjoints of a
+ * reverse mode matrix.
+ *
+ * @tparam T type of the matrix on the autodiff arena, a `var_value` of an
+ * Eigen matrix or an `arena_matrix` of `var`s
+ */
+template <typename T>
+class fused_var : public fused_base<fused_var<T>> {
+  T arena_;
+
+ public:
+  using matrix_t = Eigen::Matrix<double, T::RowsAtCompileTime,
+                                 T::ColsAtCompileTime>;
+  static constexpr bool is_scalar = false;
+  static constexpr bool has_var = true;
+  static constexpr bool has_var_value = is_var_matrix<T>::value;
+
+  template <typename S>
+  explicit fused_var(const S& x) : arena_(x) {}
+
+  inline Eigen::Index rows() const { return arena_.rows(); }
+  inline Eigen::Index cols() const { return arena_.cols(); }
+  inline void prepare() {}
+  inline auto val() const { return arena_.val().array(); }
+  inline double forward(Eigen::Index i, Eigen::Index j) {
+    return arena_.val().coeff(i, j);
+  }
+  inline void backward(Eigen::Index i, Eigen::Index j, double adj) {
+    arena_.adj().coeffRef(i, j) += adj;
+  }
+};
+
+/**
+ * Leaf of a fused expression referring to a matrix of data.
+ *
+ * @tparam T type of the matrix on the autodiff arena
+ */
+template <typename T>
+class fused_data : public fused_base<fused_data<T>> {
+  T arena_;
+
+ public:
+  using matrix_t = Eigen::Matrix<double, T::RowsAtCompileTime,
+                                 T::ColsAtCompileTime>;
+  static constexpr bool is_scalar = false;
+  static constexpr bool has_var = false;
+  static constexpr bool has_var_value = false;
+
+  template <typename S>
+  explicit fused_data(const S& x) : arena_(x) {}
+
+  inline Eigen::Index rows() const { return arena_.rows(); }
+  inline Eigen::Index cols() const { return arena_.cols(); }
+  inline void prepare() {}
+  inline auto val() const { return arena_.array(); }
+  inline double forward(Eigen::Index i, Eigen::Index j) {
+    return arena_.coeff(i, j);
+  }
+  inline void backward(Eigen::Index i, Eigen::Index j, double adj) {}
+};
+
+/**
+ * Leaf of a fused expression holding a scalar constant, which is
+ * broadcast to the size of the other operand.
+ */
+class fused_scalar : public fused_base<fused_scalar> {
+  double c_;
+
+ public:
+  using matrix_t = void;
+  static constexpr bool is_scalar = true;
+  static constexpr bool has_var = false;
+  static constexpr bool has_var_value = false;
+
+  explicit fused_scalar(double c) : c_(c) {}
+
+  inline Eigen::Index rows() const { return 1; }
+  inline Eigen::Index cols() const { return 1; }
+  inline void prepare() {}
+  inline double val() const { return c_; }
+  inline double forward(Eigen::Index i, Eigen::Index j) { return c_; }
+  inline void backward(Eigen::Index i, Eigen::Index j, double adj) {}
+};
+
+/**
+ * Start a fused expression with a reverse mode matrix. The matrix is
+ * moved to the autodiff arena unless it is a `var_value` already.
+ *
+ * @tparam T type of the matrix
+ * @param x matrix
+ * @return leaf of a fused expression
+ */
+template <typename T, require_rev_matrix_t<T>* = nullptr>
+inline auto fuse(const T& x) {
+  return fused_var<arena_t<T>>(x);
+}
+
+/**
+ * Start a fused expression with a matrix of data. The matrix is copied to
+ * the autodiff arena.
+ *
+ * @tparam T type of the matrix or expression
+ * @param x matrix
+ * @return leaf of a fused expression
+ */
+template <typename T, require_eigen_vt<std::is_arithmetic, T>* = nullptr>
+inline auto fuse(const T& x) {
+  return fused_data<arena_t<plain_type_t<T>>>(x);
+}
+
+/**
+ * Return the fused expression unchanged.
+ *
+ * @tparam T type of the fused expression
+ * @param x fused expression
+ * @return the expression
+ */
+template <typename T, require_fused_expression_t<T>* = nullptr>
+inline const T& as_fused(const T& x) {
+  return x;
+}
+
+/**
+ * Start a fused expression with a matrix, see `fuse()`. Scalars are not
+ * accepted, as they can only be broadcast as the operand of a binary
+ * operation.
+ *
+ * @tparam T type of the matrix
+ * @param x matrix
+ * @return leaf of a fused expression
+ */
+template <typename T, require_matrix_t<T>* = nullptr>
+inline auto as_fused(const T& x) {
+  return fuse(x);
+}
+
+namespace internal {
+/**
+ * Return the fused expression operand of a binary operation unchanged.
+ *
+ * @tparam T type of the fused expression
+ * @param x fused expression
+ * @return the expression
+ */
+template <typename T, require_fused_expression_t<T>* = nullptr>
+inline const T& as_fused_operand(const T& x) {
+  return x;
+}
+
+/**
+ * Wrap a scalar operand of a binary operation as a leaf of a fused
+ * expression.
+ *
+ * @tparam T arithmetic type
+ * @param x scalar
+ * @return leaf of a fused expression
+ */
+template <typename T, require_arithmetic_t<T>* = nullptr>
+inline fused_scalar as_fused_operand(const T& x) {
+  return fused_scalar(x);
+}
+}  // namespace internal
+
+}  // namespace math
+}  // namespace stan
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef STAN_MATH_REV_FUSED_FUSED_BASE_HPP
+#define STAN_MATH_REV_FUSED_FUSED_BASE_HPP
+
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+/**
+ * Base of fused expressions over reverse mode matrices.
+ *
+ * A fused expression is a tree of elementwise operations. Its leaves are
+ * created with `fuse()` and refer to the values and adjoints of reverse
+ * mode matrices, or to data. Building the tree does not compute anything.
+ * `eval()` computes the values of the whole tree in one Eigen loop and
+ * places one callback on the autodiff stack, instead of one `vari` and
+ * one arena matrix per operation. Only the values of functions that are
+ * expensive to evaluate, such as `exp()`, are kept in an arena matrix,
+ * each computed by its own Eigen loop. In the reverse pass the callback
+ * sweeps the elements once, recomputing the other intermediate values of
+ * each element in registers and propagating the adjoint of the result to
+ * all leaves.
+ *
+ * Each derived class must define:
+ * - `matrix_t`, the type of the evaluated values;
+ * - `has_var` and `has_var_value`, whether the tree has leaves of reverse
+ * mode matrices, and of `var_value<Eigen::Matrix>` in particular;
+ * - `rows()` and `cols()`;
+ * - `prepare()`, which computes the values that are kept;
+ * - `val()`, an Eigen array expression of the values;
+ * - `forward(i, j)`, which returns the value of the element and keeps the
+ * values the partials need;
+ * - `backward(i, j, adj)`, which adds the adjoint of the element times the
+ * partials to the leaves, using the values kept by the preceding
+ * `forward(i, j)`.
+ *
+ * @tparam Derived type of the derived expression
+ */
+template <typename Derived>
+class fused_base : public stan::fused_expression_base {
+ public:
+  /**
+   * Return the derived expression.
+   */
+  inline const Derived& derived() const {
+    return *static_cast<const Derived*>(this);
+  }
+
+  /**
+   * Evaluate the expression. If the expression has reverse mode leaves,
+   * the result is a `var_value<Eigen::Matrix>` when any leaf is one, and
+   * an `Eigen::Matrix<var>` otherwise. Expressions of data are evaluated
+   * into an `Eigen::Matrix<double>`.
+   *
+   * @return evaluated expression
+   */
+  template <typename T = Derived,
+            require_t<bool_constant<T::has_var>>* = nullptr>
+  inline auto eval() const {
+    using matrix_t = typename T::matrix_t;
+    using ret_type
+        = std::conditional_t<T::has_var_value, var_value<matrix_t>,
+                             promote_scalar_t<var, matrix_t>>;
+    T expr = derived();
+    expr.prepare();
+    arena_t<ret_type> ret(expr.val().matrix());
+    reverse_pass_callback([ret, expr]() {
+      // a local copy lets the compiler keep the values in registers
+      T local = expr;
+      for (Eigen::Index j = 0; j < ret.cols(); ++j) {
+        for (Eigen::Index i = 0; i < ret.rows(); ++i) {
+          local.forward(i, j);
+          local.backward(i, j, ret.adj().coeff(i, j));
+        }
+      }
+    });
+    return ret_type(ret);
+  }
+
+  template <typename T = Derived,
+            require_t<bool_constant<!T::has_var>>* = nullptr>
+  inline auto eval() const {
+    T expr = derived();
+    expr.prepare();
+    return typename T::matrix_t(expr.val().matrix());
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef STAN_MATH_REV_FUSED_UNARY_OPERATION_HPP
+#define STAN_MATH_REV_FUSED_UNARY_OPERATION_HPP
+
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/fused/fused_base.hpp>
+#include <cmath>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+/**
+ * Elementwise function of a fused expression. The values of functions
+ * that are expensive to evaluate are kept in an arena matrix by
+ * `prepare()`, so that the reverse pass does not evaluate them again.
+ *
+ * @tparam Op function with static members `val()` for Eigen arrays,
+ * `value()` for scalars and `partial()`, the derivative given the
+ * argument and the value, and the flag `cached`, whether the values are
+ * kept
+ * @tparam A type of the argument expression
+ */
+template <typename Op, typename A>
+class fused_unary : public fused_base<fused_unary<Op, A>> {
+  static_assert(!A::is_scalar,
+                "The operand of a fused unary operation must be a matrix");
+  A a_;
+  arena_matrix<typename A::matrix_t> values_;
+  double x_{0};
+  double fx_{0};
+
+  inline auto val(std::true_type) const { return values_.array(); }
+  inline auto val(std::false_type) const { return Op::val(a_.val()); }
+
+ public:
+  using matrix_t = typename A::matrix_t;
+  static constexpr bool is_scalar = false;
+  static constexpr bool has_var = A::has_var;
+  static constexpr bool has_var_value = A::has_var_value;
+
+  explicit fused_unary(const A& a) : a_(a) {}
+
+  inline Eigen::Index rows() const { return a_.rows(); }
+  inline Eigen::Index cols() const { return a_.cols(); }
+  inline void prepare() {
+    a_.prepare();
+    if (Op::cached) {
+      values_ = Op::val(a_.val()).matrix();
+    }
+  }
+  inline auto val() const {
+    return val(std::integral_constant<bool, Op::cached>());
+  }
+  inline double forward(Eigen::Index i, Eigen::Index j) {
+    x_ = a_.forward(i, j);
+    fx_ = Op::cached ? values_.coeff(i, j) : Op::value(x_);
+    return fx_;
+  }
+  inline void backward(Eigen::Index i, Eigen::Index j, double adj) {
+    a_.backward(i, j, adj * Op::partial(x_, fx_));
+  }
+};
+
+namespace internal {
+struct fused_minus_op {
+  static constexpr bool cached = false;
+  template <typename T>
+  static inline auto val(const T& x) {
+    return -x;
+  }
+  static inline double value(double x) { return -x; }
+  static inline double partial(double x, double fx) { return -1.0; }
+};
+
+struct fused_exp_op {
+  static constexpr bool cached = true;
+  template <typename T>
+  static inline auto val(const T& x) {
+    return x.exp();
+  }
+  static inline double value(double x) { return std::exp(x); }
+  static inline double partial(double x, double fx) { return fx; }
+};
+
+struct fused_log_op {
+  static constexpr bool cached = true;
+  template <typename T>
+  static inline auto val(const T& x) {
+    return x.log();
+  }
+  static inline double value(double x) { return std::log(x); }
+  static inline double partial(double x, double fx) { return 1.0 / x; }
+};
+
+struct fused_log1p_op {
+  static constexpr bool cached = true;
+  template <typename T>
+  static inline auto val(const T& x) {
+    return x.log1p();
+  }
+  static inline double value(double x) { return std::log1p(x); }
+  static inline double partial(double x, double fx) {
+    return 1.0 / (1.0 + x);
+  }
+};
+
+struct fused_sqrt_op {
+  static constexpr bool cached = true;
+  template <typename T>
+  static inline auto val(const T& x) {
+    return x.sqrt();
+  }
+  static inline double value(double x) { return std::sqrt(x); }
+  static inline double partial(double x, double fx) { return 0.5 / fx; }
+};
+
+struct fused_square_op {
+  static constexpr bool cached = false;
+  template <typename T>
+  static inline auto val(const T& x) {
+    return x.square();
+  }
+  static inline double value(double x) { return x * x; }
+  static inline double partial(double x, double fx) { return 2.0 * x; }
+};
+}  // namespace internal
+
+/**
+ * Return the elementwise negation of the fused expression.
+ *
+ * @tparam A type of the fused expression
+ * @param a fused expression
+ * @return fused expression of the negation
+ */
+template <typename A, require_fused_expression_t<A>* = nullptr>
+inline auto operator-(const A& a) {
+  return fused_unary<internal::fused_minus_op, A>(a);
+}
+
+/**
+ * Return the elementwise exponential of the fused expression.
+ *
+ * @tparam A type of the fused expression
+ * @param a fused expression
+ * @return fused expression of the exponential
+ */
+template <typename A, require_fused_expression_t<A>* = nullptr>
+inline auto exp(const A& a) {
+  return fused_unary<internal::fused_exp_op, A>(a);
+}
+
+/**
+ * Return the elementwise natural logarithm of the fused expression.
+ *
+ * @tparam A type of the fused expression
+ * @param a fused expression
+ * @return fused expression of the logarithm
+ */
+template <typename A, require_fused_expression_t<A>* = nullptr>
+inline auto log(const A& a) {
+  return fused_unary<internal::fused_log_op, A>(a);
+}
+
+/**
+ * Return the elementwise natural logarithm of one plus the fused
+ * expression.
+ *
+ * @tparam A type of the fused expression
+ * @param a fused expression
+ * @return fused expression of the logarithm of one plus the argument
+ */
+template <typename A, require_fused_expression_t<A>* = nullptr>
+inline auto log1p(const A& a) {
+  return fused_unary<internal::fused_log1p_op, A>(a);
+}
+
+/**
+ * Return the elementwise square root of the fused expression.
+ *
+ * @tparam A type of the fused expression
+ * @param a fused expression
+ * @return fused expression of the square root
+ */
+template <typename A, require_fused_expression_t<A>* = nullptr>
+inline auto sqrt(const A& a) {
+  return fused_unary<internal::fused_sqrt_op, A>(a);
+}
+
+/**
+ * Return the elementwise square of the fused expression.
+ *
+ * @tparam A type of the fused expression
+ * @param a fused expression
+ * @return fused expression of the square
+ */
+template <typename A, require_fused_expression_t<A>* = nullptr>
+inline auto square(const A& a) {
+  return fused_unary<internal::fused_square_op, A>(a);
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
@@ -0,0 +1,121 @@
+#include <stan/math/fwd.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+
+TEST(mathFwdCoreFvarN, ctor) {
+  using stan::math::fvar_n;
+
+  fvar_n<double, 4> a;
+  EXPECT_FLOAT_EQ(0.0, a.val_);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(0.0, a.d(i));
+  }
+
+  fvar_n<double, 4> b(1.9);
+  EXPECT_FLOAT_EQ(1.9, b.val_);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(0.0, b.d(i));
+  }
+
+  fvar_n<double, 4> c = fvar_n<double, 4>::unit(1.93, 2);
+  EXPECT_FLOAT_EQ(1.93, c.val_);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(i == 2 ? 1.0 : 0.0, c.d(i));
+  }
+}
+
+TEST(mathFwdCoreFvarN, insertionOperator) {
+  using stan::math::fvar_n;
+  fvar_n<double, 2> a(5.0);
+  std::stringstream ss;
+  ss << a;
+  EXPECT_EQ("5", ss.str());
+}
+
+namespace fvar_n_test {
+// every tangent of an fvar_n must match the tangent of fvar<double>
+// seeded in the same direction
+struct expr {
+  template <typename T>
+  T operator()(const T& x, const T& y) const {
+    using stan::math::cos;
+    using stan::math::exp;
+    using stan::math::expm1;
+    using stan::math::fabs;
+    using stan::math::inv;
+    using stan::math::inv_logit;
+    using stan::math::lgamma;
+    using stan::math::log;
+    using stan::math::log1p;
+    using stan::math::pow;
+    using stan::math::sin;
+    using stan::math::sqrt;
+    using stan::math::square;
+    using stan::math::tanh;
+    T z = x * y - x / y + 2.0 * x - y / 3.0 + (1.5 - x) * (-y) + (+x);
+    z += exp(x) * log(y) + expm1(y) - log1p(x) + sqrt(y) * square(x);
+    z -= inv(y) + pow(x, y) + pow(x, 3.0) + pow(2.0, y) + pow(x, 2);
+    z *= sin(x) + cos(y) + tanh(x * y) + fabs(x - y);
+    z /= inv_logit(x) + lgamma(y);
+    return z;
+  }
+};
+}  // namespace fvar_n_test
+
+TEST(mathFwdCoreFvarN, tangentsMatchFvar) {
+  using stan::math::fvar;
+  using stan::math::fvar_n;
+  fvar_n_test::expr f;
+  double x = 0.7;
+  double y = 1.3;
+
+  fvar_n<double, 2> z_n
+      = f(fvar_n<double, 2>::unit(x, 0), fvar_n<double, 2>::unit(y, 1));
+  fvar<double> z_x = f(fvar<double>(x, 1), fvar<double>(y, 0));
+  fvar<double> z_y = f(fvar<double>(x, 0), fvar<double>(y, 1));
+
+  EXPECT_FLOAT_EQ(z_x.val_, z_n.val_);
+  EXPECT_FLOAT_EQ(z_x.d_, z_n.d(0));
+  EXPECT_FLOAT_EQ(z_y.d_, z_n.d(1));
+}
+
+TEST(mathFwdCoreFvarN, comparison) {
+  using stan::math::fvar_n;
+  fvar_n<double, 3> a(1.0);
+  fvar_n<double, 3> b = fvar_n<double, 3>::unit(2.0, 1);
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(a <= b);
+  EXPECT_TRUE(b > a);
+  EXPECT_TRUE(b >= a);
+  EXPECT_TRUE(a != b);
+  EXPECT_FALSE(a == b);
+  EXPECT_TRUE(a == 1.0);
+  EXPECT_TRUE(2.0 == b);
+  EXPECT_TRUE(a < 1.5);
+  EXPECT_TRUE(1.5 < b);
+}
+
+TEST(mathFwdCoreFvarN, nested) {
+  using stan::math::fvar;
+  using stan::math::fvar_n;
+  // f(x, y) = exp(x) * y^2
+  fvar<fvar_n<double, 2>> x(fvar_n<double, 2>::unit(0.5, 0),
+                            fvar_n<double, 2>(1.0));
+  fvar<fvar_n<double, 2>> y(fvar_n<double, 2>::unit(2.0, 1),
+                            fvar_n<double, 2>(0.0));
+  fvar<fvar_n<double, 2>> z = stan::math::exp(x) * stan::math::square(y);
+  double e = std::exp(0.5);
+  EXPECT_FLOAT_EQ(e * 4, z.val_.val_);
+  EXPECT_FLOAT_EQ(e * 4, z.val_.d(0));
+  EXPECT_FLOAT_EQ(e * 4, z.val_.d(1));
+  EXPECT_FLOAT_EQ(e * 4, z.d_.val_);
+  EXPECT_FLOAT_EQ(e * 4, z.d_.d(0));
+  EXPECT_FLOAT_EQ(e * 4, z.d_.d(1));
+}
+
+TEST(mathFwdCoreFvarN, notAnAutodiffType) {
+  using stan::math::fvar_n;
+  EXPECT_FALSE((stan::is_fvar<fvar_n<double, 4>>::value));
+  EXPECT_FALSE((stan::is_autodiff<fvar_n<double, 4>>::value));
+  EXPECT_TRUE((stan::is_fvar<stan::math::fvar<fvar_n<double, 4>>>::value));
+}
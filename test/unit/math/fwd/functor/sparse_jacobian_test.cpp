@@ -0,0 +1,46 @@
+#include <stan/math/fwd.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// arrow shaped Jacobian: every output depends on x(0) and on x(i)
+struct arrow_fun {
+  template <typename T>
+  inline Matrix<T, Dynamic, 1> operator()(
+      const Matrix<T, Dynamic, 1>& x) const {
+    Matrix<T, Dynamic, 1> y(x.size() - 1);
+    for (int i = 1; i < x.size(); ++i) {
+      y(i - 1) = stan::math::exp(x(0)) * x(i) * x(i);
+    }
+    return y;
+  }
+};
+
+TEST(FwdFunctor, sparse_jacobian) {
+  arrow_fun f;
+  const int n = 7;
+  VectorXd x = VectorXd::LinSpaced(n, -1.0, 2.0);
+  MatrixXd arrow = MatrixXd::Zero(n - 1, n);
+  for (int i = 0; i < n - 1; ++i) {
+    arrow(i, 0) = 1;
+    arrow(i, i + 1) = 1;
+  }
+  Eigen::SparseMatrix<double> pattern = arrow.sparseView();
+
+  VectorXd fx;
+  Eigen::SparseMatrix<double> J;
+  stan::math::sparse_jacobian<double>(f, x, pattern, fx, J);
+
+  ASSERT_EQ(n - 1, fx.size());
+  MatrixXd J_dense = J;
+  for (int i = 1; i < n; ++i) {
+    EXPECT_FLOAT_EQ(std::exp(x(0)) * x(i) * x(i), fx(i - 1));
+    EXPECT_FLOAT_EQ(std::exp(x(0)) * x(i) * x(i), J_dense(i - 1, 0));
+    EXPECT_FLOAT_EQ(2 * std::exp(x(0)) * x(i), J_dense(i - 1, i));
+  }
+  EXPECT_EQ(pattern.nonZeros(), J.nonZeros());
+}
@@ -132,3 +132,160 @@ TEST(stack_alloc, in_stack_second_block) {
   EXPECT_FALSE(allocator.in_stack(x));
   EXPECT_FALSE(allocator.in_stack(y));
 }
+
+TEST(stack_alloc, alloc_aligned_bytes) {
+  stan::math::stack_alloc allocator;
+  for (int i = 0; i < 10000; ++i) {
+    allocator.alloc(1 + i % 13);
+    void* x32 = allocator.alloc_aligned(8 * (i % 7) + 5, 32);
+    EXPECT_TRUE(stan::math::is_aligned(static_cast<char*>(x32), 32U));
+    void* x64 = allocator.alloc_aligned(1000 + i, 64);
+    EXPECT_TRUE(stan::math::is_aligned(static_cast<char*>(x64), 64U));
+    EXPECT_TRUE(allocator.in_stack(x64));
+  }
+}
+
+TEST(stack_alloc, alloc_aligned_array) {
+  stan::math::stack_alloc allocator;
+  allocator.alloc(8);
+  double* small = allocator.alloc_aligned_array<double>(2);
+  EXPECT_TRUE(stan::math::is_aligned(small, 8U));
+  for (size_t n = 8; n < 100000; n *= 3) {
+    allocator.alloc(24);
+    double* x = allocator.alloc_aligned_array<double>(n);
+    EXPECT_TRUE(stan::math::is_aligned(x, STAN_ARENA_ALIGNMENT));
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = i;
+    }
+    EXPECT_FLOAT_EQ(n - 1, x[n - 1]);
+  }
+  allocator.recover_all();
+  allocator.alloc(8);
+  EXPECT_TRUE(stan::math::is_aligned(allocator.alloc_aligned_array<double>(16),
+                                     STAN_ARENA_ALIGNMENT));
+}
+
+TEST(stack_alloc, usage_statistics) {
+  stan::math::stack_alloc allocator(1024);
+  EXPECT_EQ(0, allocator.bytes_used());
+  EXPECT_EQ(1024, allocator.bytes_reserved());
+  EXPECT_EQ(1, allocator.num_blocks());
+
+  allocator.alloc(100);
+  EXPECT_EQ(104, allocator.bytes_used());
+  allocator.start_nested();
+  allocator.alloc(16);
+  allocator.start_nested();
+  allocator.alloc(2000);
+  std::vector<size_t> nested = allocator.nested_bytes_used();
+  ASSERT_EQ(2, nested.size());
+  EXPECT_EQ(16, nested[0]);
+  // the rest of the first block is counted against the inner level
+  EXPECT_EQ(1024 - 120 + 2000, nested[1]);
+  EXPECT_EQ(2, allocator.num_blocks());
+  EXPECT_EQ(1024 + 2048, allocator.bytes_reserved());
+  EXPECT_EQ(1024 + 2000, allocator.bytes_used());
+
+  allocator.recover_nested();
+  EXPECT_EQ(120, allocator.bytes_used());
+  EXPECT_EQ(1024 + 2000, allocator.high_water_mark());
+  allocator.recover_nested();
+  allocator.recover_all();
+  EXPECT_EQ(0, allocator.bytes_used());
+  EXPECT_EQ(1024 + 2000, allocator.high_water_mark());
+  EXPECT_EQ(2, allocator.num_blocks());
+  allocator.reset_high_water_mark();
+  EXPECT_EQ(0, allocator.high_water_mark());
+}
+
+TEST(stack_alloc, nested_high_water_marks) {
+  stan::math::stack_alloc allocator(1024);
+  allocator.alloc(100);
+  allocator.start_nested();
+  allocator.alloc(16);
+  allocator.start_nested();
+  allocator.alloc(2000);
+  std::vector<size_t> marks = allocator.nested_high_water_marks();
+  ASSERT_EQ(2, marks.size());
+  EXPECT_EQ(1024 + 2000 - 104, marks[0]);
+  EXPECT_EQ(1024 + 2000 - 120, marks[1]);
+
+  // the peak of the recovered inner level is kept by the outer level
+  allocator.recover_nested();
+  allocator.alloc(8);
+  marks = allocator.nested_high_water_marks();
+  ASSERT_EQ(1, marks.size());
+  EXPECT_EQ(1024 + 2000 - 104, marks[0]);
+  EXPECT_EQ(1024 + 2000, allocator.high_water_mark());
+
+  allocator.reset_high_water_mark();
+  marks = allocator.nested_high_water_marks();
+  EXPECT_EQ(128 - 104, marks[0]);
+  allocator.recover_nested();
+  EXPECT_TRUE(allocator.nested_high_water_marks().empty());
+}
+
+TEST(stack_alloc, high_water_mark_between_samples) {
+  stan::math::stack_alloc allocator(1024);
+  allocator.alloc(5000);
+  // the blocks are freed without any call reading the mark
+  allocator.free_all();
+  EXPECT_EQ(1, allocator.num_blocks());
+  EXPECT_EQ(1024 + 5000, allocator.high_water_mark());
+
+  allocator.reset_high_water_mark();
+  allocator.start_nested();
+  allocator.alloc(3000);
+  allocator.alloc(4000);
+  allocator.recover_nested();
+  allocator.free_all();
+  EXPECT_EQ(1024 + 3000 + 4000, allocator.high_water_mark());
+}
+
+TEST(stack_alloc, retention_max_bytes) {
+  stan::math::stack_alloc allocator(1024);
+  allocator.set_retention_policy(4000, 0);
+  allocator.alloc(1000);
+  allocator.alloc(2000);
+  allocator.alloc(4000);
+  EXPECT_EQ(3, allocator.num_blocks());
+  allocator.recover_all();
+  EXPECT_EQ(2, allocator.num_blocks());
+  EXPECT_EQ(1024 + 2048, allocator.bytes_reserved());
+
+  allocator.set_retention_policy(1, 0);
+  allocator.recover_all();
+  EXPECT_EQ(1, allocator.num_blocks());
+  double* x = allocator.alloc_array<double>(1000);
+  x[999] = 1.0;
+  EXPECT_TRUE(allocator.in_stack(x + 999));
+}
+
+TEST(stack_alloc, retention_trim_after) {
+  stan::math::stack_alloc allocator(1024);
+  allocator.set_retention_policy(0, 3);
+  allocator.alloc(1000);
+  allocator.alloc(2000);
+  allocator.alloc(5000);
+  allocator.recover_all();
+  EXPECT_EQ(3, allocator.num_blocks());
+  // a nested peak within the window keeps its blocks
+  allocator.start_nested();
+  allocator.alloc(1000);
+  allocator.alloc(2000);
+  allocator.recover_nested();
+  allocator.recover_all();
+  allocator.alloc(100);
+  allocator.recover_all();
+  EXPECT_EQ(3, allocator.num_blocks());
+
+  for (int i = 0; i < 2; ++i) {
+    allocator.alloc(100);
+    allocator.recover_all();
+    EXPECT_EQ(3, allocator.num_blocks());
+  }
+  allocator.alloc(100);
+  allocator.recover_all();
+  EXPECT_EQ(1, allocator.num_blocks());
+  EXPECT_EQ(1024, allocator.bytes_reserved());
+}
@@ -1,6 +1,7 @@
 #include <stan/math/mix.hpp>
 #include <gtest/gtest.h>
 #include <test/unit/math/rev/fun/util.hpp>
+#include <test/unit/util.hpp>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -34,6 +35,31 @@ struct fun2 {
   }
 };
 
+// fun3: R^5 --> R^3, dense in its arguments
+struct fun3 {
+  template <typename T>
+  inline Matrix<T, Dynamic, 1> operator()(
+      const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::sin;
+    Matrix<T, Dynamic, 1> z(3);
+    z << x(0) * x(1) * x(2) + exp(x(3)) - x(4) / x(0),
+        sin(x(1) + x(2)) * x(3) * x(4), x(0) * x(0) + 2 * x(4) * x(2);
+    return z;
+  }
+};
+
+// fun4: R^5 --> R, dense Hessian
+struct fun4 {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    T s = x(0) * x(1) + x(2) * x(3) * x(4);
+    return exp(0.1 * s) + log(x(0) + x(1) * x(1) + x(4)) * x(2);
+  }
+};
+
 struct norm_functor {
   template <typename T>
   inline T operator()(
@@ -186,6 +212,70 @@ TEST(MixFunctor, hessian) {
   EXPECT_FLOAT_EQ(2 * 3, H2(1, 1));
 }
 
+TEST(MixFunctor, jacobianChunked) {
+  using stan::math::jacobian;
+
+  fun3 f;
+  Matrix<double, Dynamic, 1> x(5);
+  x << 1.5, -0.3, 0.7, 0.2, 2.1;
+
+  Matrix<double, Dynamic, 1> fx;
+  Matrix<double, Dynamic, Dynamic> J;
+  jacobian(f, x, fx, J);
+
+  Matrix<double, Dynamic, 1> fx1;
+  Matrix<double, Dynamic, Dynamic> J1;
+  jacobian<1>(f, x, fx1, J1);
+  Matrix<double, Dynamic, 1> fx2;
+  Matrix<double, Dynamic, Dynamic> J2;
+  jacobian<2>(f, x, fx2, J2);
+  Matrix<double, Dynamic, 1> fx8;
+  Matrix<double, Dynamic, Dynamic> J8;
+  jacobian<8>(f, x, fx8, J8);
+
+  EXPECT_MATRIX_FLOAT_EQ(fx, fx1);
+  EXPECT_MATRIX_FLOAT_EQ(fx, fx2);
+  EXPECT_MATRIX_FLOAT_EQ(fx, fx8);
+  EXPECT_MATRIX_FLOAT_EQ(J, J1);
+  EXPECT_MATRIX_FLOAT_EQ(J, J2);
+  EXPECT_MATRIX_FLOAT_EQ(J, J8);
+}
+
+TEST(MixFunctor, hessianChunked) {
+  fun4 f;
+  Matrix<double, Dynamic, 1> x(5);
+  x << 1.5, -0.3, 0.7, 0.2, 2.1;
+
+  double fx;
+  Matrix<double, Dynamic, 1> grad;
+  Matrix<double, Dynamic, Dynamic> H;
+  stan::math::hessian(f, x, fx, grad, H);
+
+  double fx_fwd;
+  Matrix<double, Dynamic, 1> grad_fwd;
+  Matrix<double, Dynamic, Dynamic> H_fwd;
+  stan::math::hessian<2, double>(f, x, fx_fwd, grad_fwd, H_fwd);
+  EXPECT_FLOAT_EQ(fx, fx_fwd);
+  EXPECT_MATRIX_FLOAT_EQ(grad, grad_fwd);
+  EXPECT_MATRIX_FLOAT_EQ(H, H_fwd);
+
+  double fx_fwd8;
+  Matrix<double, Dynamic, 1> grad_fwd8;
+  Matrix<double, Dynamic, Dynamic> H_fwd8;
+  stan::math::hessian<8, double>(f, x, fx_fwd8, grad_fwd8, H_fwd8);
+  EXPECT_FLOAT_EQ(fx, fx_fwd8);
+  EXPECT_MATRIX_FLOAT_EQ(grad, grad_fwd8);
+  EXPECT_MATRIX_FLOAT_EQ(H, H_fwd8);
+
+  double fx_mix;
+  Matrix<double, Dynamic, 1> grad_mix;
+  Matrix<double, Dynamic, Dynamic> H_mix;
+  stan::math::hessian<4>(f, x, fx_mix, grad_mix, H_mix);
+  EXPECT_FLOAT_EQ(fx, fx_mix);
+  EXPECT_MATRIX_FLOAT_EQ(grad, grad_mix);
+  EXPECT_MATRIX_FLOAT_EQ(H, H_mix);
+}
+
 TEST(MixFunctor, GradientTraceMatrixTimesHessian) {
   Matrix<double, Dynamic, Dynamic> M(2, 2);
   M << 11, 13, 17, 23;
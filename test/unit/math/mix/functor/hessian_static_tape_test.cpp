@@ -0,0 +1,145 @@
+#include <stan/math/mix.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <stdexcept>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+namespace hessian_static_tape_test {
+// uses every operation with known second derivatives
+struct all_ops_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::log_sum_exp;
+    using stan::math::sqrt;
+    using stan::math::square;
+    T lp = 0;
+    lp += x(0) * x(1) - x(2) / x(0) + 2.0 / x(1) - (3.0 - x(2));
+    lp += exp(x(0) / 4.0) + log(x(1)) * sqrt(x(2)) + square(x(0) - 1.0);
+    lp -= log_sum_exp(x(0), x(1)) + log_sum_exp(x(2), 0.5) * -x(1);
+    lp += x(3) * x(3) + x(3) / x(3) + (x(3) - 2.0) * 0.5 + x(2) / 3.0;
+    return lp;
+  }
+};
+
+struct branching_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    if (x(0) > 0) {
+      return x(0) * x(0) * x(1);
+    }
+    return stan::math::exp(x(0) + x(1));
+  }
+};
+
+struct unsupported_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return stan::math::lgamma(x(0)) * x(1);
+  }
+};
+
+// the var version records partials without second derivatives
+struct precomputed_fun {
+  stan::math::var operator()(
+      const Matrix<stan::math::var, Dynamic, 1>& x) const {
+    using stan::math::precomp_vv_vari;
+    using stan::math::var;
+    return var(new precomp_vv_vari(x(0).val() * x(1).val(), x(0).vi_,
+                                   x(1).vi_, x(1).val(), x(0).val()))
+           * x(0);
+  }
+  template <typename T>
+  T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return x(0) * x(1) * x(0);
+  }
+};
+
+template <typename F>
+void expect_same_hessian(stan::math::static_tape& tape, const F& f,
+                         const VectorXd& x) {
+  double fx;
+  VectorXd grad;
+  MatrixXd H;
+  stan::math::hessian(tape, f, x, fx, grad, H);
+  double fx_ref;
+  VectorXd grad_ref;
+  MatrixXd H_ref;
+  stan::math::hessian(f, x, fx_ref, grad_ref, H_ref);
+  EXPECT_FLOAT_EQ(fx_ref, fx);
+  EXPECT_MATRIX_NEAR(grad_ref, grad, 1e-10);
+  EXPECT_MATRIX_NEAR(H_ref, H, 1e-10);
+}
+}  // namespace hessian_static_tape_test
+
+TEST(MixFunctor, hessian_static_tape) {
+  hessian_static_tape_test::all_ops_fun f;
+  stan::math::static_tape tape;
+  VectorXd x(4);
+  x << 1.5, 2.0, 0.7, -0.4;
+  hessian_static_tape_test::expect_same_hessian(tape, f, x);
+  EXPECT_TRUE(tape.is_twice_differentiable());
+  x << 0.5, 1.0, 1.7, 2.4;
+  hessian_static_tape_test::expect_same_hessian(tape, f, x);
+}
+
+TEST(MixFunctor, hessian_static_tape_sparse) {
+  using stan::math::var;
+  hessian_static_tape_test::all_ops_fun f;
+  VectorXd x(4);
+  x << 1.5, 2.0, 0.7, -0.4;
+  stan::math::nested_rev_autodiff nested;
+  Matrix<var, Dynamic, 1> x_var(x);
+  stan::math::static_tape tape;
+  tape.start_recording(x_var);
+  var fx = f(x_var);
+  tape.stop_recording(fx);
+
+  VectorXd grad;
+  MatrixXd H;
+  tape.hessian(grad, H);
+  VectorXd grad_sparse;
+  Eigen::SparseMatrix<double> H_sparse;
+  tape.hessian(grad_sparse, H_sparse);
+  EXPECT_MATRIX_EQ(grad, grad_sparse);
+  EXPECT_MATRIX_EQ(H, MatrixXd(H_sparse));
+  // x(3) only interacts with itself
+  EXPECT_EQ(0, H_sparse.col(3).nonZeros() - 1);
+}
+
+TEST(MixFunctor, hessian_static_tape_rerecords_on_branch) {
+  hessian_static_tape_test::branching_fun f;
+  stan::math::static_tape tape;
+  VectorXd x(2);
+  x << 1.5, 2.0;
+  hessian_static_tape_test::expect_same_hessian(tape, f, x);
+  x << -1.5, 2.0;
+  hessian_static_tape_test::expect_same_hessian(tape, f, x);
+  x << -0.5, 1.0;
+  hessian_static_tape_test::expect_same_hessian(tape, f, x);
+}
+
+TEST(MixFunctor, hessian_static_tape_falls_back) {
+  hessian_static_tape_test::unsupported_fun f;
+  stan::math::static_tape tape;
+  VectorXd x(2);
+  x << 2.5, 3.0;
+  hessian_static_tape_test::expect_same_hessian(tape, f, x);
+  EXPECT_FALSE(tape.is_twice_differentiable());
+  x << 1.5, 2.0;
+  hessian_static_tape_test::expect_same_hessian(tape, f, x);
+
+  hessian_static_tape_test::precomputed_fun g;
+  stan::math::static_tape tape_g;
+  hessian_static_tape_test::expect_same_hessian(tape_g, g, x);
+  EXPECT_TRUE(tape_g.is_complete());
+  EXPECT_FALSE(tape_g.is_twice_differentiable());
+  VectorXd grad;
+  MatrixXd H;
+  EXPECT_THROW(tape_g.hessian(grad, H), std::domain_error);
+}
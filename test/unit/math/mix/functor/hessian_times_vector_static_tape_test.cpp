@@ -0,0 +1,178 @@
+#include <stan/math/mix.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <stdexcept>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+namespace hessian_times_vector_static_tape_test {
+struct all_ops_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::log_sum_exp;
+    using stan::math::sqrt;
+    using stan::math::square;
+    T lp = 0;
+    lp += x(0) * x(1) - x(2) / x(0) + 2.0 / x(1) - (3.0 - x(2));
+    lp += exp(x(0) / 4.0) + log(x(1)) * sqrt(x(2)) + square(x(0) - 1.0);
+    lp -= log_sum_exp(x(0), x(1)) + log_sum_exp(x(2), 0.5) * -x(1);
+    lp += x(3) * x(3) + x(3) / x(3) + (x(3) - 2.0) * 0.5 + x(2) / 3.0;
+    return lp;
+  }
+};
+
+struct branching_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    if (x(0) > 0) {
+      return x(0) * x(0) * x(1);
+    }
+    return stan::math::exp(x(0) + x(1));
+  }
+};
+
+struct unsupported_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return stan::math::lgamma(x(0)) * x(1);
+  }
+};
+
+template <int Lanes, typename F>
+void expect_same_products(stan::math::static_tape& tape, const F& f,
+                          const VectorXd& x, const MatrixXd& V) {
+  double fx;
+  VectorXd grad_fx_dot_V;
+  MatrixXd HV;
+  stan::math::hessian_times_vector<Lanes>(tape, f, x, V, fx, grad_fx_dot_V,
+                                          HV);
+  double fx_ref;
+  VectorXd grad_ref;
+  MatrixXd H_ref;
+  stan::math::hessian(f, x, fx_ref, grad_ref, H_ref);
+  EXPECT_FLOAT_EQ(fx_ref, fx);
+  EXPECT_MATRIX_NEAR(V.transpose() * grad_ref, grad_fx_dot_V, 1e-10);
+  EXPECT_MATRIX_NEAR(H_ref * V, HV, 1e-10);
+
+  VectorXd grad_dot_V;
+  stan::math::gradient_dot_vector(tape, f, x, V, fx, grad_dot_V);
+  EXPECT_FLOAT_EQ(fx_ref, fx);
+  EXPECT_MATRIX_NEAR(V.transpose() * grad_ref, grad_dot_V, 1e-10);
+}
+
+MatrixXd directions(Eigen::Index n, Eigen::Index k) {
+  MatrixXd V(n, k);
+  for (Eigen::Index j = 0; j < k; ++j) {
+    for (Eigen::Index i = 0; i < n; ++i) {
+      V(i, j) = std::sin(1.0 + i + 3.0 * j);
+    }
+  }
+  return V;
+}
+}  // namespace hessian_times_vector_static_tape_test
+
+TEST(MixFunctor, hessian_times_vector_static_tape) {
+  using hessian_times_vector_static_tape_test::directions;
+  using hessian_times_vector_static_tape_test::expect_same_products;
+  hessian_times_vector_static_tape_test::all_ops_fun f;
+  VectorXd x(4);
+  x << 1.5, 2.0, 0.7, -0.4;
+  // fewer, as many and more directions than lanes
+  for (int k : {1, 4, 7}) {
+    stan::math::static_tape tape;
+    expect_same_products<4>(tape, f, x, directions(4, k));
+    EXPECT_TRUE(tape.is_twice_differentiable());
+    expect_same_products<4>(tape, f, x, directions(4, k));
+    stan::math::static_tape tape_1;
+    expect_same_products<1>(tape_1, f, x, directions(4, k));
+  }
+  stan::math::static_tape tape;
+  expect_same_products<2>(tape, f, x, directions(4, 3));
+  x << 0.5, 1.0, 1.7, 2.4;
+  expect_same_products<2>(tape, f, x, directions(4, 3));
+  expect_same_products<2>(tape, f, x, directions(4, 0));
+}
+
+TEST(MixFunctor, hessian_times_vector_static_tape_matches_single) {
+  hessian_times_vector_static_tape_test::all_ops_fun f;
+  VectorXd x(4);
+  x << 1.5, 2.0, 0.7, -0.4;
+  MatrixXd V = hessian_times_vector_static_tape_test::directions(4, 5);
+  stan::math::static_tape tape;
+  double fx;
+  VectorXd grad_fx_dot_V;
+  MatrixXd HV;
+  stan::math::hessian_times_vector(tape, f, x, V, fx, grad_fx_dot_V, HV);
+  for (Eigen::Index j = 0; j < V.cols(); ++j) {
+    double fx_j;
+    VectorXd Hv;
+    stan::math::hessian_times_vector(f, x, VectorXd(V.col(j)), fx_j, Hv);
+    EXPECT_FLOAT_EQ(fx_j, fx);
+    EXPECT_MATRIX_NEAR(Hv, HV.col(j), 1e-10);
+  }
+}
+
+TEST(MixFunctor, hessian_times_vector_static_tape_rerecords_on_branch) {
+  using hessian_times_vector_static_tape_test::directions;
+  using hessian_times_vector_static_tape_test::expect_same_products;
+  hessian_times_vector_static_tape_test::branching_fun f;
+  stan::math::static_tape tape;
+  VectorXd x(2);
+  x << 1.5, 2.0;
+  expect_same_products<4>(tape, f, x, directions(2, 3));
+  x << -1.5, 2.0;
+  expect_same_products<4>(tape, f, x, directions(2, 3));
+  x << -0.5, 1.0;
+  expect_same_products<4>(tape, f, x, directions(2, 3));
+}
+
+TEST(MixFunctor, hessian_times_vector_static_tape_falls_back) {
+  using hessian_times_vector_static_tape_test::directions;
+  using hessian_times_vector_static_tape_test::expect_same_products;
+  hessian_times_vector_static_tape_test::unsupported_fun f;
+  stan::math::static_tape tape;
+  VectorXd x(2);
+  x << 2.5, 3.0;
+  expect_same_products<4>(tape, f, x, directions(2, 3));
+  EXPECT_FALSE(tape.is_twice_differentiable());
+  x << 1.5, 2.0;
+  expect_same_products<4>(tape, f, x, directions(2, 3));
+}
+
+TEST(MixFunctor, hessian_times_vector_static_tape_no_directions) {
+  using hessian_times_vector_static_tape_test::directions;
+  using hessian_times_vector_static_tape_test::expect_same_products;
+  hessian_times_vector_static_tape_test::unsupported_fun f;
+  stan::math::static_tape tape;
+  VectorXd x(2);
+  x << 2.5, 3.0;
+  expect_same_products<4>(tape, f, x, directions(2, 0));
+  EXPECT_TRUE(tape.is_recorded());
+  EXPECT_FALSE(tape.is_twice_differentiable());
+  x << 1.5, 2.0;
+  expect_same_products<4>(tape, f, x, directions(2, 0));
+}
+
+TEST(MixFunctor, hessian_times_vector_static_tape_errors) {
+  hessian_times_vector_static_tape_test::all_ops_fun f;
+  VectorXd x(4);
+  x << 1.5, 2.0, 0.7, -0.4;
+  MatrixXd V = hessian_times_vector_static_tape_test::directions(3, 2);
+  stan::math::static_tape tape;
+  double fx;
+  VectorXd grad_fx_dot_V;
+  MatrixXd HV;
+  EXPECT_THROW(stan::math::hessian_times_vector(tape, f, x, V, fx,
+                                                grad_fx_dot_V, HV),
+               std::invalid_argument);
+  EXPECT_THROW(
+      stan::math::gradient_dot_vector(tape, f, x, V, fx, grad_fx_dot_V),
+      std::invalid_argument);
+  EXPECT_THROW(tape.hessian_times_vector(V, grad_fx_dot_V, HV),
+               std::domain_error);
+}
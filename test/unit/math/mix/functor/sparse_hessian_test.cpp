@@ -0,0 +1,64 @@
+#include <stan/math/mix.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <stdexcept>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// chain of pairwise interactions, tridiagonal Hessian
+struct chain_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    T lp = 0;
+    for (int i = 0; i + 1 < x.size(); ++i) {
+      lp += stan::math::square(x(i + 1) - x(i)) * x(i)
+            + stan::math::exp(0.1 * x(i));
+    }
+    return lp + stan::math::log(x(x.size() - 1) + 5.0);
+  }
+};
+
+TEST(MixFunctor, sparse_hessian_detected) {
+  chain_fun f;
+  VectorXd x = VectorXd::LinSpaced(9, -1.0, 2.0);
+
+  double fx;
+  VectorXd grad;
+  Eigen::SparseMatrix<double> H;
+  stan::math::sparse_hessian(f, x, fx, grad, H);
+
+  double fx_ref;
+  VectorXd grad_ref;
+  MatrixXd H_ref;
+  stan::math::hessian(f, x, fx_ref, grad_ref, H_ref);
+  EXPECT_FLOAT_EQ(fx_ref, fx);
+  EXPECT_MATRIX_FLOAT_EQ(grad_ref, grad);
+  EXPECT_MATRIX_FLOAT_EQ(H_ref, MatrixXd(H));
+  EXPECT_EQ(3 * 9 - 2, H.nonZeros());
+}
+
+TEST(MixFunctor, sparse_hessian_pattern) {
+  chain_fun f;
+  VectorXd x = VectorXd::LinSpaced(5, -1.0, 2.0);
+  Eigen::SparseMatrix<double> pattern = MatrixXd::Ones(5, 5).sparseView();
+
+  double fx;
+  VectorXd grad;
+  Eigen::SparseMatrix<double> H;
+  stan::math::sparse_hessian(f, x, pattern, fx, grad, H);
+
+  double fx_ref;
+  VectorXd grad_ref;
+  MatrixXd H_ref;
+  stan::math::hessian(f, x, fx_ref, grad_ref, H_ref);
+  EXPECT_FLOAT_EQ(fx_ref, fx);
+  EXPECT_MATRIX_FLOAT_EQ(grad_ref, grad);
+  EXPECT_MATRIX_FLOAT_EQ(H_ref, MatrixXd(H));
+
+  Eigen::SparseMatrix<double> wrong_size(4, 5);
+  EXPECT_THROW(stan::math::sparse_hessian(f, x, wrong_size, fx, grad, H),
+               std::invalid_argument);
+}
@@ -0,0 +1,142 @@
+#ifdef STAN_OPENCL
+#include <stan/math/prim.hpp>
+#include <stan/math/opencl/prim.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+
+TEST(MathMatrixGPU, from_matrix_cl_async) {
+  using stan::math::from_matrix_cl_async;
+  using stan::math::matrix_cl;
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(50, 30);
+  matrix_cl<double> a_cl(a);
+  matrix_cl<double> b_cl = a_cl * 2.0;
+
+  auto a_res = from_matrix_cl_async(a_cl);
+  auto b_res = from_matrix_cl_async(b_cl);
+  EXPECT_MATRIX_EQ(a, a_res.get());
+  EXPECT_MATRIX_EQ(a * 2.0, b_res.get());
+  EXPECT_TRUE(b_res.ready());
+
+  auto moved = std::move(b_res);
+  EXPECT_MATRIX_EQ(a * 2.0, moved.get());
+}
+
+TEST(MathMatrixGPU, from_matrix_cl_async_views) {
+  using stan::math::from_matrix_cl_async;
+  using stan::math::matrix_cl;
+  using stan::math::matrix_cl_view;
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(4, 4);
+  matrix_cl<double> lower_cl(a, matrix_cl_view::Lower);
+  matrix_cl<double> diag_cl(a, matrix_cl_view::Diagonal);
+  matrix_cl<double> empty_cl(0, 3);
+
+  auto lower_res = from_matrix_cl_async<Eigen::MatrixXd>(lower_cl);
+  auto diag_res = from_matrix_cl_async(diag_cl);
+  auto empty_res = from_matrix_cl_async(empty_cl);
+  Eigen::MatrixXd lower = a.triangularView<Eigen::Lower>();
+  Eigen::MatrixXd diag = a.diagonal().asDiagonal();
+  EXPECT_MATRIX_EQ(lower, lower_res.get());
+  EXPECT_MATRIX_EQ(diag, diag_res.get());
+  EXPECT_EQ(0, empty_res.get().rows());
+  EXPECT_EQ(3, empty_res.get().cols());
+}
+
+TEST(MathMatrixGPU, to_matrix_cl_cached) {
+  using stan::math::from_matrix_cl;
+  using stan::math::to_matrix_cl_cached;
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(20, 10);
+
+  auto a_cl = to_matrix_cl_cached(a);
+  EXPECT_MATRIX_EQ(a, from_matrix_cl(*a_cl));
+  EXPECT_EQ(a_cl, to_matrix_cl_cached(a));
+  EXPECT_EQ(a_cl->buffer()(), to_matrix_cl_cached(a)->buffer()());
+
+  Eigen::MatrixXd a_old = a;
+  a(0, 0) = 3;
+  auto a2_cl = to_matrix_cl_cached(a, 1);
+  EXPECT_NE(a_cl->buffer()(), a2_cl->buffer()());
+  EXPECT_MATRIX_EQ(a, from_matrix_cl(*a2_cl));
+  // the copy of the old version stays valid while it is held
+  EXPECT_MATRIX_EQ(a_old, from_matrix_cl(*a_cl));
+
+  Eigen::Map<Eigen::MatrixXd> a_block(a.data(), 10, 10);
+  EXPECT_MATRIX_EQ(a_block, from_matrix_cl(*to_matrix_cl_cached(a_block)));
+
+  stan::math::clear_matrix_cl_cache<double>();
+  EXPECT_MATRIX_EQ(a, from_matrix_cl(*to_matrix_cl_cached(a, 1)));
+  stan::math::clear_matrix_cl_cache<double>();
+}
+
+TEST(MathMatrixGPU, to_matrix_cl_resident) {
+  using stan::math::from_matrix_cl;
+  using stan::math::to_matrix_cl_resident;
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(300, 200);
+  std::vector<int> b{1, 0, 1, 1};
+
+  cl_mem a_buffer = to_matrix_cl_resident(a)->buffer()();
+  EXPECT_MATRIX_EQ(a, from_matrix_cl(*to_matrix_cl_resident(a)));
+  EXPECT_EQ(a_buffer, to_matrix_cl_resident(a)->buffer()());
+  EXPECT_STD_VECTOR_EQ(b, from_matrix_cl<std::vector<int>>(
+                              *to_matrix_cl_resident(b)));
+
+  a(123, 45) = 7;
+  b[2] = 0;
+  EXPECT_MATRIX_EQ(a, from_matrix_cl(*to_matrix_cl_resident(a)));
+  EXPECT_STD_VECTOR_EQ(b, from_matrix_cl<std::vector<int>>(
+                              *to_matrix_cl_resident(b)));
+
+  stan::math::clear_matrix_cl_cache<double>();
+  stan::math::clear_matrix_cl_cache<int>();
+}
+
+TEST(MathMatrixGPU, matrix_cl_cache_capacity) {
+  using stan::math::from_matrix_cl;
+  using stan::math::to_matrix_cl_resident;
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(20, 10);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(20, 10);
+  const std::size_t bytes = sizeof(double) * a.size();
+  stan::math::set_matrix_cl_cache_capacity<double>(bytes * 3 / 2);
+
+  const auto& cache = stan::math::internal::matrix_cl_cache<double>::instance();
+  cl_mem a_buffer = to_matrix_cl_resident(a)->buffer()();
+  EXPECT_EQ(a_buffer, to_matrix_cl_resident(a)->buffer()());
+  // caching b releases the least recently used copy of a
+  EXPECT_MATRIX_EQ(b, from_matrix_cl(*to_matrix_cl_resident(b)));
+  EXPECT_EQ(1, cache.entries_.size());
+  EXPECT_EQ(bytes, cache.bytes_);
+  EXPECT_MATRIX_EQ(a, from_matrix_cl(*to_matrix_cl_resident(a)));
+  EXPECT_EQ(1, cache.entries_.size());
+
+  // a single copy larger than the capacity is still kept while in use
+  stan::math::set_matrix_cl_cache_capacity<double>(0);
+  auto b_cl = to_matrix_cl_resident(b);
+  EXPECT_EQ(b_cl, to_matrix_cl_resident(b));
+
+  stan::math::set_matrix_cl_cache_capacity<double>(std::size_t{1} << 30);
+  stan::math::clear_matrix_cl_cache<double>();
+}
+
+TEST(MathMatrixGPU, matrix_cl_cache_arguments_over_capacity) {
+  using stan::math::from_matrix_cl;
+  using stan::math::to_matrix_cl_resident;
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(20, 10);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(20, 10);
+  const std::size_t bytes = sizeof(double) * a.size();
+  stan::math::set_matrix_cl_cache_capacity<double>(bytes * 3 / 2);
+
+  // two arguments of one call, which do not fit into the cache together
+  auto a_cl = to_matrix_cl_resident(a);
+  auto b_cl = to_matrix_cl_resident(b);
+  const auto& cache = stan::math::internal::matrix_cl_cache<double>::instance();
+  EXPECT_EQ(1, cache.entries_.size());
+  EXPECT_MATRIX_EQ(a, from_matrix_cl(*a_cl));
+  EXPECT_MATRIX_EQ(b, from_matrix_cl(*b_cl));
+  stan::math::matrix_cl<double> sum_cl
+      = *to_matrix_cl_resident(a) + *to_matrix_cl_resident(b);
+  EXPECT_MATRIX_EQ(a + b, from_matrix_cl(sum_cl));
+
+  stan::math::set_matrix_cl_cache_capacity<double>(std::size_t{1} << 30);
+  stan::math::clear_matrix_cl_cache<double>();
+}
+
+#endif
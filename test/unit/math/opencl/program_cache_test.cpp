@@ -0,0 +1,55 @@
+#ifdef STAN_OPENCL
+
+#include <stan/math/prim.hpp>
+#include <stan/math/opencl/prim.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+TEST(MathGpu, program_cache_key_and_path) {
+  using stan::math::opencl_kernels::internal::program_cache_key;
+  using stan::math::opencl_kernels::internal::program_cache_path;
+  std::vector<std::string> sources{"kernel void a(global int* x){}"};
+  std::string key1 = program_cache_key(sources, " -DA=1");
+  std::string key2 = program_cache_key(sources, " -DA=2");
+  EXPECT_EQ(key1, program_cache_key(sources, " -DA=1"));
+  EXPECT_NE(key1, key2);
+  EXPECT_EQ(program_cache_path("dir", key1), program_cache_path("dir", key1));
+  EXPECT_NE(program_cache_path("dir", key1), program_cache_path("dir", key2));
+}
+
+TEST(MathGpu, program_cache_store_and_load) {
+  using stan::math::opencl_context;
+  namespace internal = stan::math::opencl_kernels::internal;
+  std::vector<std::string> sources{
+      "kernel void program_cache_fill(global int* x){ x[0] = 42; }"};
+  std::string key = internal::program_cache_key(sources, "");
+  std::string path = internal::program_cache_path(".", key);
+  std::remove(path.c_str());
+
+  EXPECT_EQ(nullptr, internal::load_cached_program(path, key)());
+
+  cl::Program program(opencl_context.context(), sources);
+  program.build({opencl_context.device()});
+  internal::store_cached_program(path, key, program);
+
+  EXPECT_EQ(nullptr, internal::load_cached_program(path, key + " ")());
+  cl::Program cached = internal::load_cached_program(path, key);
+  ASSERT_NE(nullptr, cached());
+  cached.build({opencl_context.device()});
+  cl::Kernel kernel(cached, "program_cache_fill");
+
+  cl::Buffer buffer(opencl_context.context(), CL_MEM_READ_WRITE, sizeof(int));
+  kernel.setArg(0, buffer);
+  opencl_context.queue().enqueueNDRangeKernel(kernel, cl::NullRange,
+                                              cl::NDRange(1), cl::NullRange);
+  int res = 0;
+  opencl_context.queue().enqueueReadBuffer(buffer, CL_TRUE, 0, sizeof(int),
+                                           &res);
+  EXPECT_EQ(42, res);
+  std::remove(path.c_str());
+}
+
+#endif
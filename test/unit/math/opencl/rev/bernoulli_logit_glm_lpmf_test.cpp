@@ -203,4 +203,30 @@ TEST(ProbDistributionsBernoulliLogitGLM, opencl_matches_cpu_big) {
       bernoulli_logit_glm_lpmf_functor_propto, y, x, alpha, beta);
 }
 
+TEST(ProbDistributionsBernoulliLogitGLM, opencl_resident_data) {
+  int N = 153;
+  int M = 71;
+
+  vector<int> y(N);
+  for (int i = 0; i < N; i++) {
+    y[i] = Array<int, Dynamic, 1>::Random(1, 1).abs()(0) % 2;
+  }
+  Matrix<double, Dynamic, Dynamic> x
+      = Matrix<double, Dynamic, Dynamic>::Random(N, M);
+  Matrix<double, Dynamic, 1> beta = Matrix<double, Dynamic, 1>::Random(M, 1);
+  double alpha = 0.3;
+
+  for (int i = 0; i < 3; i++) {
+    beta(0) += 0.1;
+    matrix_cl<double> beta_cl(beta);
+    double res_cl = stan::math::bernoulli_logit_glm_lpmf(
+        *stan::math::to_matrix_cl_resident(y),
+        *stan::math::to_matrix_cl_resident(x), alpha, beta_cl);
+    double res = stan::math::bernoulli_logit_glm_lpmf(y, x, alpha, beta);
+    expect_near_rel("resident data", res, res_cl);
+  }
+  stan::math::clear_matrix_cl_cache<double>();
+  stan::math::clear_matrix_cl_cache<int>();
+}
+
 #endif
@@ -226,4 +226,32 @@ TEST(ProbDistributionsNormalIdGLM, opencl_matches_cpu_big) {
       normal_id_glm_lpdf_functor_propto, y, x, alpha, beta, sigma);
 }
 
+TEST(ProbDistributionsNormalIdGLM, opencl_resident_data_changed_in_place) {
+  int N = 153;
+  int M = 71;
+
+  Matrix<double, Dynamic, 1> y = Matrix<double, Dynamic, 1>::Random(N, 1);
+  Matrix<double, Dynamic, Dynamic> x
+      = Matrix<double, Dynamic, Dynamic>::Random(N, M);
+  Matrix<double, Dynamic, 1> beta = Matrix<double, Dynamic, 1>::Random(M, 1);
+  matrix_cl<double> beta_cl(beta);
+  double alpha = 0.3;
+  double sigma = 1.2;
+
+  for (int i = 0; i < 3; i++) {
+    // the host data keeps its address and size, so only the new contents
+    // tell the cache to upload it again
+    x(i, 2 * i) += 0.5;
+    y(N - 1 - i) -= 0.25;
+    const double* x_data = x.data();
+    double res_cl = stan::math::normal_id_glm_lpdf(
+        *stan::math::to_matrix_cl_resident(y),
+        *stan::math::to_matrix_cl_resident(x), alpha, beta_cl, sigma);
+    double res = stan::math::normal_id_glm_lpdf(y, x, alpha, beta, sigma);
+    EXPECT_EQ(x_data, x.data());
+    expect_near_rel("resident data changed in place", res, res_cl);
+  }
+  stan::math::clear_matrix_cl_cache<double>();
+}
+
 #endif
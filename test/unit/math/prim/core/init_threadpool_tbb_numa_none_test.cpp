@@ -0,0 +1,53 @@
+#include <stan/math/prim/core.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#ifdef TBB_INTERFACE_NEW
+TEST(intel_tbb_numa, numa_arena_restores_placement) {
+  using stan::math::thread_affinity;
+  tbb::task_arena& arena
+      = stan::math::init_threadpool_tbb(4, thread_affinity::none);
+  const int num_cpus = stan::math::internal::available_cpus().size();
+
+  // count the threads which are pinned to a node or to fewer CPUs than the
+  // process may use
+  std::atomic<int> num_pinned{0};
+  auto count_pinned = [&](const tbb::blocked_range<std::size_t>& r) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    if (stan::math::internal::thread_numa_node() >= 0) {
+      ++num_pinned;
+    }
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (CPU_COUNT(&cpu_set) != num_cpus) {
+      ++num_pinned;
+    }
+#endif
+  };
+
+  for (std::size_t node = 0; node < stan::math::num_numa_nodes(); ++node) {
+    stan::math::numa_arena(node).execute([&] {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, 1000, 10),
+                        [&](const tbb::blocked_range<std::size_t>& r) {
+                          std::this_thread::sleep_for(
+                              std::chrono::microseconds(100));
+                        });
+    });
+    // workers back in the threadpool arena are not pinned anymore
+    num_pinned = 0;
+    arena.execute([&] {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, 1000, 10),
+                        count_pinned);
+    });
+    EXPECT_EQ(0, num_pinned);
+  }
+}
+#endif
@@ -0,0 +1,76 @@
+#include <stan/math/prim/core.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef TBB_INTERFACE_NEW
+TEST(intel_tbb_numa, concurrent_initialization) {
+  using stan::math::thread_affinity;
+  std::vector<tbb::task_arena*> arenas(8, nullptr);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < arenas.size(); ++t) {
+    threads.emplace_back([&arenas, t] {
+      stan::math::init_threadpool_tbb(4, thread_affinity::numa_node);
+      arenas[t] = &stan::math::numa_arena(0);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (tbb::task_arena* arena : arenas) {
+    EXPECT_EQ(&stan::math::numa_arena(0), arena);
+  }
+}
+
+TEST(intel_tbb_numa, numa_arena) {
+  using stan::math::thread_affinity;
+  stan::math::init_threadpool_tbb(4, thread_affinity::numa_node);
+  EXPECT_EQ(thread_affinity::numa_node,
+            stan::math::internal::tbb_thread_affinity());
+
+  // the affinity is only set by the first call
+  stan::math::init_threadpool_tbb(4, thread_affinity::core);
+  EXPECT_EQ(thread_affinity::numa_node,
+            stan::math::internal::tbb_thread_affinity());
+
+  const std::size_t num_nodes = stan::math::num_numa_nodes();
+  ASSERT_GE(num_nodes, 1);
+  const auto& nodes = stan::math::internal::numa_node_cpus();
+  for (std::size_t node = 0; node < num_nodes; ++node) {
+    std::atomic<int> num_misplaced{0};
+    std::vector<int> sum(1000, 0);
+    stan::math::numa_arena(node).execute([&] {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, sum.size(), 10),
+                        [&](const tbb::blocked_range<std::size_t>& r) {
+#ifdef __linux__
+                          // workers of the arena run on the node
+                          const int node_of_thread
+                              = stan::math::internal::thread_numa_node();
+                          const int cpu = sched_getcpu();
+                          if (node_of_thread >= 0
+                              && (node_of_thread != static_cast<int>(node)
+                                  || std::find(nodes[node].begin(),
+                                               nodes[node].end(), cpu)
+                                         == nodes[node].end())) {
+                            ++num_misplaced;
+                          }
+#endif
+                          for (std::size_t i = r.begin(); i < r.end(); ++i) {
+                            sum[i] = i;
+                          }
+                        });
+    });
+    EXPECT_EQ(0, num_misplaced);
+    for (std::size_t i = 0; i < sum.size(); ++i) {
+      EXPECT_EQ(i, sum[i]);
+    }
+  }
+
+  EXPECT_THROW(stan::math::numa_arena(num_nodes), std::invalid_argument);
+}
+#endif
@@ -0,0 +1,96 @@
+#include <stan/math/prim/core.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Can't easily use std::string as putenv require non-const char*
+void set_thread_affinity(const char* value) {
+  static char env_string[256];
+  snprintf(env_string, sizeof(env_string), "STAN_THREAD_AFFINITY=%s", value);
+  putenv(env_string);
+}
+
+TEST(thread_affinity, parse_cpu_list) {
+  using stan::math::internal::parse_cpu_list;
+  EXPECT_EQ(std::vector<int>({0}), parse_cpu_list("0"));
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 8, 10, 11}),
+            parse_cpu_list("0-3,8,10-11\n"));
+  EXPECT_TRUE(parse_cpu_list("").empty());
+  EXPECT_TRUE(parse_cpu_list("\n").empty());
+
+  EXPECT_THROW(parse_cpu_list("a"), std::invalid_argument);
+  EXPECT_THROW(parse_cpu_list("1-"), std::invalid_argument);
+  EXPECT_THROW(parse_cpu_list("3-1"), std::invalid_argument);
+  EXPECT_THROW(parse_cpu_list("-1"), std::invalid_argument);
+}
+
+TEST(thread_affinity, numa_node_cpus) {
+  const std::vector<int> cpus = stan::math::internal::available_cpus();
+  const auto& nodes = stan::math::internal::numa_node_cpus();
+  ASSERT_FALSE(nodes.empty());
+  std::size_t num_cpus = 0;
+  for (const auto& node_cpus : nodes) {
+    EXPECT_FALSE(node_cpus.empty());
+    for (int cpu : node_cpus) {
+      EXPECT_NE(cpus.end(), std::find(cpus.begin(), cpus.end(), cpu));
+    }
+    num_cpus += node_cpus.size();
+  }
+  EXPECT_EQ(cpus.size(), num_cpus);
+}
+
+TEST(thread_affinity, worker_cpus) {
+  using stan::math::thread_affinity;
+  using stan::math::internal::worker_cpus;
+  const std::vector<std::vector<int>> nodes{{0, 1, 2}, {3, 4, 5}};
+
+  EXPECT_EQ(nodes[0], worker_cpus(0, thread_affinity::numa_node, nodes));
+  EXPECT_EQ(nodes[1], worker_cpus(1, thread_affinity::numa_node, nodes));
+  EXPECT_EQ(nodes[0], worker_cpus(2, thread_affinity::numa_node, nodes));
+
+  std::vector<int> cores;
+  for (std::size_t worker = 0; worker < 8; ++worker) {
+    const std::vector<int> cpus
+        = worker_cpus(worker, thread_affinity::core, nodes);
+    ASSERT_EQ(1, cpus.size());
+    cores.push_back(cpus[0]);
+  }
+  EXPECT_EQ(std::vector<int>({0, 3, 1, 4, 2, 5, 0, 3}), cores);
+}
+
+TEST(thread_affinity, pin_current_thread) {
+  const std::vector<int> cpus = stan::math::internal::numa_node_cpus()[0];
+  std::thread pinned([&] {
+#ifdef __linux__
+    EXPECT_TRUE(stan::math::internal::pin_current_thread({cpus[0]}));
+    EXPECT_EQ(cpus[0], sched_getcpu());
+#else
+    EXPECT_FALSE(stan::math::internal::pin_current_thread({cpus[0]}));
+#endif
+  });
+  pinned.join();
+}
+
+TEST(thread_affinity, get_thread_affinity) {
+  using stan::math::thread_affinity;
+  using stan::math::internal::get_thread_affinity;
+#ifdef STAN_THREADS
+  set_thread_affinity("none");
+  EXPECT_EQ(thread_affinity::none, get_thread_affinity());
+  set_thread_affinity("numa");
+  EXPECT_EQ(thread_affinity::numa_node, get_thread_affinity());
+  set_thread_affinity("core");
+  EXPECT_EQ(thread_affinity::core, get_thread_affinity());
+  set_thread_affinity("socket");
+  EXPECT_THROW_MSG(get_thread_affinity(), std::invalid_argument,
+                   "must be none, numa or core");
+#else
+  set_thread_affinity("core");
+  EXPECT_EQ(thread_affinity::none, get_thread_affinity());
+#endif
+  set_thread_affinity("none");
+}
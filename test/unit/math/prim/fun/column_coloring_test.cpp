@@ -0,0 +1,61 @@
+#include <stan/math/prim.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+namespace column_coloring_test {
+void expect_structurally_orthogonal(const Eigen::SparseMatrix<double>& pattern,
+                                    const std::vector<int>& color) {
+  ASSERT_EQ(pattern.cols(), color.size());
+  Eigen::MatrixXd dense = pattern;
+  for (int j = 0; j < pattern.cols(); ++j) {
+    for (int k = j + 1; k < pattern.cols(); ++k) {
+      if (color[j] != color[k]) {
+        continue;
+      }
+      for (int i = 0; i < pattern.rows(); ++i) {
+        EXPECT_FALSE(dense(i, j) != 0 && dense(i, k) != 0)
+            << "columns " << j << " and " << k << " share row " << i;
+      }
+    }
+  }
+}
+}  // namespace column_coloring_test
+
+TEST(MathFunctions, column_coloring_tridiagonal) {
+  const int n = 12;
+  Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - 1); j < std::min(n, i + 2); ++j) {
+      dense(i, j) = 1;
+    }
+  }
+  Eigen::SparseMatrix<double> pattern = dense.sparseView();
+  std::vector<int> color = stan::math::column_coloring(pattern);
+  column_coloring_test::expect_structurally_orthogonal(pattern, color);
+  EXPECT_EQ(3, *std::max_element(color.begin(), color.end()) + 1);
+}
+
+TEST(MathFunctions, column_coloring_dense_and_diagonal) {
+  Eigen::SparseMatrix<double> dense
+      = Eigen::MatrixXd::Ones(4, 5).sparseView();
+  std::vector<int> color = stan::math::column_coloring(dense);
+  column_coloring_test::expect_structurally_orthogonal(dense, color);
+  EXPECT_EQ(5, *std::max_element(color.begin(), color.end()) + 1);
+
+  Eigen::SparseMatrix<double> diagonal
+      = Eigen::MatrixXd::Identity(6, 6).sparseView();
+  color = stan::math::column_coloring(diagonal);
+  for (int c : color) {
+    EXPECT_EQ(0, c);
+  }
+}
+
+TEST(MathFunctions, column_coloring_empty) {
+  Eigen::SparseMatrix<double> pattern(3, 0);
+  EXPECT_TRUE(stan::math::column_coloring(pattern).empty());
+  Eigen::SparseMatrix<double> zero(3, 2);
+  std::vector<int> color = stan::math::column_coloring(zero);
+  EXPECT_EQ(0, color[0]);
+  EXPECT_EQ(0, color[1]);
+}
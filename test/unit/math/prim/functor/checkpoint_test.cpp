@@ -0,0 +1,18 @@
+#include <stan/math/prim.hpp>
+#include <gtest/gtest.h>
+
+TEST(MathFunctions, checkpoint_double) {
+  auto f = [](const auto& x, double c) { return stan::math::sum(x) * c; };
+  Eigen::VectorXd x(3);
+  x << 1.0, 2.0, 3.0;
+  EXPECT_FLOAT_EQ(12.0, stan::math::checkpoint(f, x, 2.0));
+}
+
+TEST(MathFunctions, checkpoint_loop_double) {
+  auto step = [](int i, const auto& y, double c) { return y * c + i; };
+  EXPECT_FLOAT_EQ(1.0, stan::math::checkpoint_loop(step, 1, 0.5, 2.0));
+  EXPECT_FLOAT_EQ(((0.5 * 2.0 + 0) * 2.0 + 1) * 2.0 + 2,
+                  stan::math::checkpoint_loop(step, 3, 0.5, 2.0));
+  EXPECT_THROW(stan::math::checkpoint_loop(step, 0, 0.5, 2.0),
+               std::domain_error);
+}
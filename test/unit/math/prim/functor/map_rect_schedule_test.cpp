@@ -0,0 +1,45 @@
+#include <stan/math/prim.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(MathPrim_map_rect_schedule, job_order) {
+  stan::math::map_rect_schedule schedule;
+  using order_t = std::vector<std::size_t>;
+
+  EXPECT_EQ(order_t({0, 1, 2, 3}), schedule.job_order(4));
+
+  schedule.record({0.1, 0.4, 0.2, 0.4});
+  EXPECT_EQ(order_t({1, 3, 2, 0}), schedule.job_order(4));
+  EXPECT_EQ(order_t({0, 1, 2}), schedule.job_order(3));
+
+  schedule.set_cost_hints({1.0, 0.0, 3.0, 2.0});
+  EXPECT_EQ(order_t({2, 3, 0, 1}), schedule.job_order(4));
+  schedule.clear_cost_hints();
+  EXPECT_EQ(order_t({1, 3, 2, 0}), schedule.job_order(4));
+
+  EXPECT_THROW(schedule.set_cost_hints({1.0, -1.0}), std::domain_error);
+  EXPECT_THROW(schedule.set_chunk_size(0), std::domain_error);
+  schedule.set_chunk_size(3);
+  EXPECT_EQ(3, schedule.chunk_size());
+}
+
+TEST(MathPrim_map_rect_schedule, stats) {
+  stan::math::map_rect_schedule schedule;
+  EXPECT_EQ(0, schedule.num_calls());
+
+  schedule.record({1.0, 2.0});
+  schedule.record({3.0, 1.0});
+  EXPECT_EQ(2, schedule.num_calls());
+  EXPECT_EQ(std::vector<double>({3.0, 1.0}), schedule.last_job_seconds());
+  EXPECT_EQ(std::vector<double>({2.0, 1.5}), schedule.mean_job_seconds());
+  EXPECT_EQ(std::vector<double>({3.0, 2.0}), schedule.max_job_seconds());
+
+  schedule.record({1.0, 1.0, 1.0});
+  EXPECT_EQ(1, schedule.num_calls());
+  EXPECT_EQ(std::vector<double>({1.0, 1.0, 1.0}), schedule.mean_job_seconds());
+
+  schedule.reset_stats();
+  EXPECT_EQ(0, schedule.num_calls());
+  EXPECT_TRUE(schedule.last_job_seconds().empty());
+  EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), schedule.job_order(3));
+}
@@ -8,6 +8,7 @@
 
 #include <test/unit/math/prim/functor/faulty_functor.hpp>
 
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -29,6 +30,16 @@ struct mock_reduce {
   }
 };
 
+struct mock_shared_reduce {
+  matrix_d operator()(const vector_d& shared_params,
+                      const vector_d& job_specific_params,
+                      const std::vector<double>& x_r,
+                      const std::vector<int>& x_i,
+                      std::ostream* msgs = nullptr) const {
+    return shared_params * job_specific_params(0);
+  }
+};
+
 template <typename F, typename T_shared_param, typename T_job_param>
 struct mock_combine {
  public:
@@ -60,6 +71,10 @@ typedef stan::math::mpi_parallel_call<2, mock_reduce, mock_combine_dd>
     mock_call_t;
 STAN_REGISTER_MPI_DISTRIBUTED_APPLY(mock_call_t)
 
+typedef stan::math::mpi_parallel_call<3, mock_shared_reduce, mock_combine_dd>
+    mock_shared_call_t;
+STAN_REGISTER_MPI_DISTRIBUTED_APPLY(mock_shared_call_t)
+
 struct MpiJob : public ::testing::Test {
   Eigen::VectorXd shared_params_d;
   std::vector<Eigen::VectorXd> job_params_d;
@@ -201,6 +216,54 @@ TEST_F(MpiJob, size_mismatch_cached_jobs_dd) {
                std::invalid_argument);
 }
 
+TEST_F(MpiJob, shared_params_changes_dd) {
+  shared_params_d = vector_d::LinSpaced(20, 1, 20);
+
+  // the shared parameters are sent in full on the first call, not at all
+  // while unchanged and only the changed ones if few changed
+  std::vector<vector_d> shared_params_calls;
+  shared_params_calls.push_back(shared_params_d);
+  shared_params_calls.push_back(shared_params_d);
+  shared_params_d(3) = -4;
+  shared_params_d(17) = 0.5;
+  shared_params_calls.push_back(shared_params_d);
+  shared_params_calls.push_back(shared_params_d * 3);
+  shared_params_calls.push_back(shared_params_d * 3);
+
+  for (const vector_d& shared_params : shared_params_calls) {
+    std::shared_ptr<mock_shared_call_t> call;
+    EXPECT_NO_THROW((call = std::shared_ptr<mock_shared_call_t>(
+                         new mock_shared_call_t(shared_params, job_params_d,
+                                                x_r, x_i))));
+
+    matrix_d res = call->reduce_combine();
+
+    ASSERT_EQ(res.rows(), 20);
+    ASSERT_EQ(res.cols(), N);
+    for (std::size_t n = 0; n != N; ++n) {
+      EXPECT_MATRIX_EQ(res.col(n), shared_params * (n + 1.0));
+    }
+  }
+}
+
+TEST_F(MpiJob, shared_params_signed_zero_dd) {
+  // a change of the sign of zero must reach the workers
+  shared_params_d = vector_d::LinSpaced(20, 1, 20);
+  shared_params_d(5) = 0.0;
+  for (int k = 0; k < 3; ++k) {
+    std::shared_ptr<mock_shared_call_t> call(
+        new mock_shared_call_t(shared_params_d, job_params_d, x_r, x_i));
+    matrix_d res = call->reduce_combine();
+    ASSERT_EQ(res.cols(), N);
+    for (std::size_t n = 0; n != N; ++n) {
+      for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(std::signbit(shared_params_d(i)), std::signbit(res(i, n)));
+      }
+    }
+    shared_params_d(5) = -shared_params_d(5);
+  }
+}
+
 TEST_F(MpiJob, root_not_confused_dd) {
   // the root must not call the distributed_apply ever
   EXPECT_THROW_MSG(mock_call_t::distributed_apply(), std::runtime_error,
@@ -0,0 +1,53 @@
+#include <stan/math.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <sstream>
+#include <vector>
+
+namespace parallel_map_test {
+// scales the first `n` shared coefficients by the sliced element
+struct scale_head {
+  template <typename T1, typename T2>
+  inline auto operator()(const T1& x, std::size_t i, std::ostream* msgs,
+                         const T2& beta) const {
+    if (msgs) {
+      *msgs << i;
+    }
+    return stan::math::multiply(x, beta.head(i + 1)).eval();
+  }
+};
+}  // namespace parallel_map_test
+
+TEST(StanMathPrim_parallel_map, value) {
+  std::vector<double> x{1.0, 2.0, -0.5, 3.0};
+  Eigen::VectorXd beta = Eigen::VectorXd::Random(x.size());
+  std::stringstream msgs;
+
+  std::vector<Eigen::VectorXd> res
+      = stan::math::parallel_map<parallel_map_test::scale_head>(x, 1, &msgs,
+                                                                beta);
+
+  ASSERT_EQ(x.size(), res.size());
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_MATRIX_FLOAT_EQ(x[i] * beta.head(i + 1), res[i]);
+  }
+  EXPECT_EQ("0123", msgs.str());
+}
+
+TEST(StanMathPrim_parallel_map, empty) {
+  std::vector<double> x;
+  Eigen::VectorXd beta(2);
+  EXPECT_EQ(0, stan::math::parallel_map<parallel_map_test::scale_head>(
+                   x, 1, nullptr, beta)
+                   .size());
+}
+
+TEST(StanMathPrim_parallel_map, grainsize) {
+  std::vector<double> x{1.0, 2.0};
+  Eigen::VectorXd beta(2);
+  EXPECT_THROW(stan::math::parallel_map<parallel_map_test::scale_head>(
+                   x, 0, nullptr, beta),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::parallel_map<parallel_map_test::scale_head>(
+      x, 5, nullptr, beta));
+}
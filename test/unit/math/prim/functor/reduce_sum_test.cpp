@@ -2,6 +2,7 @@
 #include <test/unit/math/prim/functor/reduce_sum_util.hpp>
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <vector>
 #include <set>
 
@@ -59,6 +60,112 @@ TEST(StanMathPrim_reduce_sum, grainsize) {
                                                           get_new_msg()));
 }
 
+TEST(StanMathPrim_reduce_sum, auto_value) {
+  using stan::math::test::count_lpdf;
+  using stan::math::test::get_new_msg;
+  double lambda_d = 10.0;
+  const std::size_t elems = 10000;
+  std::vector<int> data(elems);
+
+  for (std::size_t i = 0; i != elems; ++i)
+    data[i] = i;
+
+  std::vector<int> idata;
+  std::vector<double> vlambda_d(1, lambda_d);
+  double poisson_lpdf_ref = stan::math::poisson_lpmf(data, lambda_d);
+
+  auto& tuner = stan::math::reduce_sum_tuner<count_lpdf<double>>();
+  tuner.reset();
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_FLOAT_EQ(stan::math::reduce_sum_auto<count_lpdf<double>>(
+                        data, get_new_msg(), vlambda_d, idata),
+                    poisson_lpdf_ref);
+  }
+  tuner.freeze(elems);
+  double frozen_lpdf = stan::math::reduce_sum_auto<count_lpdf<double>>(
+      data, get_new_msg(), vlambda_d, idata);
+  EXPECT_FLOAT_EQ(frozen_lpdf, poisson_lpdf_ref);
+  EXPECT_EQ(frozen_lpdf, stan::math::reduce_sum_auto<count_lpdf<double>>(
+                             data, get_new_msg(), vlambda_d, idata));
+  tuner.reset();
+}
+
+TEST(StanMathPrim_reduce_sum, grainsize_tuner) {
+  stan::math::reduce_sum_grainsize_tuner tuner(1);
+  const std::size_t num_terms = 1 << 12;
+  // run time per term is smallest for a grainsize of 64
+  auto seconds = [&](int grainsize) {
+    return num_terms * std::abs(std::log2(grainsize) - 6.0);
+  };
+  int calls = 0;
+  while (!tuner.converged()) {
+    int grainsize = tuner.grainsize(num_terms);
+    EXPECT_GE(grainsize, 1);
+    EXPECT_LE(grainsize, num_terms);
+    tuner.record(grainsize, num_terms, seconds(grainsize));
+    ASSERT_LT(++calls, 30);
+  }
+  EXPECT_EQ(64, tuner.best_grainsize());
+  EXPECT_EQ(64, tuner.grainsize(num_terms));
+  EXPECT_FALSE(tuner.frozen());
+
+  tuner.freeze_at(8);
+  EXPECT_TRUE(tuner.frozen());
+  tuner.record(8, num_terms, 0.0);
+  EXPECT_EQ(8, tuner.grainsize(num_terms));
+  EXPECT_EQ(3, tuner.grainsize(3));
+  EXPECT_THROW(tuner.freeze_at(0), std::domain_error);
+
+  tuner.reset();
+  EXPECT_FALSE(tuner.converged());
+  EXPECT_EQ(0, tuner.best_grainsize());
+  EXPECT_THROW(stan::math::reduce_sum_grainsize_tuner(0), std::domain_error);
+}
+
+TEST(StanMathPrim_reduce_sum, grainsize_tuner_fewer_terms) {
+  stan::math::reduce_sum_grainsize_tuner tuner(1);
+  const std::size_t num_terms = 1 << 12;
+  tuner.grainsize(num_terms);
+  // a later call has fewer terms than the first candidate
+  const std::size_t few_terms = 1;
+  int calls = 0;
+  while (!tuner.converged()) {
+    int grainsize = tuner.grainsize(few_terms);
+    EXPECT_EQ(1, grainsize);
+    tuner.record(grainsize, few_terms, 1.0);
+    ASSERT_LT(++calls, 30);
+  }
+  EXPECT_EQ(1, tuner.best_grainsize());
+}
+
+TEST(StanMathPrim_reduce_sum, auto_shrinking_vmapped) {
+  using stan::math::test::count_lpdf;
+  using stan::math::test::get_new_msg;
+  double lambda_d = 10.0;
+  std::vector<int> data(10000);
+  for (std::size_t i = 0; i != data.size(); ++i)
+    data[i] = i;
+  std::vector<int> idata;
+  std::vector<double> vlambda_d(1, lambda_d);
+
+  auto& tuner = stan::math::reduce_sum_tuner<count_lpdf<double>>();
+  tuner.reset();
+  stan::math::reduce_sum_auto<count_lpdf<double>>(data, get_new_msg(),
+                                                  vlambda_d, idata);
+  data.resize(3);
+  double poisson_lpdf_ref = stan::math::poisson_lpmf(data, lambda_d);
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_FLOAT_EQ(stan::math::reduce_sum_auto<count_lpdf<double>>(
+                        data, get_new_msg(), vlambda_d, idata),
+                    poisson_lpdf_ref);
+  }
+#ifdef STAN_THREADS
+  EXPECT_TRUE(tuner.converged());
+  EXPECT_LE(tuner.grainsize(data.size()), data.size());
+#endif
+  tuner.reset();
+}
+
 TEST(StanMathPrim_reduce_sum, start_end_slice) {
   using stan::math::test::get_new_msg;
   using stan::math::test::start_end_lpdf;
@@ -146,6 +146,23 @@ struct grouped_count_lpdf {
   }
 };
 
+/**
+ * sums squares of coefficients selected by the sliced indices, with shared
+ * arguments of matrix and scalar type
+ */
+struct indexed_square_lpdf {
+  template <typename VecT, typename T>
+  inline auto operator()(const std::vector<int>& idx_slice, std::size_t start,
+                         std::size_t end, std::ostream* msgs,
+                         const VecT& beta, const T& alpha) const {
+    stan::return_type_t<VecT, T> result = 0.0;
+    for (int idx : idx_slice) {
+      result += alpha * beta(idx) * beta(idx);
+    }
+    return result;
+  }
+};
+
 template <typename T1, typename T2, typename... Args>
 void test_slices(T1 result, T2&& vec_value, Args&&... args) {
   using stan::math::test::get_new_msg;
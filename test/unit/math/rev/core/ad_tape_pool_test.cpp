@@ -0,0 +1,131 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(ad_tape_pool, acquire_release) {
+  using stan::math::ChainableStack;
+  using stan::math::var;
+  stan::math::ad_tape_pool pool;
+  EXPECT_EQ(0, pool.size());
+
+  stan::math::ad_tape_pool::tape_t* tape = pool.acquire();
+  ASSERT_TRUE(tape);
+  EXPECT_EQ(0, pool.size());
+
+  // a returned tape is emptied but keeps its memory
+  ChainableStack::AutodiffStackStorage* main_tape = ChainableStack::instance_;
+  ChainableStack::instance_ = tape;
+  std::vector<var> x;
+  for (int i = 0; i < 100000; ++i) {
+    x.push_back(var(i) * 2.0);
+  }
+  ChainableStack::instance_ = main_tape;
+  const std::size_t bytes_reserved = tape->memalloc_.bytes_reserved();
+  EXPECT_GT(bytes_reserved, stan::math::internal::DEFAULT_INITIAL_NBYTES);
+  pool.release(tape);
+  EXPECT_EQ(1, pool.size());
+
+  stan::math::ad_tape_pool::tape_t* reused = pool.acquire();
+  EXPECT_EQ(tape, reused);
+  EXPECT_TRUE(reused->var_stack_.empty());
+  EXPECT_EQ(0, reused->memalloc_.bytes_used());
+  EXPECT_EQ(bytes_reserved, reused->memalloc_.bytes_reserved());
+  pool.release(reused);
+
+  pool.reserve(4);
+  EXPECT_EQ(4, pool.size());
+  pool.reserve(2);
+  EXPECT_EQ(4, pool.size());
+}
+
+TEST(ad_tape_pool, release_detaches_static_tape) {
+  using stan::math::ChainableStack;
+  using stan::math::var;
+  stan::math::ad_tape_pool pool;
+  stan::math::ad_tape_pool::tape_t* tape = pool.acquire();
+  const int num_recording
+      = stan::math::internal::num_recording_static_tapes().load();
+
+  // a static_tape left recording on a returned tape
+  ChainableStack::AutodiffStackStorage* main_tape = ChainableStack::instance_;
+  ChainableStack::instance_ = tape;
+  stan::math::static_tape static_tape;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x(1);
+  x << 2.0;
+  static_tape.start_recording(x);
+  var y = x(0) * x(0);
+  ChainableStack::instance_ = main_tape;
+  pool.release(tape);
+
+  EXPECT_EQ(nullptr, tape->static_tape_);
+  EXPECT_EQ(num_recording,
+            stan::math::internal::num_recording_static_tapes().load());
+  EXPECT_FALSE(static_tape.is_recording());
+  static_tape.stop_recording(y);
+  EXPECT_FALSE(static_tape.is_replayable());
+}
+
+TEST(ad_tape_pool, full_pool) {
+  stan::math::ad_tape_pool pool;
+  const std::size_t max_tapes = stan::math::ad_tape_pool::max_tapes;
+  pool.reserve(max_tapes + 1);
+  EXPECT_EQ(max_tapes, pool.size());
+  pool.release(new stan::math::ad_tape_pool::tape_t());
+  EXPECT_EQ(max_tapes, pool.size());
+}
+
+TEST(ad_tape_pool, concurrent_checkout) {
+  stan::math::ad_tape_pool pool;
+  pool.reserve(2);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&pool] {
+      for (int i = 0; i < 1000; ++i) {
+        pool.release(pool.acquire());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_GE(pool.size(), 2);
+  EXPECT_LE(pool.size(), 8);
+}
+
+// worker threads have their own tape only with STAN_THREADS
+#ifdef STAN_THREADS
+TEST(ad_tape_observer, scheduler_entry_exit) {
+  using stan::math::ChainableStack;
+  using stan::math::var;
+
+  std::thread worker([] {
+    stan::math::ad_tape_pool& pool = stan::math::get_ad_tape_pool();
+    ASSERT_FALSE(ChainableStack::instance_);
+    stan::math::global_observer.on_scheduler_entry(true);
+    ChainableStack::AutodiffStackStorage* tape = ChainableStack::instance_;
+    ASSERT_TRUE(tape);
+    // nested entries keep the tape
+    stan::math::global_observer.on_scheduler_entry(true);
+    stan::math::global_observer.on_scheduler_exit(true);
+    EXPECT_EQ(tape, ChainableStack::instance_);
+
+    var x = 2.0;
+    var y = x * x;
+    y.grad();
+    EXPECT_FLOAT_EQ(4.0, x.adj());
+
+    const std::size_t pool_size = pool.size();
+    stan::math::global_observer.on_scheduler_exit(true);
+    EXPECT_FALSE(ChainableStack::instance_);
+    EXPECT_EQ(pool_size + 1, pool.size());
+
+    // the tape is reused by the next entry
+    stan::math::global_observer.on_scheduler_entry(true);
+    EXPECT_EQ(0, ChainableStack::instance_->memalloc_.bytes_used());
+    EXPECT_TRUE(ChainableStack::instance_->var_stack_.empty());
+    stan::math::global_observer.on_scheduler_exit(true);
+  });
+  worker.join();
+}
+#endif
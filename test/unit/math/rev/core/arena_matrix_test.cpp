@@ -104,3 +104,14 @@ TEST(AgradRevArenaMat, arena_matrix_transpose_test) {
 
   stan::math::recover_memory();
 }
+
+TEST(AgradRevArenaMat, arena_matrix_simd_aligned) {
+  using stan::math::arena_matrix;
+  for (int n = 8; n < 2000; n = 2 * n + 1) {
+    arena_matrix<Eigen::MatrixXd> x(n, 3);
+    EXPECT_TRUE(stan::math::is_aligned(x.data(), STAN_ARENA_ALIGNMENT));
+    arena_matrix<Eigen::VectorXd> y = Eigen::VectorXd::Ones(n);
+    EXPECT_TRUE(stan::math::is_aligned(y.data(), STAN_ARENA_ALIGNMENT));
+  }
+  stan::math::recover_memory();
+}
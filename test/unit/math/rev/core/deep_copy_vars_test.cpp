@@ -305,3 +305,19 @@ TEST(AgradRev_deep_copy_vars, std_vector_eigen_matrix_var_arg) {
       EXPECT_NE(out[i](j).vi_, arg[i](j).vi_);
     }
 }
+
+TEST(AgradRev_deep_copy_vars, var_matrix_arg) {
+  stan::math::var_value<Eigen::MatrixXd> arg = Eigen::MatrixXd::Random(5, 3);
+  arg.adj().setConstant(2.0);
+
+  decltype(stan::math::deep_copy_vars(arg)) out
+      = stan::math::deep_copy_vars(arg);
+
+  EXPECT_NE(out.vi_, arg.vi_);
+  EXPECT_EQ(out.val().data(), arg.val().data());
+  EXPECT_NE(out.adj().data(), arg.adj().data());
+  for (int i = 0; i < arg.size(); ++i) {
+    EXPECT_EQ(out.adj()(i), 0.0);
+    EXPECT_EQ(arg.adj()(i), 2.0);
+  }
+}
@@ -0,0 +1,68 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <thread>
+#include <vector>
+
+// worker threads have their own tape only with STAN_THREADS
+#ifdef STAN_THREADS
+TEST(ad_tape_observer, relocate_tape) {
+  using stan::math::ChainableStack;
+  using stan::math::var;
+
+  std::thread worker([] {
+    stan::math::global_observer.on_scheduler_entry(true);
+    var x = 2.0;
+    var y = x * x;
+    // a tape in use is kept
+    ChainableStack::AutodiffStackStorage* instance = ChainableStack::instance_;
+    stan::math::internal::thread_numa_node() = 1;
+    stan::math::ad_tape_observer::relocate_tape();
+    EXPECT_EQ(instance, ChainableStack::instance_);
+    EXPECT_EQ(-1, stan::math::internal::thread_ad_tape_checkout().node_);
+    y.grad();
+    EXPECT_FLOAT_EQ(4.0, x.adj());
+
+    // an empty tape is swapped for a tape of the new node
+    stan::math::recover_memory();
+    stan::math::ad_tape_observer::relocate_tape();
+    ASSERT_TRUE(ChainableStack::instance_);
+    EXPECT_EQ(1, stan::math::internal::thread_ad_tape_checkout().node_);
+    EXPECT_EQ(0, ChainableStack::instance_->memalloc_.bytes_used());
+    var z = 3.0;
+    var w = z * z;
+    w.grad();
+    EXPECT_FLOAT_EQ(6.0, z.adj());
+    stan::math::global_observer.on_scheduler_exit(true);
+    EXPECT_FALSE(ChainableStack::instance_);
+  });
+  worker.join();
+}
+#endif
+
+#ifdef TBB_INTERFACE_NEW
+TEST(ad_tape_observer, numa_arena_gradients) {
+  using stan::math::var;
+  stan::math::init_threadpool_tbb(4, stan::math::thread_affinity::core);
+
+  for (std::size_t node = 0; node < stan::math::num_numa_nodes(); ++node) {
+    std::vector<double> adjs(200, 0.0);
+    stan::math::numa_arena(node).execute([&] {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, adjs.size()),
+                        [&](const tbb::blocked_range<std::size_t>& r) {
+                          for (std::size_t i = r.begin(); i < r.end(); ++i) {
+                            stan::math::nested_rev_autodiff nested;
+                            var x = static_cast<double>(i);
+                            var y = x * x;
+                            y.grad();
+                            adjs[i] = x.adj();
+                          }
+                        });
+    });
+    for (std::size_t i = 0; i < adjs.size(); ++i) {
+      EXPECT_FLOAT_EQ(2.0 * i, adjs[i]);
+    }
+  }
+}
+#endif
@@ -0,0 +1,21 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <cstddef>
+
+#ifdef TBB_INTERFACE_NEW
+TEST(intel_tbb_tape_pool, init_reserves_worker_tapes) {
+  using stan::math::thread_affinity;
+  tbb::task_arena& arena
+      = stan::math::init_threadpool_tbb(4, thread_affinity::none);
+  const std::size_t num_workers = arena.max_concurrency() - 1;
+#ifdef STAN_THREADS
+  EXPECT_EQ(3, num_workers);
+#endif
+  // no work has been submitted yet, so every worker tape is still pooled
+  EXPECT_EQ(num_workers, stan::math::get_ad_tape_pool(0).size());
+
+  // later calls do not reserve more tapes
+  stan::math::init_threadpool_tbb(4, thread_affinity::none);
+  EXPECT_EQ(num_workers, stan::math::get_ad_tape_pool(0).size());
+}
+#endif
@@ -0,0 +1,536 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <tbb/task_arena.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace static_tape_test {
+struct scalar_fun {
+  template <typename T>
+  inline T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::log_sum_exp;
+    using stan::math::sqrt;
+    using stan::math::square;
+    T lp = 0;
+    lp += x(0) * x(1) - x(2) / x(0) + 2.0 / x(1) - (3.0 - x(2));
+    lp += exp(x(0) / 4.0) + log(x(1)) * sqrt(x(2)) + square(x(0) - 1.0);
+    lp -= log_sum_exp(x(0), x(1)) + log_sum_exp(x(2), 0.5) * -x(1);
+    return lp;
+  }
+};
+
+struct branching_fun {
+  template <typename T>
+  inline T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    if (x(0) > 0) {
+      return x(0) * x(1);
+    }
+    return x(0) + x(1);
+  }
+};
+
+struct unsupported_fun {
+  template <typename T>
+  inline T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    return stan::math::lgamma(x(0)) * x(1);
+  }
+};
+
+struct throwing_fun {
+  template <typename T>
+  inline T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    if (x(0) < 0) {
+      throw std::domain_error("negative");
+    }
+    return x(0) * x(1);
+  }
+};
+
+struct vector_fun {
+  template <typename T>
+  inline Eigen::Matrix<T, Eigen::Dynamic, 1> operator()(
+      const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    Eigen::Matrix<T, Eigen::Dynamic, 1> y(5);
+    y(0) = x(0) * x(1) - x(2);
+    y(1) = exp(x(1) / x(2));
+    y(2) = log(x(0)) + 3.0 * x(2);
+    y(3) = x(0) * x(0) * x(1);
+    y(4) = x(0) > 1.0 ? -x(1) : x(1) / 2.0;
+    return y;
+  }
+};
+
+template <int Lanes, typename F>
+void expect_same_jacobian(stan::math::static_tape& tape, const F& f,
+                          const Eigen::VectorXd& x) {
+  Eigen::VectorXd fx;
+  Eigen::MatrixXd J;
+  stan::math::jacobian<Lanes>(tape, f, x, fx, J);
+  Eigen::VectorXd fx_ref;
+  Eigen::MatrixXd J_ref;
+  stan::math::jacobian(f, x, fx_ref, J_ref);
+  ASSERT_EQ(fx_ref.size(), fx.size());
+  ASSERT_EQ(J_ref.rows(), J.rows());
+  ASSERT_EQ(J_ref.cols(), J.cols());
+  for (Eigen::Index i = 0; i < fx.size(); ++i) {
+    EXPECT_FLOAT_EQ(fx_ref(i), fx(i));
+    for (Eigen::Index j = 0; j < J.cols(); ++j) {
+      EXPECT_FLOAT_EQ(J_ref(i, j), J(i, j));
+    }
+  }
+}
+
+template <typename F>
+void expect_same_gradient(stan::math::static_tape& tape, const F& f,
+                          const Eigen::VectorXd& x) {
+  double fx;
+  Eigen::VectorXd grad_fx;
+  stan::math::gradient(tape, f, x, fx, grad_fx);
+  double fx_ref;
+  Eigen::VectorXd grad_fx_ref;
+  stan::math::gradient(f, x, fx_ref, grad_fx_ref);
+  EXPECT_FLOAT_EQ(fx_ref, fx);
+  ASSERT_EQ(grad_fx_ref.size(), grad_fx.size());
+  for (Eigen::Index i = 0; i < grad_fx.size(); ++i) {
+    EXPECT_FLOAT_EQ(grad_fx_ref(i), grad_fx(i));
+  }
+}
+}  // namespace static_tape_test
+
+TEST(AgradRevStaticTape, replay_matches_gradient) {
+  using static_tape_test::expect_same_gradient;
+  static_tape_test::scalar_fun f;
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(3);
+  x << 1.5, 2.0, 0.7;
+  expect_same_gradient(tape, f, x);
+  EXPECT_TRUE(tape.is_replayable());
+  EXPECT_EQ(3, tape.num_inputs());
+  size_t recorded_ops = tape.size();
+
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  for (int i = 0; i < 5; ++i) {
+    x << 0.3 + i, 1.2 * (i + 1), 4.0 - 0.5 * i;
+    double fx;
+    Eigen::VectorXd grad_fx;
+    EXPECT_TRUE(tape.replay(x, fx, grad_fx));
+    EXPECT_EQ(stack_size,
+              stan::math::ChainableStack::instance_->var_stack_.size());
+    expect_same_gradient(tape, f, x);
+    EXPECT_EQ(recorded_ops, tape.size());
+  }
+}
+
+TEST(AgradRevStaticTape, branch_change_rerecords) {
+  using static_tape_test::expect_same_gradient;
+  static_tape_test::branching_fun f;
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(2);
+  x << 2.0, 3.0;
+  expect_same_gradient(tape, f, x);
+  EXPECT_EQ(1, tape.num_guards());
+
+  x << -2.0, 3.0;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  EXPECT_FALSE(tape.replay(x, fx, grad_fx));
+  expect_same_gradient(tape, f, x);
+  EXPECT_TRUE(tape.replay(x, fx, grad_fx));
+  EXPECT_FLOAT_EQ(1.0, grad_fx(0));
+  EXPECT_FLOAT_EQ(1.0, grad_fx(1));
+}
+
+TEST(AgradRevStaticTape, unsupported_falls_back) {
+  using static_tape_test::expect_same_gradient;
+  static_tape_test::unsupported_fun f;
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(2);
+  x << 2.5, 3.0;
+  expect_same_gradient(tape, f, x);
+  EXPECT_TRUE(tape.is_recorded());
+  EXPECT_FALSE(tape.is_replayable());
+  x << 4.5, 1.0;
+  expect_same_gradient(tape, f, x);
+
+  tape.clear();
+  EXPECT_FALSE(tape.is_recorded());
+}
+
+TEST(AgradRevStaticTape, floor_not_replayable) {
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(1);
+  x << 2.5;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  stan::math::gradient(
+      tape, [](const auto& x) { return stan::math::floor(x(0)) * x(0); }, x,
+      fx, grad_fx);
+  EXPECT_FLOAT_EQ(5.0, fx);
+  EXPECT_FALSE(tape.is_replayable());
+}
+
+TEST(AgradRevStaticTape, replay_not_replayable) {
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(2);
+  x << 1.2, 3.0;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  stan::math::gradient(
+      tape, [](const auto& x) { return stan::math::floor(x(0)) * x(1); }, x,
+      fx, grad_fx);
+  ASSERT_TRUE(tape.is_recorded());
+  ASSERT_FALSE(tape.is_replayable());
+
+  x << 4.7, 5.0;
+  fx = -1.0;
+  EXPECT_FALSE(tape.replay(x, fx, grad_fx));
+  EXPECT_FLOAT_EQ(-1.0, fx);
+  Eigen::VectorXd fx_vec;
+  Eigen::MatrixXd J;
+  EXPECT_FALSE(tape.replay_jacobian(x, fx_vec, J));
+  Eigen::MatrixXd H;
+  EXPECT_FALSE(tape.replay_hessian(x, fx, grad_fx, H));
+  Eigen::MatrixXd V = Eigen::MatrixXd::Identity(2, 2);
+  Eigen::MatrixXd HV;
+  EXPECT_FALSE(tape.replay_hessian_times_vector(x, V, fx, grad_fx, HV));
+  EXPECT_FLOAT_EQ(-1.0, fx);
+
+  stan::math::gradient(
+      tape, [](const auto& x) { return stan::math::floor(x(0)) * x(1); }, x,
+      fx, grad_fx);
+  EXPECT_FLOAT_EQ(20.0, fx);
+  EXPECT_FLOAT_EQ(0.0, grad_fx(0));
+  EXPECT_FLOAT_EQ(4.0, grad_fx(1));
+}
+
+TEST(AgradRevStaticTape, replay_not_recorded_throws) {
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(2);
+  x << 1.0, 2.0;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  EXPECT_THROW(tape.replay(x, fx, grad_fx), std::domain_error);
+  Eigen::VectorXd fx_vec;
+  Eigen::MatrixXd J;
+  EXPECT_THROW(tape.replay_jacobian(x, fx_vec, J), std::domain_error);
+  Eigen::MatrixXd H;
+  EXPECT_THROW(tape.replay_hessian(x, fx, grad_fx, H), std::domain_error);
+  Eigen::MatrixXd V = Eigen::MatrixXd::Identity(2, 2);
+  Eigen::MatrixXd HV;
+  EXPECT_THROW(tape.replay_hessian_times_vector(x, V, fx, grad_fx, HV),
+               std::domain_error);
+}
+
+TEST(AgradRevStaticTape, replay_hessian_requires_second_derivatives) {
+  using stan::math::var;
+  Eigen::VectorXd x(2);
+  x << 1.5, 2.0;
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  stan::math::static_tape tape;
+  tape.start_recording(x_var);
+  var fx_var = x_var(0) * x_var(1)
+               + var(new stan::math::precomp_vv_vari(0.5, x_var(0).vi_,
+                                                     x_var(1).vi_, 3.0, -2.0));
+  tape.stop_recording(fx_var);
+  ASSERT_TRUE(tape.is_complete());
+  ASSERT_FALSE(tape.is_twice_differentiable());
+
+  double fx;
+  Eigen::VectorXd grad_fx;
+  Eigen::MatrixXd H;
+  EXPECT_THROW(tape.replay_hessian(x, fx, grad_fx, H), std::domain_error);
+  Eigen::MatrixXd V = Eigen::MatrixXd::Identity(2, 2);
+  Eigen::MatrixXd HV;
+  EXPECT_THROW(tape.replay_hessian_times_vector(x, V, fx, grad_fx, HV),
+               std::domain_error);
+}
+
+TEST(AgradRevStaticTape, throwing_stops_recording) {
+  static_tape_test::throwing_fun f;
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(2);
+  x << -1.0, 3.0;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  EXPECT_THROW(stan::math::gradient(tape, f, x, fx, grad_fx),
+               std::domain_error);
+  EXPECT_FALSE(tape.is_recorded());
+  EXPECT_FALSE(tape.is_recording());
+  EXPECT_EQ(nullptr, stan::math::ChainableStack::instance_->static_tape_);
+
+  x << 1.0, 3.0;
+  static_tape_test::expect_same_gradient(tape, f, x);
+  EXPECT_TRUE(tape.is_replayable());
+}
+
+TEST(AgradRevStaticTape, replay_size_mismatch_throws) {
+  static_tape_test::scalar_fun f;
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(3);
+  x << 1.5, 2.0, 0.7;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  stan::math::gradient(tape, f, x, fx, grad_fx);
+  Eigen::VectorXd y(2);
+  y << 1.0, 2.0;
+  EXPECT_THROW(tape.replay(y, fx, grad_fx), std::invalid_argument);
+}
+
+TEST(AgradRevStaticTape, grad_matches_chain) {
+  using stan::math::var;
+  Eigen::VectorXd x(3);
+  x << 1.5, 2.0, 0.7;
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  stan::math::static_tape tape;
+  tape.start_recording(x_var);
+  var fx = static_tape_test::scalar_fun()(x_var)
+           + var(new stan::math::precomp_vv_vari(0.5, x_var(0).vi_,
+                                                 x_var(2).vi_, 3.0, -2.0));
+  tape.stop_recording(fx);
+  EXPECT_TRUE(tape.is_complete());
+  EXPECT_FALSE(tape.is_replayable());
+  EXPECT_EQ(stan::math::ChainableStack::instance_->var_stack_.size(),
+            tape.size());
+
+  Eigen::VectorXd grad_fx;
+  tape.grad(grad_fx);
+  stan::math::grad(fx.vi_);
+  ASSERT_EQ(3, grad_fx.size());
+  for (Eigen::Index i = 0; i < grad_fx.size(); ++i) {
+    EXPECT_FLOAT_EQ(x_var(i).adj(), grad_fx(i));
+  }
+}
+
+TEST(AgradRevStaticTape, grad_incomplete_throws) {
+  using stan::math::var;
+  Eigen::VectorXd x(2);
+  x << 2.5, 3.0;
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  stan::math::static_tape tape;
+  tape.start_recording(x_var);
+  var fx = static_tape_test::unsupported_fun()(x_var);
+  tape.stop_recording(fx);
+  EXPECT_FALSE(tape.is_complete());
+  Eigen::VectorXd grad_fx;
+  EXPECT_THROW(tape.grad(grad_fx), std::domain_error);
+}
+
+TEST(AgradRevStaticTape, parallel_sweep_matches_serial) {
+  // independent terms summed pairwise, so that the levels are wide
+  auto f = [](const auto& x) {
+    using stan::math::exp;
+    using stan::math::log_sum_exp;
+    using std::exp;
+    using T = typename std::decay_t<decltype(x)>::Scalar;
+    std::vector<T> terms;
+    for (Eigen::Index i = 1; i < x.size(); ++i) {
+      terms.push_back(log_sum_exp(x(i) * x(i - 1), exp(x(i)) / 3.0)
+                      - x(i) / x(0));
+    }
+    while (terms.size() > 1) {
+      std::vector<T> sums;
+      for (size_t i = 0; i + 1 < terms.size(); i += 2) {
+        sums.push_back(terms[i] + terms[i + 1]);
+      }
+      if (terms.size() % 2 == 1) {
+        sums.push_back(terms.back());
+      }
+      terms = sums;
+    }
+    return terms[0];
+  };
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(2000, -1.0, 1.5);
+  stan::math::static_tape tape;
+  tape.set_parallel_threshold(0);
+  EXPECT_EQ(0, tape.parallel_threshold());
+  static_tape_test::expect_same_gradient(tape, f, x);
+  ASSERT_TRUE(tape.is_replayable());
+
+  x = Eigen::VectorXd::LinSpaced(2000, -0.5, 2.0);
+  double fx;
+  Eigen::VectorXd grad_fx;
+  ASSERT_TRUE(tape.replay(x, fx, grad_fx));
+  double fx_ref;
+  Eigen::VectorXd grad_fx_ref;
+  stan::math::gradient(f, x, fx_ref, grad_fx_ref);
+  EXPECT_FLOAT_EQ(fx_ref, fx);
+  for (Eigen::Index i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(grad_fx_ref(i), grad_fx(i), 1e-10);
+  }
+
+  Eigen::VectorXd grad_fx_again;
+  ASSERT_TRUE(tape.replay(x, fx, grad_fx_again));
+  for (Eigen::Index i = 0; i < x.size(); ++i) {
+    EXPECT_EQ(grad_fx(i), grad_fx_again(i));
+  }
+}
+
+TEST(AgradRevStaticTape, single_thread_sweeps_serially) {
+  stan::math::static_tape tape;
+  tape.set_parallel_threshold(0);
+  Eigen::VectorXd x(3);
+  x << 1.5, 2.0, 0.7;
+  static_tape_test::expect_same_gradient(tape, static_tape_test::scalar_fun(),
+                                         x);
+  tbb::task_arena single(1);
+  single.execute([&] {
+    EXPECT_FALSE(tape.sweeps_in_parallel());
+    double fx;
+    Eigen::VectorXd grad_fx;
+    EXPECT_TRUE(tape.replay(x, fx, grad_fx));
+  });
+#ifdef STAN_THREADS
+  tbb::task_arena pair(2);
+  pair.execute([&] { EXPECT_TRUE(tape.sweeps_in_parallel()); });
+#else
+  EXPECT_FALSE(tape.sweeps_in_parallel());
+#endif
+}
+
+TEST(AgradRevStaticTape, jacobian_lanes) {
+  using static_tape_test::expect_same_jacobian;
+  static_tape_test::vector_fun f;
+  Eigen::VectorXd x(3);
+  x << 1.5, 2.0, 0.7;
+  stan::math::static_tape tape1;
+  stan::math::static_tape tape4;
+  stan::math::static_tape tape8;
+  expect_same_jacobian<1>(tape1, f, x);
+  expect_same_jacobian<4>(tape4, f, x);
+  expect_same_jacobian<8>(tape8, f, x);
+  EXPECT_TRUE(tape4.is_replayable());
+  EXPECT_EQ(5, tape4.num_outputs());
+
+  x << 2.5, -1.0, 0.3;
+  Eigen::VectorXd fx;
+  Eigen::MatrixXd J;
+  EXPECT_TRUE(tape4.replay_jacobian<4>(x, fx, J));
+  expect_same_jacobian<4>(tape4, f, x);
+  expect_same_jacobian<8>(tape8, f, x);
+
+  x << 0.5, -1.0, 0.3;
+  EXPECT_FALSE(tape4.replay_jacobian<4>(x, fx, J));
+  expect_same_jacobian<4>(tape4, f, x);
+}
+
+TEST(AgradRevStaticTape, jacobian_unsupported_falls_back) {
+  auto f = [](const auto& x) {
+    using T = typename std::decay_t<decltype(x)>::Scalar;
+    Eigen::Matrix<T, Eigen::Dynamic, 1> y(2);
+    y(0) = stan::math::lgamma(x(0)) * x(1);
+    y(1) = x(0) - x(1);
+    return y;
+  };
+  stan::math::static_tape tape;
+  Eigen::VectorXd x(2);
+  x << 2.5, 3.0;
+  static_tape_test::expect_same_jacobian<4>(tape, f, x);
+  EXPECT_FALSE(tape.is_complete());
+  Eigen::MatrixXd J;
+  EXPECT_THROW(tape.jacobian(J), std::domain_error);
+  x << 1.5, 2.0;
+  static_tape_test::expect_same_jacobian<4>(tape, f, x);
+}
+
+TEST(AgradRevStaticTape, jacobian_sparsity) {
+  using stan::math::var;
+  Eigen::VectorXd x(4);
+  x << 1.5, 2.0, 0.7, -0.4;
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  stan::math::static_tape tape;
+  tape.start_recording(x_var);
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y(3);
+  y(0) = x_var(0) * x_var(1);
+  y(1) = stan::math::exp(x_var(2)) - 2.0;
+  y(2) = x_var(3) / x_var(0) + x_var(1);
+  tape.stop_recording(y);
+
+  Eigen::MatrixXd expected(3, 4);
+  expected << 1, 1, 0, 0, 0, 0, 1, 0, 1, 1, 0, 1;
+  Eigen::MatrixXd pattern = tape.jacobian_sparsity();
+  EXPECT_MATRIX_EQ(expected, pattern);
+}
+
+TEST(AgradRevStaticTape, hessian_sparsity) {
+  using stan::math::var;
+  Eigen::VectorXd x(5);
+  x << 1.5, 2.0, 0.7, -0.4, 0.3;
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+  stan::math::static_tape tape;
+  tape.start_recording(x_var);
+  // x(4) only enters linearly and the unused product does not count
+  var unused = x_var(3) * x_var(4);
+  var f = x_var(0) * x_var(1) + stan::math::exp(x_var(2)) + x_var(4)
+          + 3.0 / x_var(3);
+  tape.stop_recording(f);
+
+  Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(5, 5);
+  expected(0, 1) = 1;
+  expected(1, 0) = 1;
+  expected(2, 2) = 1;
+  expected(3, 3) = 1;
+  Eigen::MatrixXd pattern = tape.hessian_sparsity();
+  EXPECT_MATRIX_EQ(expected, pattern);
+}
+
+TEST(AgradRevStaticTape, sparsity_requires_complete_recording) {
+  static_tape_test::unsupported_fun f;
+  Eigen::VectorXd x(2);
+  x << 2.5, 3.0;
+  stan::math::static_tape tape;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  stan::math::gradient(tape, f, x, fx, grad_fx);
+  EXPECT_FALSE(tape.is_complete());
+  EXPECT_THROW(tape.jacobian_sparsity(), std::domain_error);
+  EXPECT_THROW(tape.hessian_sparsity(), std::domain_error);
+}
+
+TEST(AgradRevStaticTape, recording_count) {
+  using stan::math::var;
+  auto& num_recording = stan::math::internal::num_recording_static_tapes();
+  EXPECT_EQ(0, num_recording.load());
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(Eigen::VectorXd::Ones(2));
+  {
+    stan::math::static_tape tape;
+    tape.start_recording(x_var);
+    EXPECT_EQ(1, num_recording.load());
+    stan::math::static_tape other;
+    other.start_recording(x_var);
+    EXPECT_EQ(1, num_recording.load());
+    EXPECT_FALSE(tape.is_recording());
+    EXPECT_TRUE(other.is_recording());
+  }
+  EXPECT_EQ(0, num_recording.load());
+  EXPECT_EQ(nullptr, stan::math::ChainableStack::instance_->static_tape_);
+}
+
+#ifdef STAN_THREADS
+TEST(AgradRevStaticTape, compare_on_thread_without_ad_tape) {
+  using stan::math::var;
+  stan::math::nested_rev_autodiff nested;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(Eigen::VectorXd::Ones(2));
+  stan::math::static_tape tape;
+  tape.start_recording(x_var);
+  bool less = true;
+  std::thread([&] {
+    EXPECT_EQ(nullptr, stan::math::ChainableStack::instance_);
+    less = x_var(0) < x_var(1);
+  }).join();
+  EXPECT_FALSE(less);
+  tape.stop_recording(x_var(0));
+  EXPECT_EQ(0, tape.num_guards());
+}
+#endif
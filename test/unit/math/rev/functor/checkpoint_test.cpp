@@ -0,0 +1,177 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace checkpoint_test {
+struct scalar_fun {
+  template <typename T1, typename T2>
+  auto operator()(const T1& x, const T2& y, double c) const {
+    return stan::math::sum(stan::math::exp(x)) * y
+           + c * stan::math::dot_self(x);
+  }
+};
+
+struct vector_fun {
+  template <typename T1, typename T2>
+  auto operator()(const T1& x, const T2& y) const {
+    return stan::math::eval(stan::math::multiply(stan::math::log1p(x), y));
+  }
+};
+
+// one Euler step of dy/dt = -theta * y + sin(y)
+struct euler_step {
+  double h;
+  template <typename T1, typename T2>
+  auto operator()(int i, const T1& y, const T2& theta) const {
+    return stan::math::eval(
+        stan::math::add(y, stan::math::multiply(
+                               h, stan::math::subtract(
+                                      stan::math::sin(y),
+                                      stan::math::multiply(theta, y)))));
+  }
+};
+
+template <typename T>
+T euler_loop(const euler_step& step, int n, const T& y0,
+             const stan::math::var& theta) {
+  T y = y0;
+  for (int i = 0; i < n; ++i) {
+    y = step(i, y, theta);
+  }
+  return y;
+}
+}  // namespace checkpoint_test
+
+TEST(AgradRevCheckpoint, scalar) {
+  using stan::math::var;
+  Eigen::VectorXd x_val(3);
+  x_val << 0.5, -1.0, 2.0;
+  checkpoint_test::scalar_fun f;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x(x_val);
+  var y = 1.5;
+  var fx = f(x, y, 0.25);
+  fx.grad();
+  Eigen::VectorXd x_adj = x.adj();
+  double y_adj = y.adj();
+  stan::math::recover_memory();
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_c(x_val);
+  var y_c = 1.5;
+  var fx_c = stan::math::checkpoint(f, x_c, y_c, 0.25);
+  EXPECT_FLOAT_EQ(fx.val(), fx_c.val());
+  fx_c.grad();
+  EXPECT_FLOAT_EQ(y_adj, y_c.adj());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_FLOAT_EQ(x_adj(i), x_c(i).adj());
+  }
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevCheckpoint, vector_result) {
+  using stan::math::var;
+  Eigen::VectorXd x_val(3);
+  x_val << 0.5, 1.0, 2.0;
+  checkpoint_test::vector_fun f;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x(x_val);
+  var y = -0.7;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> fx = f(x, y);
+  var lp = stan::math::sum(stan::math::square(fx));
+  lp.grad();
+  Eigen::VectorXd x_adj = x.adj();
+  double y_adj = y.adj();
+  stan::math::recover_memory();
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_c(x_val);
+  var y_c = -0.7;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> fx_c
+      = stan::math::checkpoint(f, x_c, y_c);
+  var lp_c = stan::math::sum(stan::math::square(fx_c));
+  EXPECT_FLOAT_EQ(lp.val(), lp_c.val());
+  lp_c.grad();
+  EXPECT_FLOAT_EQ(y_adj, y_c.adj());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_FLOAT_EQ(x_adj(i), x_c(i).adj());
+  }
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevCheckpoint, double_args) {
+  checkpoint_test::scalar_fun f;
+  Eigen::VectorXd x(2);
+  x << 0.5, 1.0;
+  EXPECT_FLOAT_EQ(f(x, 2.0, 0.5), stan::math::checkpoint(f, x, 2.0, 0.5));
+}
+
+TEST(AgradRevCheckpoint, loop_matches_and_saves_memory) {
+  using stan::math::var;
+  checkpoint_test::euler_step step{0.01};
+  Eigen::VectorXd y0_val(2);
+  y0_val << 1.0, -0.5;
+  const int n = 200;
+
+  for (int num_steps : {1, 2, 7, n}) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> y0(y0_val);
+    var theta = 0.8;
+    var lp = stan::math::sum(
+        checkpoint_test::euler_loop(step, num_steps, y0, theta));
+    size_t full_stack
+        = stan::math::ChainableStack::instance_->var_stack_.size();
+    lp.grad();
+    Eigen::VectorXd y0_adj = y0.adj();
+    double theta_adj = theta.adj();
+    stan::math::recover_memory();
+
+    Eigen::Matrix<var, Eigen::Dynamic, 1> y0_c(y0_val);
+    var theta_c = 0.8;
+    var lp_c = stan::math::sum(
+        stan::math::checkpoint_loop(step, num_steps, y0_c, theta_c));
+    size_t checkpoint_stack
+        = stan::math::ChainableStack::instance_->var_stack_.size();
+    EXPECT_FLOAT_EQ(lp.val(), lp_c.val());
+    if (num_steps == n) {
+      EXPECT_LT(10 * checkpoint_stack, full_stack);
+    }
+    lp_c.grad();
+    EXPECT_FLOAT_EQ(theta_adj, theta_c.adj());
+    for (int i = 0; i < 2; ++i) {
+      EXPECT_FLOAT_EQ(y0_adj(i), y0_c(i).adj());
+    }
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevCheckpoint, loop_double_state) {
+  using stan::math::var;
+  checkpoint_test::euler_step step{0.05};
+  Eigen::VectorXd y0(2);
+  y0 << 0.3, 0.6;
+
+  var theta = 1.2;
+  var lp = stan::math::sum(checkpoint_test::euler_loop(
+      step, 9, stan::math::promote_scalar<var>(y0).eval(), theta));
+  lp.grad();
+  double theta_adj = theta.adj();
+  stan::math::recover_memory();
+
+  var theta_c = 1.2;
+  var lp_c = stan::math::sum(stan::math::checkpoint_loop(step, 9, y0, theta_c));
+  EXPECT_FLOAT_EQ(lp.val(), lp_c.val());
+  lp_c.grad();
+  EXPECT_FLOAT_EQ(theta_adj, theta_c.adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevCheckpoint, loop_throws) {
+  using stan::math::var;
+  checkpoint_test::euler_step step{0.05};
+  Eigen::VectorXd y0(2);
+  y0 << 0.3, 0.6;
+  var theta = 1.2;
+  EXPECT_THROW(stan::math::checkpoint_loop(step, 0, y0, theta),
+               std::domain_error);
+  EXPECT_THROW(stan::math::checkpoint_loop(step, 0, y0, 1.2),
+               std::domain_error);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,88 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// fun1(x, y) = (x^2 * y) + (3 * y^2)
+struct fun1 {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return x(0) * x(0) * x(1) + 3.0 * x(1) * x(1);
+  }
+};
+
+// throws for negative first argument
+struct fun_throw {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    if (x(0) < 0) {
+      throw std::domain_error("negative");
+    }
+    return stan::math::log_sum_exp(x);
+  }
+};
+
+TEST(RevFunctor, gradient_batch) {
+  MatrixXd x(2, 200);
+  for (int i = 0; i < x.cols(); ++i) {
+    x(0, i) = 0.1 * i - 3;
+    x(1, i) = 2.0 - 0.05 * i;
+  }
+
+  for (int grainsize : {1, 7, 500}) {
+    VectorXd fx;
+    MatrixXd grad_fx;
+    stan::math::gradient_batch(fun1(), x, fx, grad_fx, grainsize);
+    ASSERT_EQ(x.cols(), fx.size());
+    ASSERT_EQ(x.rows(), grad_fx.rows());
+    ASSERT_EQ(x.cols(), grad_fx.cols());
+    for (int i = 0; i < x.cols(); ++i) {
+      double fx_ref;
+      VectorXd grad_fx_ref;
+      stan::math::gradient(fun1(), VectorXd(x.col(i)), fx_ref, grad_fx_ref);
+      EXPECT_FLOAT_EQ(fx_ref, fx(i));
+      EXPECT_FLOAT_EQ(grad_fx_ref(0), grad_fx(0, i));
+      EXPECT_FLOAT_EQ(grad_fx_ref(1), grad_fx(1, i));
+    }
+  }
+  // the tape of the calling thread is left empty
+  EXPECT_EQ(0, stan::math::ChainableStack::instance_->var_stack_.size());
+}
+
+TEST(RevFunctor, gradient_batch_empty) {
+  MatrixXd x(3, 0);
+  VectorXd fx(4);
+  MatrixXd grad_fx(2, 2);
+  stan::math::gradient_batch(fun1(), x, fx, grad_fx);
+  EXPECT_EQ(0, fx.size());
+  EXPECT_EQ(3, grad_fx.rows());
+  EXPECT_EQ(0, grad_fx.cols());
+}
+
+TEST(RevFunctor, gradient_batch_errors) {
+  MatrixXd x = MatrixXd::Ones(3, 50);
+  VectorXd fx;
+  MatrixXd grad_fx;
+  EXPECT_THROW(stan::math::gradient_batch(fun_throw(), x, fx, grad_fx, 0),
+               std::domain_error);
+
+  x(0, 17) = -1;
+  EXPECT_THROW_MSG(stan::math::gradient_batch(fun_throw(), x, fx, grad_fx),
+                   std::domain_error, "negative");
+
+  // the nested tapes were recovered
+  x(0, 17) = 1;
+  stan::math::gradient_batch(fun_throw(), x, fx, grad_fx);
+  for (int i = 0; i < x.cols(); ++i) {
+    EXPECT_FLOAT_EQ(std::log(3.0) + 1, fx(i));
+    for (int n = 0; n < x.rows(); ++n) {
+      EXPECT_FLOAT_EQ(1.0 / 3, grad_fx(n, i));
+    }
+  }
+  EXPECT_EQ(0, stan::math::ChainableStack::instance_->var_stack_.size());
+}
@@ -116,4 +116,50 @@ TEST_F(map_rect_con_threads, concurrent_varying_num_threads_eval_ok_dd) {
     set_n_threads(i);
   }
 }
+TEST_F(map_rect_con_threads, concurrent_schedule_dv) {
+  const int N = 67;
+  setup_job(N, shared_params_d, job_params_d, x_r, x_i);
+  std::vector<stan::math::vector_v> job_params_v;
+  for (int i = 0; i < N; i++) {
+    job_params_v.push_back(stan::math::to_var(job_params_d[i]));
+  }
+
+  auto& schedule = stan::math::get_map_rect_schedule<1, hard_work>();
+  schedule.reset_stats();
+  std::vector<double> cost_hints(N);
+  for (int i = 0; i < N; i++) {
+    cost_hints[i] = (i * 37) % N;
+  }
+  schedule.set_cost_hints(cost_hints);
+
+  for (int chunk_size : {1, 4, 100}) {
+    schedule.set_chunk_size(chunk_size);
+    stan::math::vector_v res = stan::math::map_rect<1, hard_work>(
+        shared_params_d, job_params_v, x_r, x_i);
+    ASSERT_EQ(res.size(), 2 * N);
+    for (int i = 0; i < N; i++) {
+      EXPECT_FLOAT_EQ(res(2 * i + 1).val(),
+                      x_r[i][0] * job_params_d[i](1) * job_params_d[i](0)
+                          + 2 * shared_params_d(0) + shared_params_d(1));
+      stan::math::set_zero_all_adjoints();
+      res(2 * i + 1).grad();
+      EXPECT_FLOAT_EQ(job_params_v[i](0).adj(),
+                      x_r[i][0] * job_params_d[i](1));
+      EXPECT_FLOAT_EQ(job_params_v[i](1).adj(),
+                      x_r[i][0] * job_params_d[i](0));
+    }
+  }
+
+  EXPECT_EQ(3, schedule.num_calls());
+  EXPECT_EQ(N, schedule.last_job_seconds().size());
+  EXPECT_EQ(N, schedule.mean_job_seconds().size());
+  for (int i = 0; i < N; i++) {
+    EXPECT_GE(schedule.max_job_seconds()[i], schedule.mean_job_seconds()[i]);
+  }
+  schedule.clear_cost_hints();
+  schedule.set_chunk_size(1);
+  schedule.reset_stats();
+  stan::math::recover_memory();
+}
+
 #endif
@@ -0,0 +1,94 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <vector>
+
+namespace parallel_map_test {
+// scales the first `n` shared coefficients by the sliced element
+struct scale_head {
+  template <typename T1, typename T2>
+  inline auto operator()(const T1& x, std::size_t i, std::ostream* msgs,
+                         const T2& beta) const {
+    return stan::math::multiply(x, beta.head(i + 1)).eval();
+  }
+};
+
+// returns a nested container and ignores the index
+struct outer_products {
+  template <typename T1, typename T2, typename T3>
+  inline auto operator()(const T1& x, std::size_t i, std::ostream* msgs,
+                         const T2& y, const T3& c) const {
+    using T = stan::return_type_t<T1, T2, T3>;
+    std::vector<std::vector<T>> res(x.size(), std::vector<T>(y.size()));
+    for (std::size_t j = 0; j < x.size(); ++j) {
+      for (std::size_t k = 0; k < y.size(); ++k) {
+        res[j][k] = c * x[j] * y[k];
+      }
+    }
+    return res;
+  }
+};
+}  // namespace parallel_map_test
+
+TEST(StanMathRev_parallel_map, gradient) {
+  using stan::math::var;
+  std::vector<double> x_val{1.0, 2.0, -0.5, 3.0};
+  Eigen::VectorXd beta_val = Eigen::VectorXd::Random(x_val.size());
+
+  std::vector<var> x(x_val.begin(), x_val.end());
+  Eigen::Matrix<var, -1, 1> beta = beta_val;
+  std::vector<Eigen::Matrix<var, -1, 1>> res
+      = stan::math::parallel_map<parallel_map_test::scale_head>(x, 1, nullptr,
+                                                                beta);
+  ASSERT_EQ(x.size(), res.size());
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    ASSERT_EQ(i + 1, res[i].size());
+    for (std::size_t j = 0; j <= i; ++j) {
+      EXPECT_FLOAT_EQ(x_val[i] * beta_val(j), res[i](j).val());
+      stan::math::set_zero_all_adjoints();
+      res[i](j).grad();
+      for (std::size_t k = 0; k < x.size(); ++k) {
+        EXPECT_FLOAT_EQ(k == i ? beta_val(j) : 0.0, x[k].adj());
+        EXPECT_FLOAT_EQ(k == j ? x_val[i] : 0.0, beta(k).adj());
+      }
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathRev_parallel_map, nested_result) {
+  using stan::math::var;
+  std::vector<std::vector<var>> x{{1.0, 2.0}, {3.0}, {}};
+  std::vector<double> y{0.5, -1.0, 2.0};
+  var c = 1.5;
+  auto res = stan::math::parallel_map<parallel_map_test::outer_products>(
+      x, 2, nullptr, y, c);
+  ASSERT_EQ(x.size(), res.size());
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    ASSERT_EQ(x[i].size(), res[i].size());
+    for (std::size_t j = 0; j < x[i].size(); ++j) {
+      for (std::size_t k = 0; k < y.size(); ++k) {
+        EXPECT_FLOAT_EQ(c.val() * x[i][j].val() * y[k], res[i][j][k].val());
+        stan::math::set_zero_all_adjoints();
+        res[i][j][k].grad();
+        EXPECT_FLOAT_EQ(c.val() * y[k], x[i][j].adj());
+        EXPECT_FLOAT_EQ(x[i][j].val() * y[k], c.adj());
+      }
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathRev_parallel_map, double_sliced_var_shared) {
+  using stan::math::var;
+  std::vector<double> x{2.0, -1.0};
+  Eigen::Matrix<var, -1, 1> beta = Eigen::VectorXd::Ones(2);
+  auto res = stan::math::parallel_map<parallel_map_test::scale_head>(
+      x, 1, nullptr, beta);
+  var sum = res[0](0) + res[1](0) + res[1](1);
+  EXPECT_FLOAT_EQ(-0.0, sum.val());
+  sum.grad();
+  EXPECT_FLOAT_EQ(1.0, beta(0).adj());
+  EXPECT_FLOAT_EQ(-1.0, beta(1).adj());
+  stan::math::recover_memory();
+}
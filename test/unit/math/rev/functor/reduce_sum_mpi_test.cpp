@@ -0,0 +1,143 @@
+#include <stan/math.hpp>
+#include <test/unit/math/prim/functor/reduce_sum_util.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <vector>
+
+// without MPI these tests check the fallback to reduce_sum
+STAN_REGISTER_MPI_REDUCE_SUM(0, stan::math::test::grouped_count_lpdf<double>,
+                             std::vector<int>, std::vector<double>,
+                             std::vector<int>)
+using grouped_count_var_lpdf
+    = stan::math::test::grouped_count_lpdf<stan::math::var>;
+STAN_REGISTER_MPI_REDUCE_SUM(1, grouped_count_var_lpdf, std::vector<int>,
+                             std::vector<stan::math::var>, std::vector<int>)
+STAN_REGISTER_MPI_REDUCE_SUM(2, stan::math::test::indexed_square_lpdf,
+                             std::vector<int>,
+                             Eigen::Matrix<stan::math::var, -1, 1>,
+                             stan::math::var)
+STAN_REGISTER_MPI_REDUCE_SUM(3, stan::math::test::count_lpdf<stan::math::var>,
+                             std::vector<int>,
+                             std::vector<stan::math::var>, std::vector<int>)
+
+struct ReduceSumMpi : public ::testing::Test {
+  const std::size_t N = 100;
+  const std::size_t num_groups = 7;
+  std::vector<int> data;
+  std::vector<int> gidx;
+  std::vector<double> lambda_d;
+
+  void SetUp() {
+    for (std::size_t i = 0; i != N; ++i) {
+      data.push_back(i % 13);
+      gidx.push_back(i % num_groups);
+    }
+    for (std::size_t g = 0; g != num_groups; ++g) {
+      lambda_d.push_back(g + 1.5);
+    }
+  }
+};
+
+TEST_F(ReduceSumMpi, value) {
+  using stan::math::test::get_new_msg;
+  using stan::math::test::grouped_count_lpdf;
+
+  double ref = stan::math::reduce_sum<grouped_count_lpdf<double>>(
+      data, 5, get_new_msg(), lambda_d, gidx);
+
+  for (int i = 0; i < 2; ++i) {
+    double lpdf = stan::math::reduce_sum_mpi<0, grouped_count_lpdf<double>>(
+        data, 5, get_new_msg(), lambda_d, gidx);
+    EXPECT_FLOAT_EQ(ref, lpdf);
+  }
+
+#ifdef STAN_MPI
+  // the sliced argument is cached on the first call
+  std::vector<int> more_data(N + 1, 0);
+  EXPECT_THROW((stan::math::reduce_sum_mpi<0, grouped_count_lpdf<double>>(
+                   more_data, 5, get_new_msg(), lambda_d, gidx)),
+               std::invalid_argument);
+#endif
+}
+
+TEST_F(ReduceSumMpi, gradient) {
+  using stan::math::var;
+  using stan::math::test::get_new_msg;
+  using stan::math::test::grouped_count_lpdf;
+
+  std::vector<var> lambda_ref(lambda_d.begin(), lambda_d.end());
+  var ref = stan::math::reduce_sum<grouped_count_lpdf<var>>(
+      data, 5, get_new_msg(), lambda_ref, gidx);
+  ref.grad();
+  std::vector<double> grad_ref;
+  for (const var& x : lambda_ref) {
+    grad_ref.push_back(x.adj());
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    stan::math::set_zero_all_adjoints();
+    std::vector<var> lambda(lambda_d.begin(), lambda_d.end());
+    var lpdf = stan::math::reduce_sum_mpi<1, grouped_count_lpdf<var>>(
+        data, 5, get_new_msg(), lambda, gidx);
+    lpdf.grad();
+    EXPECT_FLOAT_EQ(ref.val(), lpdf.val());
+    for (std::size_t g = 0; g != num_groups; ++g) {
+      EXPECT_FLOAT_EQ(grad_ref[g], lambda[g].adj());
+    }
+  }
+
+  stan::math::recover_memory();
+}
+
+TEST_F(ReduceSumMpi, eigen_gradient) {
+  using stan::math::var;
+  using stan::math::test::get_new_msg;
+  using stan::math::test::indexed_square_lpdf;
+
+  Eigen::Matrix<var, -1, 1> beta(3);
+  beta << 0.5, -1.5, 2.0;
+  var alpha = 3.0;
+  std::vector<int> idx;
+  for (std::size_t i = 0; i != N; ++i) {
+    idx.push_back(i % 3);
+  }
+
+  var lpdf = stan::math::reduce_sum_mpi<2, indexed_square_lpdf>(
+      idx, 2, get_new_msg(), beta, alpha);
+  lpdf.grad();
+
+  // terms 0, 1 and 2 appear 34, 33 and 33 times
+  const std::vector<double> counts{34, 33, 33};
+  double value = 0;
+  double alpha_adj = 0;
+  for (int k = 0; k < 3; ++k) {
+    const double beta_k = beta(k).val();
+    value += counts[k] * alpha.val() * beta_k * beta_k;
+    alpha_adj += counts[k] * beta_k * beta_k;
+    EXPECT_FLOAT_EQ(counts[k] * 2 * alpha.val() * beta_k, beta(k).adj());
+  }
+  EXPECT_FLOAT_EQ(value, lpdf.val());
+  EXPECT_FLOAT_EQ(alpha_adj, alpha.adj());
+
+  stan::math::recover_memory();
+}
+
+TEST_F(ReduceSumMpi, error) {
+  using stan::math::var;
+  using stan::math::test::count_lpdf;
+  using stan::math::test::get_new_msg;
+
+  std::vector<int> idata;
+  std::vector<var> bad_lambda(1, -1.0);
+  EXPECT_THROW((stan::math::reduce_sum_mpi<3, count_lpdf<var>>(
+                   data, 5, get_new_msg(), bad_lambda, idata)),
+               std::domain_error);
+
+  // the cluster is still usable after an error
+  std::vector<var> lambda(1, 2.5);
+  var lpdf = stan::math::reduce_sum_mpi<3, count_lpdf<var>>(
+      data, 5, get_new_msg(), lambda, idata);
+  EXPECT_FLOAT_EQ(stan::math::poisson_lpmf(data, 2.5), lpdf.val());
+
+  stan::math::recover_memory();
+}
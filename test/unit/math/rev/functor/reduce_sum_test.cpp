@@ -99,6 +99,41 @@ TEST(StanMathRev_reduce_sum, gradient) {
   stan::math::recover_memory();
 }
 
+TEST(StanMathRev_reduce_sum, auto_gradient) {
+  using stan::math::var;
+  using stan::math::test::count_lpdf;
+  using stan::math::test::get_new_msg;
+
+  double lambda_d = 10.0;
+  const std::size_t elems = 10000;
+  std::vector<int> data(elems);
+
+  for (std::size_t i = 0; i != elems; ++i)
+    data[i] = i;
+
+  std::vector<int> idata;
+  var lambda_ref = lambda_d;
+  var poisson_lpdf_ref = stan::math::poisson_lpmf(data, lambda_ref);
+  stan::math::grad(poisson_lpdf_ref.vi_);
+  const double lambda_ref_adj = lambda_ref.adj();
+
+  auto& tuner = stan::math::reduce_sum_tuner<count_lpdf<var>>();
+  tuner.reset();
+  for (int i = 0; i < 20; ++i) {
+    if (i == 10) {
+      tuner.freeze(elems);
+    }
+    std::vector<var> vlambda_v(1, lambda_d);
+    var poisson_lpdf = stan::math::reduce_sum_auto<count_lpdf<var>>(
+        data, get_new_msg(), vlambda_v, idata);
+    EXPECT_FLOAT_EQ(poisson_lpdf.val(), poisson_lpdf_ref.val());
+    stan::math::grad(poisson_lpdf.vi_);
+    EXPECT_FLOAT_EQ(vlambda_v[0].adj(), lambda_ref_adj);
+  }
+  tuner.reset();
+  stan::math::recover_memory();
+}
+
 TEST(StanMathRev_reduce_sum, grainsize) {
   using stan::math::var;
   using stan::math::test::count_lpdf;
@@ -319,6 +354,46 @@ TEST(StanMathRev_reduce_sum, grouped_gradient_eigen) {
   stan::math::recover_memory();
 }
 
+TEST(StanMathRev_reduce_sum, var_matrix_gradient) {
+  using stan::math::var;
+  using stan::math::var_value;
+  using stan::math::test::get_new_msg;
+  using stan::math::test::indexed_square_lpdf;
+
+  const int size = 50;
+  const std::size_t elems = 10000;
+  std::vector<int> idx(elems);
+  for (std::size_t i = 0; i != elems; ++i) {
+    idx[i] = (7 * i) % size;
+  }
+  Eigen::VectorXd beta_val = Eigen::VectorXd::Random(size);
+
+  Eigen::Matrix<var, -1, 1> beta_ref = beta_val;
+  var alpha_ref = 0.5;
+  var lpdf_ref = indexed_square_lpdf()(idx, 0, elems - 1, get_new_msg(),
+                                       beta_ref, alpha_ref);
+  stan::math::grad(lpdf_ref.vi_);
+  const double alpha_ref_adj = alpha_ref.adj();
+  const Eigen::VectorXd beta_ref_adj = beta_ref.adj();
+
+  for (bool is_static : {false, true}) {
+    var_value<Eigen::VectorXd> beta = beta_val;
+    var alpha = 0.5;
+    var lpdf = is_static ? stan::math::reduce_sum_static<indexed_square_lpdf>(
+                   idx, 5, get_new_msg(), beta, alpha)
+                         : stan::math::reduce_sum<indexed_square_lpdf>(
+                             idx, 5, get_new_msg(), beta, alpha);
+    EXPECT_FLOAT_EQ(lpdf.val(), lpdf_ref.val());
+    stan::math::set_zero_all_adjoints();
+    stan::math::grad(lpdf.vi_);
+    EXPECT_FLOAT_EQ(alpha.adj(), alpha_ref_adj);
+    for (int i = 0; i < size; ++i) {
+      EXPECT_FLOAT_EQ(beta.adj()(i), beta_ref_adj(i));
+    }
+  }
+  stan::math::recover_memory();
+}
+
 TEST(StanMathRev_reduce_sum, slice_group_gradient) {
   using stan::math::var;
   using stan::math::test::get_new_msg;
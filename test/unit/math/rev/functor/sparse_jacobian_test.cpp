@@ -0,0 +1,98 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <stdexcept>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// discretized reaction-diffusion right-hand side, tridiagonal Jacobian
+struct diffusion_rhs {
+  template <typename T>
+  inline Matrix<T, Dynamic, 1> operator()(
+      const Matrix<T, Dynamic, 1>& u) const {
+    const int n = u.size();
+    Matrix<T, Dynamic, 1> du(n);
+    for (int i = 0; i < n; ++i) {
+      T left = i > 0 ? u(i - 1) : T(0);
+      T right = i + 1 < n ? u(i + 1) : T(0);
+      du(i) = left - 2.0 * u(i) + right - stan::math::square(u(i)) * 0.1;
+    }
+    return du;
+  }
+};
+
+// same sparsity, but not recordable on a static_tape
+struct diffusion_rhs_lgamma {
+  template <typename T>
+  inline Matrix<T, Dynamic, 1> operator()(
+      const Matrix<T, Dynamic, 1>& u) const {
+    Matrix<T, Dynamic, 1> du = diffusion_rhs()(u);
+    du(0) += stan::math::lgamma(u(0) + 3.0);
+    return du;
+  }
+};
+
+TEST(RevFunctor, sparse_jacobian_pattern) {
+  diffusion_rhs f;
+  VectorXd x = VectorXd::LinSpaced(10, -1.0, 2.0);
+  MatrixXd band = MatrixXd::Zero(10, 10);
+  for (int i = 0; i < 10; ++i) {
+    for (int j = std::max(0, i - 1); j < std::min(10, i + 2); ++j) {
+      band(i, j) = 1;
+    }
+  }
+  Eigen::SparseMatrix<double> pattern = band.sparseView();
+
+  VectorXd fx;
+  Eigen::SparseMatrix<double> J;
+  stan::math::sparse_jacobian(f, x, pattern, fx, J);
+
+  VectorXd fx_ref;
+  MatrixXd J_ref;
+  stan::math::jacobian(f, x, fx_ref, J_ref);
+  EXPECT_MATRIX_FLOAT_EQ(fx_ref, fx);
+  EXPECT_MATRIX_FLOAT_EQ(J_ref, MatrixXd(J));
+  EXPECT_EQ(pattern.nonZeros(), J.nonZeros());
+}
+
+TEST(RevFunctor, sparse_jacobian_detected) {
+  diffusion_rhs f;
+  VectorXd x = VectorXd::LinSpaced(12, -1.0, 2.0);
+  VectorXd fx;
+  Eigen::SparseMatrix<double> J;
+  stan::math::sparse_jacobian(f, x, fx, J);
+
+  VectorXd fx_ref;
+  MatrixXd J_ref;
+  stan::math::jacobian(f, x, fx_ref, J_ref);
+  EXPECT_MATRIX_FLOAT_EQ(fx_ref, fx);
+  EXPECT_MATRIX_FLOAT_EQ(J_ref, MatrixXd(J));
+  EXPECT_EQ(3 * 12 - 2, J.nonZeros());
+}
+
+TEST(RevFunctor, sparse_jacobian_unrecordable) {
+  diffusion_rhs_lgamma f;
+  VectorXd x = VectorXd::LinSpaced(6, -1.0, 2.0);
+  VectorXd fx;
+  Eigen::SparseMatrix<double> J;
+  stan::math::sparse_jacobian(f, x, fx, J);
+
+  VectorXd fx_ref;
+  MatrixXd J_ref;
+  stan::math::jacobian(f, x, fx_ref, J_ref);
+  EXPECT_MATRIX_FLOAT_EQ(fx_ref, fx);
+  EXPECT_MATRIX_FLOAT_EQ(J_ref, MatrixXd(J));
+}
+
+TEST(RevFunctor, sparse_jacobian_size_mismatch) {
+  diffusion_rhs f;
+  VectorXd x = VectorXd::Ones(4);
+  Eigen::SparseMatrix<double> pattern(3, 4);
+  VectorXd fx;
+  Eigen::SparseMatrix<double> J;
+  EXPECT_THROW(stan::math::sparse_jacobian(f, x, pattern, fx, J),
+               std::invalid_argument);
+}
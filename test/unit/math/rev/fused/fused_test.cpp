@@ -0,0 +1,144 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using stan::math::var;
+using stan::math::var_value;
+
+namespace fused_test {
+MatrixXd values(Eigen::Index rows, Eigen::Index cols, double offset) {
+  MatrixXd x(rows, cols);
+  for (Eigen::Index i = 0; i < x.size(); ++i) {
+    x(i) = 0.5 + 0.25 * std::sin(offset + i);
+  }
+  return x;
+}
+
+template <typename T>
+auto unfused(const T& a, const T& b, const T& c, const T& d,
+             const MatrixXd& data) {
+  using stan::math::elt_divide;
+  using stan::math::elt_multiply;
+  using stan::math::eval;
+  auto e1 = eval(stan::math::exp(stan::math::add(elt_multiply(a, b), c)));
+  auto e2 = eval(stan::math::subtract(stan::math::log(d), data));
+  auto e3 = eval(stan::math::multiply(2.0, stan::math::sqrt(b)));
+  auto e4 = eval(stan::math::add(stan::math::square(stan::math::minus(c)),
+                                 stan::math::log1p(a)));
+  return eval(stan::math::add(elt_divide(stan::math::add(e1, e2), e3),
+                              stan::math::divide(e4, 3.0)));
+}
+
+template <typename T, typename = void>
+struct has_as_fused : std::false_type {};
+
+template <typename T>
+struct has_as_fused<
+    T, stan::void_t<decltype(stan::math::as_fused(std::declval<T>()))>>
+    : std::true_type {};
+
+template <typename T>
+auto fused(const T& a, const T& b, const T& c, const T& d,
+           const MatrixXd& data) {
+  using stan::math::fuse;
+  auto fa = fuse(a);
+  auto fb = fuse(b);
+  auto fc = fuse(c);
+  auto e1 = exp(elt_multiply(fa, fb) + fc);
+  auto e2 = log(fuse(d)) - fuse(data);
+  auto e3 = 2.0 * sqrt(fb);
+  auto e4 = square(-fc) + log1p(fa);
+  return (elt_divide(e1 + e2, e3) + e4 / 3.0).eval();
+}
+
+template <typename T>
+void expect_fused_matches(Eigen::Index rows, Eigen::Index cols) {
+  MatrixXd data = values(rows, cols, 4.0);
+  MatrixXd weights = values(rows, cols, 5.0);
+  T a_ref = values(rows, cols, 0.0);
+  T b_ref = values(rows, cols, 1.0);
+  T c_ref = values(rows, cols, 2.0);
+  T d_ref = values(rows, cols, 3.0);
+  auto res_ref = unfused(a_ref, b_ref, c_ref, d_ref, data);
+  var lp_ref = stan::math::sum(stan::math::elt_multiply(res_ref, weights));
+
+  T a = values(rows, cols, 0.0);
+  T b = values(rows, cols, 1.0);
+  T c = values(rows, cols, 2.0);
+  T d = values(rows, cols, 3.0);
+  auto res = fused(a, b, c, d, data);
+  EXPECT_TRUE((std::is_same<std::decay_t<decltype(res)>,
+                            std::decay_t<decltype(res_ref)>>::value));
+  var lp = stan::math::sum(stan::math::elt_multiply(res, weights));
+  EXPECT_MATRIX_NEAR(stan::math::value_of(res_ref), stan::math::value_of(res),
+                     1e-12);
+
+  stan::math::grad();
+  EXPECT_MATRIX_NEAR(a_ref.adj(), a.adj(), 1e-12);
+  EXPECT_MATRIX_NEAR(b_ref.adj(), b.adj(), 1e-12);
+  EXPECT_MATRIX_NEAR(c_ref.adj(), c.adj(), 1e-12);
+  EXPECT_MATRIX_NEAR(d_ref.adj(), d.adj(), 1e-12);
+  stan::math::recover_memory();
+}
+}  // namespace fused_test
+
+TEST(AgradRevFused, var_matrix) {
+  fused_test::expect_fused_matches<var_value<MatrixXd>>(5, 3);
+  fused_test::expect_fused_matches<var_value<VectorXd>>(7, 1);
+  fused_test::expect_fused_matches<var_value<Eigen::RowVectorXd>>(1, 4);
+  fused_test::expect_fused_matches<var_value<MatrixXd>>(0, 0);
+}
+
+TEST(AgradRevFused, matrix_var) {
+  fused_test::expect_fused_matches<Eigen::Matrix<var, -1, -1>>(5, 3);
+  fused_test::expect_fused_matches<Eigen::Matrix<var, -1, 1>>(7, 1);
+}
+
+TEST(AgradRevFused, repeated_leaf) {
+  var_value<VectorXd> a = fused_test::values(4, 1, 0.0);
+  auto fa = stan::math::fuse(a);
+  var_value<VectorXd> res = (elt_multiply(fa, fa) + fa).eval();
+  stan::math::sum(res).grad();
+  EXPECT_MATRIX_NEAR((2.0 * a.val().array() + 1.0).matrix(), a.adj(),
+                     1e-12);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevFused, data_only) {
+  MatrixXd x = fused_test::values(3, 2, 0.0);
+  MatrixXd y = fused_test::values(3, 2, 1.0);
+  auto res = (exp(stan::math::fuse(x)) - 1.0 / stan::math::fuse(y)).eval();
+  EXPECT_TRUE((std::is_same<decltype(res), MatrixXd>::value));
+  EXPECT_MATRIX_NEAR((x.array().exp() - y.array().inverse()).matrix(), res,
+                     1e-12);
+  EXPECT_EQ(0, stan::math::ChainableStack::instance_->var_stack_.size());
+}
+
+TEST(AgradRevFused, mismatched_dims) {
+  var_value<MatrixXd> a = fused_test::values(3, 2, 0.0);
+  var_value<MatrixXd> b = fused_test::values(2, 3, 1.0);
+  EXPECT_THROW(stan::math::fuse(a) + stan::math::fuse(b),
+               std::invalid_argument);
+  EXPECT_THROW(elt_multiply(stan::math::fuse(a), stan::math::fuse(b)),
+               std::invalid_argument);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevFused, as_fused_matrices_only) {
+  EXPECT_TRUE(fused_test::has_as_fused<var_value<MatrixXd>>::value);
+  EXPECT_TRUE(
+      (fused_test::has_as_fused<Eigen::Matrix<var, -1, -1>>::value));
+  EXPECT_TRUE(fused_test::has_as_fused<MatrixXd>::value);
+  EXPECT_FALSE(fused_test::has_as_fused<double>::value);
+  EXPECT_FALSE(fused_test::has_as_fused<int>::value);
+
+  var_value<MatrixXd> a = fused_test::values(3, 2, 0.0);
+  var_value<MatrixXd> res = exp(stan::math::as_fused(a)).eval();
+  EXPECT_MATRIX_NEAR(a.val().array().exp().matrix(), res.val(), 1e-12);
+  stan::math::recover_memory();
+}